@@ -0,0 +1,390 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+#include "toolkit.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+// Allocation counting
+//----------------------------------------------------------------------------
+
+namespace {
+
+std::atomic<long> allocationCount(0);
+
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    ++allocationCount;
+    void *pointer = std::malloc(size ? size : 1);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace vrv {
+
+namespace bench {
+
+namespace {
+
+    struct MicroBench {
+        std::string m_name;
+        std::function<std::vector<BenchPhase>(int repeat)> m_function;
+    };
+
+    std::vector<MicroBench> &GetMicroBenches()
+    {
+        static std::vector<MicroBench> microBenches;
+        return microBenches;
+    }
+
+    struct BenchArguments {
+        std::vector<std::string> m_filters;
+        std::vector<std::string> m_files;
+        std::string m_outfile;
+        std::string m_baseline;
+        double m_threshold = 10.0;
+        int m_repeat = 3;
+    };
+
+    // Run all the phases of the pipeline for a case
+    std::vector<BenchPhase> RunCase(const BenchCase &benchCase, int repeat)
+    {
+        std::vector<BenchPhase> phases;
+        Toolkit toolkit(false);
+        toolkit.SetResourcePath(GetResourcePath());
+        toolkit.SetOptions(benchCase.m_options);
+
+        phases.push_back(MeasurePhase("load", repeat, [&]() { toolkit.LoadData(benchCase.m_data); }));
+        phases.push_back(MeasurePhase("layout", repeat, [&]() { toolkit.RedoLayout("{\"resetCache\": true}"); }));
+        phases.push_back(MeasurePhase("svg", repeat, [&]() {
+            for (int i = 1; i <= toolkit.GetPageCount(); ++i) toolkit.RenderToSVG(i);
+        }));
+        phases.push_back(MeasurePhase("midi", repeat, [&]() { toolkit.RenderToMIDI(); }));
+        phases.push_back(MeasurePhase("timemap", repeat, [&]() { toolkit.RenderToTimemap(); }));
+        phases.push_back(MeasurePhase("mei", repeat, [&]() { toolkit.GetMEI(); }));
+        return phases;
+    }
+
+    jsonxx::Object ResultToJson(const std::string &name, const std::vector<BenchPhase> &phases)
+    {
+        jsonxx::Object result;
+        result << "name" << name;
+        jsonxx::Array jsonPhases;
+        for (const BenchPhase &phase : phases) {
+            jsonxx::Object jsonPhase;
+            jsonPhase << "name" << phase.m_name;
+            jsonPhase << "time" << phase.m_time;
+            jsonPhase << "allocations" << phase.m_allocations;
+            jsonPhases << jsonPhase;
+        }
+        result << "phases" << jsonPhases;
+        result << "peakRss" << GetPeakRss();
+        return result;
+    }
+
+    // Find the phase of a case in a result array, or return NULL
+    const jsonxx::Object *FindPhase(const jsonxx::Array &results, const std::string &caseName, const std::string &phase)
+    {
+        for (size_t i = 0; i < results.size(); ++i) {
+            const jsonxx::Object &result = results.get<jsonxx::Object>((unsigned int)i);
+            if (!result.has<jsonxx::String>("name") || (result.get<jsonxx::String>("name") != caseName)) continue;
+            if (!result.has<jsonxx::Array>("phases")) return NULL;
+            const jsonxx::Array &phases = result.get<jsonxx::Array>("phases");
+            for (size_t j = 0; j < phases.size(); ++j) {
+                const jsonxx::Object &jsonPhase = phases.get<jsonxx::Object>((unsigned int)j);
+                if (jsonPhase.get<jsonxx::String>("name", "") == phase) return &jsonPhase;
+            }
+        }
+        return NULL;
+    }
+
+    /**
+     * Compare the results with the baseline and return the regressions.
+     * A time is a regression when it exceeds the baseline by more than the threshold (in percent) and by more than
+     * one millisecond, which is below the timer noise. Allocation counts are deterministic and only the threshold
+     * applies.
+     */
+    jsonxx::Array CompareWithBaseline(const jsonxx::Array &results, const jsonxx::Array &baseline, double threshold)
+    {
+        jsonxx::Array regressions;
+        const double factor = 1.0 + threshold / 100.0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const jsonxx::Object &result = results.get<jsonxx::Object>((unsigned int)i);
+            const std::string caseName = result.get<jsonxx::String>("name");
+            const jsonxx::Array &phases = result.get<jsonxx::Array>("phases");
+            for (size_t j = 0; j < phases.size(); ++j) {
+                const jsonxx::Object &phase = phases.get<jsonxx::Object>((unsigned int)j);
+                const std::string phaseName = phase.get<jsonxx::String>("name");
+                const jsonxx::Object *basePhase = FindPhase(baseline, caseName, phaseName);
+                if (!basePhase) continue;
+                for (const std::string measure : { "time", "allocations" }) {
+                    const double value = phase.get<jsonxx::Number>(measure);
+                    const double baseValue = basePhase->get<jsonxx::Number>(measure, 0.0);
+                    bool regressed = (value > baseValue * factor);
+                    if (measure == "time") regressed = regressed && (value - baseValue > 1.0);
+                    if (!regressed) continue;
+                    jsonxx::Object regression;
+                    regression << "name" << caseName;
+                    regression << "phase" << phaseName;
+                    regression << "measure" << measure;
+                    regression << "value" << value;
+                    regression << "baseline" << baseValue;
+                    regressions << regression;
+                }
+            }
+        }
+        return regressions;
+    }
+
+    bool Matches(const std::string &name, const std::vector<std::string> &filters)
+    {
+        if (filters.empty()) return true;
+        return std::any_of(filters.begin(), filters.end(),
+            [&name](const std::string &filter) { return (name.find(filter) != std::string::npos); });
+    }
+
+    void PrintUsage(std::ostream &output)
+    {
+        output << "Usage: verovio-bench [options] [file...]" << std::endl << std::endl;
+        output << "Run the benchmark cases and print the results as JSON. Files given as arguments are added to the "
+                  "corpus."
+               << std::endl
+               << std::endl;
+        output << " --baseline <file>   Compare the results with a previous output and report the regressions"
+               << std::endl;
+        output << " --filter <name>     Run only the cases whose name contains the string (repeatable)" << std::endl;
+        output << " --outfile <file>    Write the results to the file instead of the standard output" << std::endl;
+        output << " --repeat <n>        Repeat each phase n times and keep the fastest (default 3)" << std::endl;
+        output << " --threshold <pct>   Tolerance of the baseline comparison in percent (default 10)" << std::endl;
+    }
+
+    bool ParseArguments(int argc, char **argv, BenchArguments &arguments)
+    {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = (i + 1 < argc);
+            if ((arg == "--baseline") && hasValue) {
+                arguments.m_baseline = argv[++i];
+            }
+            else if ((arg == "--filter") && hasValue) {
+                arguments.m_filters.push_back(argv[++i]);
+            }
+            else if ((arg == "--outfile") && hasValue) {
+                arguments.m_outfile = argv[++i];
+            }
+            else if ((arg == "--repeat") && hasValue) {
+                arguments.m_repeat = std::max(1, atoi(argv[++i]));
+            }
+            else if ((arg == "--threshold") && hasValue) {
+                arguments.m_threshold = atof(argv[++i]);
+            }
+            else if (arg.starts_with("-")) {
+                return false;
+            }
+            else {
+                arguments.m_files.push_back(arg);
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+long GetAllocationCount()
+{
+    return allocationCount;
+}
+
+long GetPeakRss()
+{
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    // In bytes on macOS
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+BenchPhase MeasurePhase(const std::string &name, int repeat, const std::function<void()> &function)
+{
+    BenchPhase phase;
+    phase.m_name = name;
+    for (int i = 0; i < repeat; ++i) {
+        const long allocations = GetAllocationCount();
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const double time
+            = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0) {
+            phase.m_time = time;
+            phase.m_allocations = GetAllocationCount() - allocations;
+        }
+        phase.m_time = std::min(phase.m_time, time);
+    }
+    return phase;
+}
+
+std::string GetResourcePath()
+{
+    return std::string(VRV_BENCH_SOURCE_DIR) + "/data";
+}
+
+std::string GetSourceFilePath(const std::string &path)
+{
+    return std::string(VRV_BENCH_SOURCE_DIR) + "/" + path;
+}
+
+bool RegisterMicroBench(const std::string &name, std::function<std::vector<BenchPhase>(int repeat)> function)
+{
+    GetMicroBenches().push_back({ name, function });
+    return true;
+}
+
+} // namespace bench
+
+} // namespace vrv
+
+//----------------------------------------------------------------------------
+// main
+//----------------------------------------------------------------------------
+
+/**
+ * Run the benchmark and print the results as JSON.
+ * Return 1 if a regression was found when comparing with a baseline.
+ */
+int main(int argc, char **argv)
+{
+    using namespace vrv::bench;
+
+    BenchArguments arguments;
+    if (!ParseArguments(argc, argv, arguments)) {
+        PrintUsage(std::cerr);
+        return 2;
+    }
+
+    vrv::EnableLog(vrv::LOG_OFF);
+
+    std::vector<BenchCase> corpus = GetCorpus();
+    for (const std::string &file : arguments.m_files) {
+        std::ifstream input(file, std::ios::binary);
+        if (!input.is_open()) {
+            std::cerr << "Unable to open " << file << std::endl;
+            return 2;
+        }
+        std::stringstream data;
+        data << input.rdbuf();
+        corpus.push_back({ file, data.str(), "{}" });
+    }
+
+    jsonxx::Array results;
+    for (const BenchCase &benchCase : corpus) {
+        if (!Matches(benchCase.m_name, arguments.m_filters)) continue;
+        std::cerr << "Running " << benchCase.m_name << std::endl;
+        results << ResultToJson(benchCase.m_name, RunCase(benchCase, arguments.m_repeat));
+    }
+    for (const MicroBench &microBench : GetMicroBenches()) {
+        if (!Matches(microBench.m_name, arguments.m_filters)) continue;
+        std::cerr << "Running " << microBench.m_name << std::endl;
+        results << ResultToJson(microBench.m_name, microBench.m_function(arguments.m_repeat));
+    }
+
+    jsonxx::Object output;
+    output << "version" << vrv::GetVersion();
+    output << "repeat" << arguments.m_repeat;
+    output << "results" << results;
+    output << "peakRss" << GetPeakRss();
+
+    int status = 0;
+    if (!arguments.m_baseline.empty()) {
+        std::ifstream input(arguments.m_baseline);
+        std::stringstream content;
+        content << input.rdbuf();
+        jsonxx::Object baseline;
+        if (!input.is_open() || !baseline.parse(content.str()) || !baseline.has<jsonxx::Array>("results")) {
+            std::cerr << "Unable to read the baseline " << arguments.m_baseline << std::endl;
+            return 2;
+        }
+        const jsonxx::Array regressions
+            = CompareWithBaseline(results, baseline.get<jsonxx::Array>("results"), arguments.m_threshold);
+        output << "regressions" << regressions;
+        for (size_t i = 0; i < regressions.size(); ++i) {
+            const jsonxx::Object &regression = regressions.get<jsonxx::Object>((unsigned int)i);
+            std::cerr << "Regression: " << regression.get<jsonxx::String>("name") << " "
+                      << regression.get<jsonxx::String>("phase") << " " << regression.get<jsonxx::String>("measure")
+                      << " " << regression.get<jsonxx::Number>("value") << " (baseline "
+                      << regression.get<jsonxx::Number>("baseline") << ")" << std::endl;
+        }
+        if (regressions.size() > 0) status = 1;
+    }
+
+    if (arguments.m_outfile.empty()) {
+        std::cout << output.json() << std::endl;
+    }
+    else {
+        std::ofstream file(arguments.m_outfile);
+        if (!file.is_open()) {
+            std::cerr << "Unable to write " << arguments.m_outfile << std::endl;
+            return 2;
+        }
+        file << output.json() << std::endl;
+    }
+    return status;
+}
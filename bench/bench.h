@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        bench.h
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_BENCH_H__
+#define __VRV_BENCH_H__
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vrv {
+
+namespace bench {
+
+//----------------------------------------------------------------------------
+// BenchPhase
+//----------------------------------------------------------------------------
+
+/**
+ * The measure of a phase of a benchmark case.
+ * The time is the fastest of the repetitions and the allocations are the ones of the first repetition.
+ */
+struct BenchPhase {
+    std::string m_name;
+    double m_time = 0.0;
+    long m_allocations = 0;
+};
+
+//----------------------------------------------------------------------------
+// BenchCase
+//----------------------------------------------------------------------------
+
+/**
+ * A benchmark case with its input data and options.
+ * The data is loaded and rendered through all the phases of the pipeline.
+ */
+struct BenchCase {
+    std::string m_name;
+    std::string m_data;
+    std::string m_options;
+};
+
+//----------------------------------------------------------------------------
+// Functions
+//----------------------------------------------------------------------------
+
+/**
+ * Return the number of allocations made so far by the process
+ */
+long GetAllocationCount();
+
+/**
+ * Return the peak resident set size of the process in kilobytes
+ */
+long GetPeakRss();
+
+/**
+ * Run the function the given number of times and return its measure
+ */
+BenchPhase MeasurePhase(const std::string &name, int repeat, const std::function<void()> &function);
+
+/**
+ * Return the path of the resources and of a file in the source tree
+ */
+///@{
+std::string GetResourcePath();
+std::string GetSourceFilePath(const std::string &path);
+///@}
+
+/**
+ * Return the cases of the corpus, i.e., the files of the source tree and the synthetic scores
+ */
+std::vector<BenchCase> GetCorpus();
+
+/**
+ * Return a synthetic MEI score with the given dimensions.
+ * Notes are eighth notes in 4/4 with the given number of verses, and a slur is added every given number of notes
+ * (none if 0).
+ */
+std::string GenerateScore(int staves, int measures, int verses, int slurEvery);
+
+/**
+ * Register a micro-benchmark running its own phases.
+ * This is intended to be used through the VRV_MICRO_BENCH macro.
+ */
+bool RegisterMicroBench(const std::string &name, std::function<std::vector<BenchPhase>(int repeat)> function);
+
+} // namespace bench
+
+} // namespace vrv
+
+//----------------------------------------------------------------------------
+// Macros
+//----------------------------------------------------------------------------
+
+/**
+ * Define a micro-benchmark returning its phases. The repeat count is given by the argument repeat.
+ */
+#define VRV_MICRO_BENCH(name)                                                                                          \
+    static std::vector<vrv::bench::BenchPhase> bench_##name(int repeat);                                               \
+    static const bool bench_##name##_registered = vrv::bench::RegisterMicroBench(#name, bench_##name);                 \
+    static std::vector<vrv::bench::BenchPhase> bench_##name(int repeat)
+
+#endif // __VRV_BENCH_H__
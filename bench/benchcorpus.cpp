@@ -0,0 +1,154 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        benchcorpus.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+//----------------------------------------------------------------------------
+
+#include "toolkit.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace bench {
+
+namespace {
+
+    std::string ReadFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // The Plaine & Easie test files, one incipit each
+    std::vector<std::string> GetPaeIncipits()
+    {
+        std::vector<std::filesystem::path> paths;
+        const std::filesystem::path directory = GetSourceFilePath("doc/tests/pae");
+        if (!std::filesystem::is_directory(directory)) return {};
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(directory)) {
+            if (entry.path().extension() == ".pae") paths.push_back(entry.path());
+        }
+        // The directory order is not reproducible
+        std::sort(paths.begin(), paths.end());
+        std::vector<std::string> incipits;
+        for (const std::filesystem::path &path : paths) {
+            incipits.push_back(ReadFile(path.string()));
+        }
+        return incipits;
+    }
+
+} // namespace
+
+std::vector<BenchCase> GetCorpus()
+{
+    std::vector<BenchCase> corpus;
+    corpus.push_back({ "importer.mei", ReadFile(GetSourceFilePath("doc/importer.mei")), "{}" });
+    corpus.push_back({ "importer.mei-breaks-none", ReadFile(GetSourceFilePath("doc/importer.mei")),
+        "{\"breaks\": \"none\"}" });
+
+    // Synthetic scores scaling one dimension each
+    corpus.push_back({ "synthetic-staves", GenerateScore(24, 16, 0, 0), "{}" });
+    corpus.push_back({ "synthetic-measures", GenerateScore(2, 400, 0, 0), "{}" });
+    corpus.push_back({ "synthetic-lyrics", GenerateScore(8, 64, 4, 0), "{}" });
+    corpus.push_back({ "synthetic-slurs", GenerateScore(2, 160, 0, 2), "{}" });
+    return corpus;
+}
+
+std::string GenerateScore(int staves, int measures, int verses, int slurEvery)
+{
+    static const char *pitches[] = { "c", "d", "e", "f", "g", "a", "b" };
+    static const char *syllables[] = { "la", "ti", "do", "re" };
+
+    std::string mei = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    mei += "<mei xmlns=\"http://www.music-encoding.org/ns/mei\" meiversion=\"5.0\">\n";
+    mei += "<meiHead><fileDesc><titleStmt><title>Synthetic</title></titleStmt><pubStmt/></fileDesc></meiHead>\n";
+    mei += "<music><body><mdiv><score>\n";
+    mei += "<scoreDef meter.count=\"4\" meter.unit=\"4\"><staffGrp symbol=\"bracket\">\n";
+    for (int s = 1; s <= staves; ++s) {
+        mei += StringFormat("<staffDef n=\"%d\" lines=\"5\" clef.shape=\"G\" clef.line=\"2\"/>\n", s);
+    }
+    mei += "</staffGrp></scoreDef>\n<section>\n";
+    for (int m = 1; m <= measures; ++m) {
+        mei += StringFormat("<measure n=\"%d\">\n", m);
+        std::string slurs;
+        for (int s = 1; s <= staves; ++s) {
+            mei += StringFormat("<staff n=\"%d\"><layer n=\"1\">", s);
+            for (int n = 0; n < 8; ++n) {
+                const std::string id = StringFormat("n%d-%d-%d", m, s, n);
+                const int step = (m + s + n) % 7;
+                mei += StringFormat("<note xml:id=\"%s\" dur=\"8\" pname=\"%s\" oct=\"%d\"", id.c_str(),
+                    pitches[step], ((m + n) % 2) ? 4 : 5);
+                if (verses == 0) {
+                    mei += "/>";
+                }
+                else {
+                    mei += ">";
+                    for (int v = 1; v <= verses; ++v) {
+                        mei += StringFormat(
+                            "<verse n=\"%d\"><syl>%s</syl></verse>", v, syllables[(n + v) % 4]);
+                    }
+                    mei += "</note>";
+                }
+                if ((slurEvery > 0) && (n % slurEvery == slurEvery - 1)) {
+                    slurs += StringFormat("<slur staff=\"%d\" startid=\"#n%d-%d-%d\" endid=\"#%s\"/>\n", s, m, s,
+                        n - slurEvery + 1, id.c_str());
+                }
+            }
+            mei += "</layer></staff>\n";
+        }
+        mei += slurs;
+        mei += "</measure>\n";
+    }
+    mei += "</section>\n</score></mdiv></body></music>\n</mei>\n";
+    return mei;
+}
+
+} // namespace bench
+
+} // namespace vrv
+
+//----------------------------------------------------------------------------
+// Micro-benchmarks
+//----------------------------------------------------------------------------
+
+/**
+ * Load and render the Plaine & Easie incipits one after the other with the same toolkit.
+ * The incipits are too small to be measured as separate cases.
+ */
+VRV_MICRO_BENCH(paeIncipits)
+{
+    using namespace vrv::bench;
+
+    const std::vector<std::string> incipits = GetPaeIncipits();
+    vrv::Toolkit toolkit(false);
+    toolkit.SetResourcePath(GetResourcePath());
+    toolkit.SetOptions("{\"inputFrom\": \"pae\"}");
+
+    std::vector<BenchPhase> phases;
+    phases.push_back(MeasurePhase("load", repeat, [&]() {
+        for (const std::string &incipit : incipits) toolkit.LoadData(incipit);
+    }));
+    phases.push_back(MeasurePhase("svg", repeat, [&]() {
+        for (const std::string &incipit : incipits) {
+            toolkit.LoadData(incipit);
+            toolkit.RenderToSVG(1);
+        }
+    }));
+    return phases;
+}
@@ -74,6 +74,7 @@
 #import <VerovioFramework/devicecontext.h>
 #import <VerovioFramework/devicecontextbase.h>
 #import <VerovioFramework/dir.h>
+#import <VerovioFramework/displaylistdevicecontext.h>
 #import <VerovioFramework/div.h>
 #import <VerovioFramework/divline.h>
 #import <VerovioFramework/doc.h>
@@ -184,6 +185,7 @@
 #import <VerovioFramework/positioninterface.h>
 #import <VerovioFramework/preparedatafunctor.h>
 #import <VerovioFramework/proport.h>
+#import <VerovioFramework/rasterdevicecontext.h>
 #import <VerovioFramework/rdg.h>
 #import <VerovioFramework/ref.h>
 #import <VerovioFramework/reg.h>
@@ -250,4 +252,5 @@
 #import <VerovioFramework/vrv.h>
 #import <VerovioFramework/vrvdef.h>
 #import <VerovioFramework/zone.h>
+#import <VerovioFramework/zoneindex.h>
 #endif /* all_h */
@@ -12,15 +12,30 @@
 
 // Method to ignore
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
+%ignore vrv::Toolkit::GetCBuffer( ) const;
+%ignore vrv::Toolkit::GetCBufferSize( ) const;
 %ignore vrv::Toolkit::GetCString( );
 %ignore vrv::Toolkit::GetLogString( );
 %ignore vrv::Toolkit::ParseOptions( const std::string & );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
+%ignore vrv::Toolkit::SetCBuffer( std::vector<uint8_t> && );
 %ignore vrv::Toolkit::SetCString( const std::string & );
 
 %module verovio
 %include "std_string.i"
+
+// Binary outputs (e.g., MIDI) are returned as byte arrays without base64 encoding
+%typemap(jni) std::vector<uint8_t> "jbyteArray"
+%typemap(jtype) std::vector<uint8_t> "byte[]"
+%typemap(jstype) std::vector<uint8_t> "byte[]"
+%typemap(javaout) std::vector<uint8_t> {
+    return $jnicall;
+}
+%typemap(out) std::vector<uint8_t> {
+    $result = JCALL1(NewByteArray, jenv, (jsize)$1.size());
+    JCALL4(SetByteArrayRegion, jenv, $result, 0, (jsize)$1.size(), reinterpret_cast<const jbyte *>($1.data()));
+}
 %include "../../include/vrv/toolkit.h"
 %include "../../include/vrv/toolkitdef.h"
 
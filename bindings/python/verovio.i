@@ -12,11 +12,14 @@
 
 // Method to ignore
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
+%ignore vrv::Toolkit::GetCBuffer( ) const;
+%ignore vrv::Toolkit::GetCBufferSize( ) const;
 %ignore vrv::Toolkit::GetCString( );
 %ignore vrv::Toolkit::GetLogString( );
 %ignore vrv::Toolkit::GetOptionsObj( );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
+%ignore vrv::Toolkit::SetCBuffer( std::vector<uint8_t> && );
 %ignore vrv::Toolkit::SetCString( const std::string & );
 
 %feature("autodoc", "1");
@@ -85,6 +88,13 @@ def getExpansionIdsForElement(toolkit, xml_id: str) -> dict:
     return json.loads($action(toolkit, xml_id))
 %}
 
+// Toolkit::GetLogEntries
+%feature("shadow") vrv::Toolkit::GetLogEntries() %{
+def getLogEntries(toolkit) -> list:
+    """Return the log entries with their level and count as a list of dictionaries."""
+    return json.loads($action(toolkit))
+%}
+
 // Toolkit::GetMEI
 %feature("shadow") vrv::Toolkit::GetMEI(const std::string & = "") %{
 def getMEI(toolkit, options: Optional[dict] = None) -> str:
@@ -94,6 +104,15 @@ def getMEI(toolkit, options: Optional[dict] = None) -> str:
     return $action(toolkit, json.dumps(options))
 %}
 
+// Toolkit::GetMEIZipBinary
+%feature("shadow") vrv::Toolkit::GetMEIZipBinary(const std::string & = "") %{
+def getMEIZipBinary(toolkit, options: Optional[dict] = None) -> bytes:
+    """Get the MEI as a zip-compressed archive."""
+    if options is None:
+        options = {}
+    return $action(toolkit, json.dumps(options))
+%}
+
 // Toolkit::GetMIDIValuesForElement
 %feature("shadow") vrv::Toolkit::GetMIDIValuesForElement(const std::string &) %{
 def getMIDIValuesForElement(toolkit, xml_id: str) -> dict:
@@ -108,6 +127,13 @@ def getOptions(toolkit) -> dict:
     return json.loads($action(toolkit))
 %}
 
+// Toolkit::GetProfile
+%feature("shadow") vrv::Toolkit::GetProfile() %{
+def getProfile(toolkit) -> dict:
+    """Return the profile of the latest loaded data as a dictionary."""
+    return json.loads($action(toolkit))
+%}
+
 // Toolkit::GetTimesForElement
 %feature("shadow") vrv::Toolkit::GetTimesForElement(const std::string &) %{
 def getTimesForElement(toolkit, xml_id: str) -> dict:
@@ -131,6 +157,16 @@ def renderData(toolkit, data, options: dict) -> str:
     return $action(toolkit, data, json.dumps(options))
 %}
 
+// Toolkit::RenderIncipitsToSVG
+%feature("shadow") vrv::Toolkit::RenderIncipitsToSVG(const std::string &, const std::string & = "") %{
+def renderIncipitsToSVG(toolkit, incipits: list, options: Optional[dict] = None) -> Union[list, str]:
+    """Render many incipits on a single system each and return a list of SVGs, or one SVG sprite sheet."""
+    if options is None:
+        options = {}
+    output = $action(toolkit, json.dumps(incipits), json.dumps(options))
+    return output if options.get("spriteSheet", False) else json.loads(output)
+%}
+
 // Toolkit::RenderToExpansionMap
 %feature("shadow") vrv::Toolkit::RenderToExpansionMap() %{
 def renderToExpansionMap(toolkit) -> list:
@@ -154,6 +190,15 @@ def renderToTimemap(toolkit, options: Optional[dict] = None) -> list:
     return json.loads($action(toolkit, json.dumps(options)))
 %}
 
+// Toolkit::RenderToTimemapBinary
+%feature("shadow") vrv::Toolkit::RenderToTimemapBinary(const std::string & = "") %{
+def renderToTimemapBinary(toolkit, options: Optional[dict] = None) -> bytes:
+    """Render a document to a binary timemap."""
+    if options is None:
+        options = {}
+    return $action(toolkit, json.dumps(options))
+%}
+
 // Toolkit::RenderToTimemapFile
 %feature("shadow") vrv::Toolkit::RenderToTimemapFile(const std::string &, const std::string & = "") %{
 def renderToTimemapFile(toolkit, filename: str, options: Optional[dict] = None) -> bool:
@@ -172,6 +217,13 @@ def saveFile(toolkit, filename: str, options: Optional[dict] = None) -> bool:
     return $action(toolkit, filename, json.dumps(options))
 %}
 
+// Toolkit::SearchFeatureIndex
+%feature("shadow") vrv::Toolkit::SearchFeatureIndex(const std::string &) %{
+def searchFeatureIndex(toolkit, query: dict) -> dict:
+    """Search the feature index and return the matches as a dictionary."""
+    return json.loads($action(toolkit, json.dumps(query)))
+%}
+
 // Toolkit::Select
 %feature("shadow") vrv::Toolkit::Select(const std::string &) %{
 def select(toolkit, selection: dict) -> bool:
@@ -179,6 +231,15 @@ def select(toolkit, selection: dict) -> bool:
     return $action(toolkit, json.dumps(selection))
 %}
 
+// Toolkit::ResetFeatureIndex
+%feature("shadow") vrv::Toolkit::ResetFeatureIndex(const std::string & = "") %{
+def resetFeatureIndex(toolkit, options: Optional[dict] = None) -> None:
+    """Clear the feature index."""
+    if options is None:
+        options = {}
+    $action(toolkit, json.dumps(options))
+%}
+
 // Toolkit::SetOptions
 %feature("shadow") vrv::Toolkit::SetOptions(const std::string &) %{
 def setOptions(toolkit, json_options: dict) -> bool:
@@ -197,6 +258,12 @@ def validatePAE(toolkit, data: Union[str, dict]) -> dict:
 
 %module(package="verovio") verovio
 %include "std_string.i"
+
+// Binary outputs (e.g., MIDI) are returned as bytes without base64 encoding
+%typemap(out) std::vector<uint8_t> {
+    $result = PyBytes_FromStringAndSize(reinterpret_cast<const char *>($1.data()), $1.size());
+}
+
 %include "../../include/vrv/toolkit.h"
 %include "../../include/vrv/toolkitdef.h"
 
@@ -34,6 +34,8 @@ if __name__ == '__main__':
     parser.add_argument('test_suite_dir')
     parser.add_argument('output_dir')
     parser.add_argument('--shortlist', nargs='?', default='')
+    parser.add_argument('--compact-report', action='store_true',
+                        help='also render the compact SVG and report the size reduction')
     args = parser.parse_args()
 
     # version of the toolkit
@@ -53,6 +55,8 @@ if __name__ == '__main__':
     path1 = args.test_suite_dir.replace("\ ", " ")
     path2 = args.output_dir.replace("\ ", " ")
     dir1 = sorted(os.listdir(path1))
+    rawSvgSize = 0
+    compactSvgSize = 0
     for item1 in dir1:
         if not (os.path.isdir(os.path.join(path1, item1))):
             continue
@@ -105,7 +109,18 @@ if __name__ == '__main__':
                 "overflow=\"inherit\"", "overflow=\"visible\"")
             ET.ElementTree(ET.fromstring(svgString)).write(svgFile)
             svg2png(bytestring=svgString, scale=2, write_to=pngFile)
+            # render to compact SVG and compare the sizes
+            if args.compact_report:
+                tk.setOptions({'svgFormatRaw': True})
+                rawSvgSize += len(tk.renderToSVG(1).encode('utf-8'))
+                tk.setOptions({'svgFormatRaw': False, 'svgCompact': True})
+                compactSvgSize += len(tk.renderToSVG(1).encode('utf-8'))
+                tk.setOptions({'svgCompact': False})
             # create time map
             tk.renderToTimemapFile(timeMapFile)
             tk.resetOptions()
             options.clear()
+
+    if args.compact_report and rawSvgSize > 0:
+        print(f'SVG size (raw formatting): {rawSvgSize} bytes')
+        print(f'SVG size (compact): {compactSvgSize} bytes ({100 * (1 - compactSvgSize / rawSvgSize):.1f}% smaller)')
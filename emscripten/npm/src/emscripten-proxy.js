@@ -18,6 +18,18 @@ function getToolkitFunction(VerovioModule, method) {
     // void destructor(Toolkit *ic)
     mapping.destructor = VerovioModule.cwrap("vrvToolkit_destructor", null, ["number"]);
 
+    // bool addToFeatureIndex(Toolkit *ic, const char *documentId)
+    mapping.addToFeatureIndex = VerovioModule.cwrap("vrvToolkit_addToFeatureIndex", "number", ["number", "string"]);
+
+    // bool beginEditTransaction(Toolkit *ic)
+    mapping.beginEditTransaction = VerovioModule.cwrap("vrvToolkit_beginEditTransaction", "number", ["number"]);
+
+    // bool commitEditTransaction(Toolkit *ic)
+    mapping.commitEditTransaction = VerovioModule.cwrap("vrvToolkit_commitEditTransaction", "number", ["number"]);
+
+    // void continueLayout(Toolkit *ic, int pageNo)
+    mapping.continueLayout = VerovioModule.cwrap("vrvToolkit_continueLayout", null, ["number", "number"]);
+
     // bool edit(Toolkit *ic, const char *editorAction) 
     mapping.edit = VerovioModule.cwrap("vrvToolkit_edit", "number", ["number", "string"]);
 
@@ -39,6 +51,9 @@ function getToolkitFunction(VerovioModule, method) {
     // char *getElementsAtTime(Toolkit *ic, int time)
     mapping.getElementsAtTime = VerovioModule.cwrap("vrvToolkit_getElementsAtTime", "string", ["number", "number"]);
 
+    // char *getElementsAtPosition(Toolkit *ic, const char *options)
+    mapping.getElementsAtPosition = VerovioModule.cwrap("vrvToolkit_getElementsAtPosition", "string", ["number", "string"]);
+
     // char *vrvToolkit_getExpansionIdsForElement(Toolkit *tk, const char *xmlId);
     mapping.getExpansionIdsForElement = VerovioModule.cwrap("vrvToolkit_getExpansionIdsForElement", "string", ["number", "string"]);
 
@@ -57,9 +72,18 @@ function getToolkitFunction(VerovioModule, method) {
     // char *getLog(Toolkit *ic)
     mapping.getLog = VerovioModule.cwrap("vrvToolkit_getLog", "string", ["number"]);
 
+    // char *getLogEntries(Toolkit *ic)
+    mapping.getLogEntries = VerovioModule.cwrap("vrvToolkit_getLogEntries", "string", ["number"]);
+
+    // char *getProfile(Toolkit *ic)
+    mapping.getProfile = VerovioModule.cwrap("vrvToolkit_getProfile", "string", ["number"]);
+
     // char *getMEI(Toolkit *ic, const char *options)
     mapping.getMEI = VerovioModule.cwrap("vrvToolkit_getMEI", "string", ["number", "string"]);
 
+    // unsigned char *getMEIZipBinary(Toolkit *ic, const char *options, int *length)
+    mapping.getMEIZipBinary = VerovioModule.cwrap("vrvToolkit_getMEIZipBinary", "number", ["number", "string", "number"]);
+
     // char *vrvToolkit_getNotatedIdForElement(Toolkit *tk, const char *xmlId);
     mapping.getNotatedIdForElement = VerovioModule.cwrap("vrvToolkit_getNotatedIdForElement", "string", ["number", "string"]);
 
@@ -84,6 +108,9 @@ function getToolkitFunction(VerovioModule, method) {
     // char *getVersion(Toolkit *ic)
     mapping.getVersion = VerovioModule.cwrap("vrvToolkit_getVersion", "string", ["number"]);
 
+    // bool isPageCountFinal(Toolkit *ic)
+    mapping.isPageCountFinal = VerovioModule.cwrap("vrvToolkit_isPageCountFinal", "number", ["number"]);
+
     // bool loadData(Toolkit *ic, const char *data)
     mapping.loadData = VerovioModule.cwrap("vrvToolkit_loadData", "number", ["number", "string"]);
 
@@ -102,27 +129,51 @@ function getToolkitFunction(VerovioModule, method) {
     // char *renderData(Toolkit *ic, const char *data, const char *options)
     mapping.renderData = VerovioModule.cwrap("vrvToolkit_renderData", "string", ["number", "string", "string"]);
 
+    // char *renderIncipitsToSVG(Toolkit *ic, const char *incipits, const char *options)
+    mapping.renderIncipitsToSVG = VerovioModule.cwrap("vrvToolkit_renderIncipitsToSVG", "string", ["number", "string", "string"]);
+
+    // unsigned char *renderToDisplayList(Toolkit *ic, int pageNo, int *length)
+    mapping.renderToDisplayList = VerovioModule.cwrap("vrvToolkit_renderToDisplayList", "number", ["number", "number", "number"]);
+
     // char *renderToExpansionMap(Toolkit *ic)
     mapping.renderToExpansionMap = VerovioModule.cwrap("vrvToolkit_renderToExpansionMap", "string", ["number"]);
 
     // char *renderToMIDI(Toolkit *ic, const char *rendering_options)
     mapping.renderToMIDI = VerovioModule.cwrap("vrvToolkit_renderToMIDI", "string", ["number", "string"]);
 
+    // unsigned char *renderToMIDIBinary(Toolkit *ic, int *length)
+    mapping.renderToMIDIBinary = VerovioModule.cwrap("vrvToolkit_renderToMIDIBinary", "number", ["number", "number"]);
+
     // char *renderToPAE(Toolkit *ic)
     mapping.renderToPAE = VerovioModule.cwrap("vrvToolkit_renderToPAE", "string", ["number"]);
 
+    // unsigned char *renderToPNG(Toolkit *ic, int pageNo, int *length)
+    mapping.renderToPNG = VerovioModule.cwrap("vrvToolkit_renderToPNG", "number", ["number", "number", "number"]);
+
     // char *renderToSvg(Toolkit *ic, int pageNo, int xmlDeclaration)
     mapping.renderToSVG = VerovioModule.cwrap("vrvToolkit_renderToSVG", "string", ["number", "number", "number"]);
 
     // char *renderToTimemap(Toolkit *ic)
     mapping.renderToTimemap = VerovioModule.cwrap("vrvToolkit_renderToTimemap", "string", ["number", "string"]);
 
+    // unsigned char *renderToTimemapBinary(Toolkit *ic, const char *options, int *length)
+    mapping.renderToTimemapBinary = VerovioModule.cwrap("vrvToolkit_renderToTimemapBinary", "number", ["number", "string", "number"]);
+
+    // void resetFeatureIndex(Toolkit *ic, const char *options)
+    mapping.resetFeatureIndex = VerovioModule.cwrap("vrvToolkit_resetFeatureIndex", null, ["number", "string"]);
+
     // void resetOptions(Toolkit *ic)
     mapping.resetOptions = VerovioModule.cwrap("vrvToolkit_resetOptions", null, ["number"]);
 
     // void resetXmlIdSeed(Toolkit *ic, int seed) 
     mapping.resetXmlIdSeed = VerovioModule.cwrap("vrvToolkit_resetXmlIdSeed", null, ["number", "number"]);
 
+    // bool rollbackEditTransaction(Toolkit *ic)
+    mapping.rollbackEditTransaction = VerovioModule.cwrap("vrvToolkit_rollbackEditTransaction", "number", ["number"]);
+
+    // char *searchFeatureIndex(Toolkit *ic, const char *query)
+    mapping.searchFeatureIndex = VerovioModule.cwrap("vrvToolkit_searchFeatureIndex", "string", ["number", "string"]);
+
     // bool select(Toolkit *ic, const char *options) 
     mapping.select = VerovioModule.cwrap("vrvToolkit_select", "number", ["number", "string"]);
 
@@ -31,6 +31,22 @@ export class VerovioToolkit {
         this.proxy.destructor(this.ptr);
     }
 
+    addToFeatureIndex(documentId) {
+        return this.proxy.addToFeatureIndex(this.ptr, documentId);
+    }
+
+    beginEditTransaction() {
+        return this.proxy.beginEditTransaction(this.ptr);
+    }
+
+    commitEditTransaction() {
+        return this.proxy.commitEditTransaction(this.ptr);
+    }
+
+    continueLayout(pageNo = 0) {
+        this.proxy.continueLayout(this.ptr, pageNo);
+    }
+
     edit(editorAction) {
         return this.proxy.edit(this.ptr, JSON.stringify(editorAction));
     }
@@ -59,6 +75,10 @@ export class VerovioToolkit {
         return JSON.parse(this.proxy.getElementsAtTime(this.ptr, millisec));
     }
 
+    getElementsAtPosition(options) {
+        return JSON.parse(this.proxy.getElementsAtPosition(this.ptr, JSON.stringify(options)));
+    }
+
     getExpansionIdsForElement(xmlId) {
         return JSON.parse(this.proxy.getExpansionIdsForElement(this.ptr, xmlId));
     }
@@ -83,10 +103,22 @@ export class VerovioToolkit {
         return this.proxy.getLog(this.ptr);
     }
 
+    getLogEntries() {
+        return JSON.parse(this.proxy.getLogEntries(this.ptr));
+    }
+
+    getProfile() {
+        return JSON.parse(this.proxy.getProfile(this.ptr));
+    }
+
     getMEI(options = {}) {
         return this.proxy.getMEI(this.ptr, JSON.stringify(options));
     }
 
+    getMEIZipBinary(options = {}) {
+        return this.readBinaryBuffer((lengthPtr) => this.proxy.getMEIZipBinary(this.ptr, JSON.stringify(options), lengthPtr));
+    }
+
     getMIDIValuesForElement(xmlId) {
         return JSON.parse(this.proxy.getMIDIValuesForElement(this.ptr, xmlId));
     }
@@ -129,6 +161,10 @@ export class VerovioToolkit {
         return this.proxy.getVersion(this.ptr);
     }
 
+    isPageCountFinal() {
+        return this.proxy.isPageCountFinal(this.ptr);
+    }
+
     loadData(data) {
         return this.proxy.loadData(this.ptr, data);
     }
@@ -163,6 +199,15 @@ export class VerovioToolkit {
         return this.proxy.renderData(this.ptr, data, JSON.stringify(options));
     }
 
+    renderIncipitsToSVG(incipits, options = {}) {
+        const output = this.proxy.renderIncipitsToSVG(this.ptr, JSON.stringify(incipits), JSON.stringify(options));
+        return (options.spriteSheet) ? output : JSON.parse(output);
+    }
+
+    renderToDisplayList(pageNo = 1) {
+        return this.readBinaryBuffer((lengthPtr) => this.proxy.renderToDisplayList(this.ptr, pageNo, lengthPtr));
+    }
+
     renderToExpansionMap() {
         return JSON.parse(this.proxy.renderToExpansionMap(this.ptr));
     }
@@ -171,10 +216,18 @@ export class VerovioToolkit {
         return this.proxy.renderToMIDI(this.ptr, JSON.stringify(options));
     }
 
+    renderToMIDIBinary() {
+        return this.readBinaryBuffer((lengthPtr) => this.proxy.renderToMIDIBinary(this.ptr, lengthPtr));
+    }
+
     renderToPAE() {
         return this.proxy.renderToPAE(this.ptr);
     }
 
+    renderToPNG(pageNo = 1) {
+        return this.readBinaryBuffer((lengthPtr) => this.proxy.renderToPNG(this.ptr, pageNo, lengthPtr));
+    }
+
     renderToSVG(pageNo = 1, xmlDeclaration = false) {
         return this.proxy.renderToSVG(this.ptr, pageNo, xmlDeclaration);
     }
@@ -183,6 +236,14 @@ export class VerovioToolkit {
         return JSON.parse(this.proxy.renderToTimemap(this.ptr, JSON.stringify(options)));
     }
 
+    renderToTimemapBinary(options = {}) {
+        return this.readBinaryBuffer((lengthPtr) => this.proxy.renderToTimemapBinary(this.ptr, JSON.stringify(options), lengthPtr));
+    }
+
+    resetFeatureIndex(options = {}) {
+        this.proxy.resetFeatureIndex(this.ptr, JSON.stringify(options));
+    }
+
     resetOptions() {
         this.proxy.resetOptions(this.ptr);
     }
@@ -191,6 +252,14 @@ export class VerovioToolkit {
         return this.proxy.resetXmlIdSeed(this.ptr, seed);
     }
 
+    rollbackEditTransaction() {
+        return this.proxy.rollbackEditTransaction(this.ptr);
+    }
+
+    searchFeatureIndex(query) {
+        return JSON.parse(this.proxy.searchFeatureIndex(this.ptr, JSON.stringify(query)));
+    }
+
     select(selection) {
         return this.proxy.select(this.ptr, JSON.stringify(selection));
     }
@@ -207,6 +276,18 @@ export class VerovioToolkit {
         return JSON.parse(this.proxy.validatePAE(this.ptr, data));
     }
 
+    readBinaryBuffer(callback) {
+        // The buffer is owned by the toolkit and is copied into a Uint8Array
+        var lengthPtr = this.VerovioModule._malloc(4);
+        var dataPtr = callback(lengthPtr);
+        var length = this.VerovioModule.HEAP32[lengthPtr >> 2];
+        this.VerovioModule._free(lengthPtr);
+        if (!dataPtr || length <= 0) {
+            return new Uint8Array(0);
+        }
+        return this.VerovioModule.HEAPU8.slice(dataPtr, dataPtr + length);
+    }
+
     preprocessOptions(options) {
         // Nothing to do if we do not have 'fontAddCustom' set
         if (!Object.hasOwn(options, 'fontAddCustom')) {
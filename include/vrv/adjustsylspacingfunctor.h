@@ -18,6 +18,9 @@ namespace vrv {
 
 /**
  * This class adjusts the spacing of the syl processing verse by verse.
+ * The page is traversed once, recording the systems, measures, staves and verses it contains.
+ * The verses are then processed for each staff / layer / verse \@n in turn from what was recorded,
+ * in the same order as a traversal filtered for each of them.
  */
 class AdjustSylSpacingFunctor : public DocFunctor {
 public:
@@ -38,7 +41,9 @@ public:
      * Functor interface
      */
     ///@{
+    FunctorCode VisitLayer(Layer *layer) override;
     FunctorCode VisitMeasureEnd(Measure *measure) override;
+    FunctorCode VisitPageEnd(Page *page) override;
     FunctorCode VisitStaff(Staff *staff) override;
     FunctorCode VisitSystem(System *system) override;
     FunctorCode VisitSystemEnd(System *system) override;
@@ -48,10 +53,38 @@ public:
 protected:
     //
 private:
-    //
+    /**
+     * @name Process the recorded events for one staff / layer / verse \@n
+     */
+    ///@{
+    void AdjustMeasureEnd(Measure *measure);
+    void AdjustStaff(Staff *staff);
+    void AdjustSystem();
+    void AdjustSystemEnd();
+    void AdjustVerse(Verse *verse);
+    ///@}
+
 public:
     //
 private:
+    // The type of the recorded events
+    enum class EventType { Verse, Staff, MeasureEnd, System, SystemEnd };
+    // An event recorded in the traversal with the staff / layer / verse \@n it applies to (for staves and verses)
+    struct Event {
+        EventType m_type;
+        Object *m_object;
+        std::tuple<int, int, int> m_key;
+    };
+    // The events recorded in the traversal
+    std::vector<Event> m_events;
+    // The staff / layer / verse \@n of the recorded verses
+    std::set<std::tuple<int, int, int>> m_verseKeys;
+    // The \@n of the current staff and layer in the traversal
+    int m_currentStaffN;
+    int m_currentLayerN;
+
+    /* The state of the staff / layer / verse \@n being adjusted */
+
     // List of adjustment tuples (Alignment start|Alignment end|distance)
     ArrayOfAdjustmentTuples m_overlappingSyl;
     // The previous verse
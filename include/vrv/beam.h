@@ -369,6 +369,7 @@ protected:
      * This also initializes the m_beamElementCoords vector
      */
     void FilterList(ListOfConstObjects &childList) const override;
+    bool IncludesDrawingParts() const override { return false; }
 
     /**
      * See LayerElement::SetElementShortening
@@ -122,6 +122,12 @@ public:
      */
     void SetPageHeight(int height) { m_pageHeight = height; }
 
+    /*
+     * Set the page we are taking the content from.
+     * Used when the content is cast off progressively with consecutive content pages.
+     */
+    void SetContentPage(Page *contentPage) { m_contentPage = contentPage; }
+
     /*
      * Functor interface
      */
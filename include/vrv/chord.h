@@ -214,6 +214,7 @@ protected:
      * Filter the flat list and keep only Note elements.
      */
     void FilterList(ListOfConstObjects &childList) const override;
+    bool IncludesDrawingParts() const override { return false; }
 
 public:
     //
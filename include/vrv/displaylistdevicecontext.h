@@ -0,0 +1,294 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        displaylistdevicecontext.h
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_DISPLAYLIST_DC_H__
+#define __VRV_DISPLAYLIST_DC_H__
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "devicecontext.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+class Glyph;
+
+/** The version of the display list format */
+#define DISPLAYLIST_VERSION 1
+
+/**
+ * The operation codes of the display list.
+ * Operands are given in the order they are written.
+ */
+enum DisplayListOp : uint8_t {
+    // string: length, UTF-8 bytes
+    DL_DEFINE_STRING = 0x01,
+    // glyph: code, font name ref, units per em, path ref (SVG path data in font units, y-axis up)
+    DL_DEFINE_GLYPH,
+    // page: width, height, content height, user scale * 1000, origin x, origin y
+    DL_START_PAGE = 0x08,
+    DL_END_PAGE,
+    // group: class ref, id ref, color ref
+    DL_START_GROUP = 0x10,
+    DL_END_GROUP,
+    // resumed group: id ref (drawing continues in the previously ended group with this id)
+    DL_RESUME_GROUP,
+    // group color: color ref
+    DL_GROUP_COLOR,
+    // rotate: origin x, origin y, angle (clockwise, 1/1000 degree)
+    DL_ROTATE,
+    // pen: color, width, opacity, dash length, gap length, line cap, line join
+    DL_SET_PEN = 0x20,
+    // brush: color, opacity
+    DL_SET_BRUSH,
+    // path: flags (DL_PATH_FILL | DL_PATH_STROKE | DL_PATH_CLOSE), segment count, start point, segments
+    // (each segment is a DisplayListOp path command followed by its delta-encoded points)
+    DL_PATH = 0x30,
+    // ellipse: x, y, width, height
+    DL_ELLIPSE,
+    // rectangle: x, y, width, height, radius
+    DL_RECTANGLE,
+    // polyline / polygon: point count, delta-encoded points
+    DL_POLYLINE,
+    DL_POLYGON,
+    // glyph: glyph ref, x, y, font size, width to height ratio * 1000
+    DL_GLYPH = 0x40,
+    // text start: x, y, alignment
+    DL_START_TEXT = 0x50,
+    // text move: x, y, alignment
+    DL_MOVE_TEXT,
+    // text run: text ref, font name ref, font size, font style, font weight, letter spacing, x, y
+    DL_TEXT,
+    DL_END_TEXT,
+    // image: x, y, width, height, uri ref
+    DL_IMAGE = 0x60,
+    // SVG shape: x, y, width, height, scale * 1000, SVG ref
+    DL_SVG_SHAPE,
+    // path commands
+    DL_PATH_LINE_TO = 0x70,
+    DL_PATH_QUAD_TO,
+    DL_PATH_CUBIC_TO
+};
+
+/** Path flags */
+#define DL_PATH_FILL 0x01
+#define DL_PATH_STROKE 0x02
+#define DL_PATH_CLOSE 0x04
+
+//----------------------------------------------------------------------------
+// DisplayListDeviceContext
+//----------------------------------------------------------------------------
+
+/**
+ * This class implements a drawing context that records the drawing operations into a compact binary display list.
+ * The display list can be replayed by a client (e.g., on a HTML canvas) without parsing SVG.
+ *
+ * The buffer starts with the four bytes "VRDL" followed by a one-byte format version (DISPLAYLIST_VERSION).
+ * It is followed by a sequence of operations, each starting with a one-byte DisplayListOp code.
+ * Unsigned integers are LEB128 varints and signed integers are zigzag-encoded varints. Coordinates are in the same
+ * units as the SVG output (i.e., within the definition-scale viewBox) and are delta-encoded within path and point
+ * lists. Strings (ids, classes, font names, text) and glyphs are defined once with DL_DEFINE_STRING and
+ * DL_DEFINE_GLYPH and then referenced by their index + 1 (0 meaning none). Colors are encoded as the RGB value + 1
+ * (0 meaning the current color) and opacities as a byte (0-255).
+ */
+class DisplayListDeviceContext : public DeviceContext {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    DisplayListDeviceContext();
+    virtual ~DisplayListDeviceContext();
+    ///@}
+
+    /**
+     * @name Setters
+     */
+    ///@{
+    void SetBackground(int color, int style = AxSOLID) override {};
+    void SetBackgroundImage(void *image, double opacity = 1.0) override {};
+    void SetBackgroundMode(int mode) override {};
+    void SetTextForeground(int color) override;
+    void SetTextBackground(int color) override {};
+    void SetLogicalOrigin(int x, int y) override;
+    ///@}
+
+    /**
+     * @name Getters
+     */
+    ///@{
+    Point GetLogicalOrigin() override;
+    ///@}
+
+    /**
+     * Return the display list buffer.
+     */
+    const std::vector<uint8_t> &GetDisplayList() const { return m_buffer; }
+
+    /**
+     * @name Drawing methods
+     */
+    ///@{
+    void DrawQuadBezierPath(Point bezier[3]) override;
+    void DrawCubicBezierPath(Point bezier[4]) override;
+    void DrawCubicBezierPathFilled(Point bezier1[4], Point bezier2[4]) override;
+    void DrawCircle(int x, int y, int radius) override;
+    void DrawEllipse(int x, int y, int width, int height) override;
+    void DrawEllipticArc(int x, int y, int width, int height, double start, double end) override;
+    void DrawLine(int x1, int y1, int x2, int y2) override;
+    void DrawPolyline(int n, Point points[], int xOffset, int yOffset) override;
+    void DrawPolygon(int n, Point points[], int xOffset, int yOffset) override;
+    void DrawRectangle(int x, int y, int width, int height) override;
+    void DrawRotatedText(const std::string &text, int x, int y, double angle) override {};
+    void DrawRoundedRectangle(int x, int y, int width, int height, int radius) override;
+    void DrawText(const std::string &text, const std::u32string &wtext = U"", int x = VRV_UNSET, int y = VRV_UNSET,
+        int width = VRV_UNSET, int height = VRV_UNSET) override;
+    void DrawMusicText(const std::u32string &text, int x, int y, bool setSmuflGlyph = false) override;
+    void DrawSpline(int n, Point points[]) override {};
+    void DrawGraphicUri(int x, int y, int width, int height, const std::string &uri) override;
+    void DrawSvgShape(int x, int y, int width, int height, double scale, pugi::xml_node svg) override;
+    void DrawBackgroundImage(int x = 0, int y = 0) override {};
+    ///@}
+
+    /**
+     * @name Method for starting and ending a text
+     */
+    ///@{
+    void StartText(int x, int y, data_HORIZONTALALIGNMENT alignment = HORIZONTALALIGNMENT_left) override;
+    void EndText() override;
+
+    /**
+     * @name Move a text to the specified position, for example when starting a new line.
+     */
+    ///@{
+    void MoveTextTo(int x, int y, data_HORIZONTALALIGNMENT alignment) override;
+    void MoveTextVerticallyTo(int y) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending a graphic
+     */
+    ///@{
+    void StartGraphic(Object *object, const std::string &gClass, const std::string &gId, GraphicID graphicID = PRIMARY,
+        bool prepend = false) override;
+    void EndGraphic(Object *object, View *view) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending a graphic custom graphic that do not correspond to an Object
+     */
+    ///@{
+    void StartCustomGraphic(const std::string &name, std::string gClass = "", std::string gId = "") override;
+    void EndCustomGraphic() override;
+    ///@}
+
+    /**
+     * Method for changing the color of a custom graphic
+     */
+    void SetCustomGraphicColor(const std::string &color) override;
+
+    /**
+     * @name Methods for re-starting and ending a graphic for objects drawn in separate steps
+     */
+    ///@{
+    void ResumeGraphic(Object *object, std::string gId) override;
+    void EndResumedGraphic(Object *object, View *view) override;
+    ///@}
+
+    /**
+     * @name Method for rotating a graphic (clockwise).
+     */
+    ///@{
+    void RotateGraphic(Point const &orig, double angle) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending page
+     */
+    ///@{
+    void StartPage() override;
+    void EndPage() override;
+    ///@}
+
+    /**
+     * Global styling is assumed to be applied by the client (as with SVG and CSS)
+     */
+    bool UseGlobalStyling() override { return true; }
+
+private:
+    /**
+     * @name Low-level encoding methods
+     */
+    ///@{
+    void WriteOp(DisplayListOp op) { m_buffer.push_back((uint8_t)op); }
+    void WriteByte(uint8_t value) { m_buffer.push_back(value); }
+    void WriteUInt(uint32_t value);
+    void WriteInt(int value);
+    void WriteColor(int color);
+    void WriteOpacity(float opacity);
+    void WritePoint(const Point &point);
+    ///@}
+
+    /**
+     * Return the reference (index + 1) of a string, defining it in the display list if necessary.
+     * Return 0 for an empty string.
+     */
+    uint32_t GetStringRef(const std::string &value);
+
+    /**
+     * Return the reference (index + 1) of a glyph, defining it in the display list if necessary.
+     */
+    uint32_t GetGlyphRef(const Glyph *glyph);
+
+    /**
+     * Emit the current pen and brush if they changed since the last drawing operation.
+     */
+    void FlushPenAndBrush();
+
+    /**
+     * Start a path with the first point, after which segments can be added.
+     */
+    void StartPath(uint8_t flags, int segmentCount, const Point &start);
+
+    /**
+     * Write a group start operation with its class and id.
+     */
+    void WriteStartGroup(const std::string &gClass, const std::string &gId, const std::string &color);
+
+public:
+    //
+private:
+    /** The display list buffer */
+    std::vector<uint8_t> m_buffer;
+
+    /** The strings and glyphs already defined in the display list */
+    std::map<std::string, uint32_t> m_strings;
+    std::map<const Glyph *, uint32_t> m_glyphs;
+
+    /** The last pen and brush written to the display list */
+    ///@{
+    bool m_hasFlushedPen;
+    Pen m_flushedPen;
+    bool m_hasFlushedBrush;
+    Brush m_flushedBrush;
+    ///@}
+
+    /** The current position within path and point lists for delta-encoding */
+    Point m_cursor;
+
+    int m_originX, m_originY;
+};
+
+} // namespace vrv
+
+#endif // __VRV_DISPLAYLIST_DC_H__
@@ -8,12 +8,17 @@
 #ifndef __VRV_DOC_H__
 #define __VRV_DOC_H__
 
+#include <atomic>
+
+//----------------------------------------------------------------------------
+
 #include "devicecontextbase.h"
 #include "expansionmap.h"
 #include "facsimile.h"
 #include "options.h"
 #include "resources.h"
 #include "scoredef.h"
+#include "zoneindex.h"
 
 namespace smf {
 class MidiFile;
@@ -21,15 +26,37 @@ class MidiFile;
 
 namespace vrv {
 
+class CastOffPagesFunctor;
 class DocSelection;
+class FeatureExtractor;
 class FontInfo;
 class Glyph;
 class Pages;
 class Page;
 class Score;
+class Timemap;
 
 enum DocType { Raw = 0, Rendering, Transcription, Facs };
 
+/** The number of systems laid out at once when starting a progressive cast-off */
+#define CASTOFF_PENDING_SYSTEMS 8
+
+//----------------------------------------------------------------------------
+// GlyphMetrics
+//----------------------------------------------------------------------------
+
+/**
+ * The metrics of a SMuFL glyph scaled to the drawing music font size (i.e., for a staff size of 100 and no grace size)
+ */
+struct GlyphMetrics {
+    const Glyph *m_glyph = NULL;
+    int m_x = 0;
+    int m_y = 0;
+    int m_width = 0;
+    int m_height = 0;
+    int m_advX = 0;
+};
+
 //----------------------------------------------------------------------------
 // Doc
 //----------------------------------------------------------------------------
@@ -275,8 +302,14 @@ public:
     /**
      * Extract a timemap from the document to a JSON string.
      * Run trough all the layers and fill the timemap file content.
+     * The timemap is an array of objects, or a columnar object (see Timemap::ToColumnarJson).
      */
-    bool ExportTimemap(std::string &output, bool includeRests, bool includeMeasures);
+    bool ExportTimemap(std::string &output, bool includeRests, bool includeMeasures, bool columnar = false);
+
+    /**
+     * Extract a timemap from the document to a binary buffer (see Timemap::ToBinary).
+     */
+    bool ExportTimemapBinary(std::vector<uint8_t> &output, bool includeRests, bool includeMeasures);
 
     /**
      *  Extract expansionMap from the document to JSON string.
@@ -288,6 +321,11 @@ public:
      */
     bool ExportFeatures(std::string &output, const std::string &options);
 
+    /**
+     * Extract music features with the given extractor.
+     */
+    bool ExtractFeatures(FeatureExtractor &extractor);
+
     /**
      * Set the initial scoreDef of each page.
      * This is necessary for integrating changes that occur within a page.
@@ -339,6 +377,35 @@ public:
      */
     void CastOffDocBase(bool useSb, bool usePb, bool smart = false);
 
+    /**
+     * Continue a progressive cast-off (see the progressiveLayout option) until the page (0-based) is final.
+     * All the pending pages are cast off with VRV_UNSET. Does nothing if no cast-off is pending.
+     */
+    void CastOffPendingPages(int pageIdx = VRV_UNSET);
+
+    /**
+     * Return true if a progressive cast-off has content that is not cast off yet.
+     */
+    bool HasPendingCastOff() const { return (m_castOffPendingPage != NULL); }
+
+    /**
+     * Cast off the pages again from the systems already cast off, without redoing the horizontal and vertical layout.
+     * This is possible only for a document cast off with Doc::CastOffDocBase (see Doc::CanCastOffPagesDoc).
+     * It can be used when only options affecting the pages (e.g., the page height) have changed.
+     */
+    void CastOffPagesDoc();
+
+    /**
+     * Return true if the pages can be cast off again with Doc::CastOffPagesDoc.
+     */
+    bool CanCastOffPagesDoc() const;
+
+    /**
+     * Clear the vertical layout results kept for the systems (see Doc::LayOutCastOffSystemsVertically).
+     * Needs to be called when the content of the document or the font changes.
+     */
+    void ResetVerticalLayoutCache();
+
     /**
      * Undo the cast off of the entire document.
      * The document will then contain one single page with one single system.
@@ -461,6 +528,13 @@ public:
     bool HasFacsimile() const { return m_facsimile != NULL; }
     ///@}
 
+    /**
+     * Return the spatial index of the elements with a facsimile zone, building it if necessary.
+     * The index has to be reset with Doc::ResetZoneIndex whenever the elements or the zones are changed.
+     */
+    const ZoneIndex &GetZoneIndex();
+    void ResetZoneIndex() { m_zoneIndex.Reset(); }
+
     /**
      * Return true if the document has been cast off already.
      */
@@ -497,6 +571,11 @@ public:
     ///@}
 
 private:
+    /**
+     * Fill a timemap from the document, calculating the timemap first if necessary.
+     */
+    bool GenerateTimemap(Timemap &timemap);
+
     /**
      * Calculates the music font size according to the m_interlDefin reference value.
      */
@@ -512,6 +591,52 @@ private:
      */
     void CollectVisibleScores();
 
+    /**
+     * Lay out vertically the next systems of the pending page in a separate page and cast them off into pages.
+     * The vertical positions of the systems are shifted to follow the ones previously laid out.
+     */
+    void CastOffPendingSystems(int systemCount);
+
+    /**
+     * Delete the state of a progressive cast-off.
+     * The pending page itself is expected to be deleted with the pages.
+     */
+    void ResetPendingCastOff();
+
+    /**
+     * Store the cast off positions of the systems of a page laid out vertically (see System::m_castOffYRel).
+     */
+    void StoreCastOffPositions(Page *page);
+
+    /**
+     * Lay out vertically the systems of the single page of a cast off and store their cast off positions.
+     * The height of the systems with the same content and options as in a previous cast off is taken from the cache
+     * and these systems are not laid out again. The first system is always laid out for positioning the other ones.
+     */
+    void LayOutCastOffSystemsVertically(Page *page);
+
+    /**
+     * Return the key of a system in the vertical layout cache, built from its first and last children.
+     */
+    std::string GetVerticalLayoutKey(const System *system) const;
+
+    /**
+     * Return the values of the options affecting the vertical layout of the systems.
+     * Options affecting only the pages or the cast off of the systems (e.g., the page width) are left out.
+     */
+    std::string GetVerticalLayoutOptionValues() const;
+
+    /**
+     * Return the metrics of a glyph of the current music font.
+     * The metrics of the SMuFL range are kept in a table reset when the font or the font size changes.
+     */
+    GlyphMetrics GetGlyphMetrics(char32_t code) const;
+
+    /**
+     * Apply the grace and staff size to a value of the glyph metrics
+     */
+    int ScaleGlyphValue(int value, int staffSize, bool graceSize) const;
+
 public:
     Page *m_selectionPreceding;
     Page *m_selectionFollowing;
@@ -596,6 +721,38 @@ private:
      */
     bool m_isCastOff;
 
+    /**
+     * The state of a progressive cast-off.
+     * The pending page holds the content not cast off yet and remains the last child of Pages between the calls to
+     * Doc::CastOffPendingPages, so the content is still visited when processing the entire document.
+     */
+    ///@{
+    Page *m_castOffPendingPage;
+    CastOffPagesFunctor *m_castOffPagesFunctor;
+    /** The bottom of the last system laid out vertically (VRV_UNSET before the first one) */
+    int m_castOffPendingBottom;
+    /** The number of systems to lay out at once, increased with each continuation */
+    int m_castOffPendingSystems;
+    bool m_castOffPendingOptimize;
+    ///@}
+
+    /**
+     * A flag indicating that the systems have their cast off position stored and the pages can be cast off again.
+     */
+    bool m_hasCastOffPositions;
+
+    /**
+     * The height of the systems laid out vertically in previous cast offs, by system key.
+     * The cache is valid only for the option values with which it was filled.
+     */
+    ///@{
+    std::map<std::string, int> m_verticalLayoutCache;
+    std::string m_verticalLayoutOptionValues;
+    ///@}
+
+    /** The spatial index of the elements with a facsimile zone */
+    ZoneIndex m_zoneIndex;
+
     /*
      * The following values are set in the Doc::SetDrawingPage.
      * They are all current values to be used when drawing a page in a View and
@@ -627,6 +784,17 @@ private:
     /** Current fingering font */
     FontInfo m_fingeringFont;
 
+    /**
+     * The metrics of the glyphs indexed by code point from SMUFL_CODE_FIRST.
+     * They are computed lazily for the font revision and the music font size they were computed with.
+     */
+    ///@{
+    mutable std::vector<GlyphMetrics> m_glyphMetrics;
+    mutable std::vector<bool> m_glyphMetricsSet;
+    mutable int m_glyphMetricsRevision;
+    mutable int m_glyphMetricsFontSize;
+    ///@}
+
     /**
      * A flag to indicate whether the currentScoreDef has been set or not.
      * If yes, ScoreDefSetCurrentDoc will not parse the document (again) unless
@@ -651,8 +819,9 @@ private:
      * A flag to indicate whereas the document contains analytical markup to be converted.
      * This is currently limited to @fermata and @tie. Other attribute markup (@accid and @artic)
      * is converted during the import in MEIInput.
+     * It is atomic because measures can be read concurrently (see MEIInput::ReadMeasureRun).
      */
-    int m_markup;
+    std::atomic<int> m_markup;
 
     /**
      * A flag to indicate whereas to document contains only mensural music.
@@ -106,7 +106,6 @@ public:
      */
     ///@{
     bool HasCoords() const { return !m_beamElementCoords.empty(); }
-    void InitCoords(const ArrayOfObjects &childList, Staff *staff, data_BEAMPLACE place);
     void InitCoords(const ListOfObjects &childList, Staff *staff, data_BEAMPLACE place);
     ///@}
 
@@ -9,6 +9,7 @@
 #define __VRV_EDITOR_TOOLKIT_H__
 
 #include <cmath>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -32,6 +33,8 @@ public:
         m_doc = doc;
         m_view = view;
         m_editInfo.reset();
+        m_transactionDepth = 0;
+        m_prepareDataPending = false;
     }
     virtual ~EditorToolkit() {}
 
@@ -44,10 +47,44 @@ public:
      */
     virtual std::string EditInfo() { return m_editInfo.json(); }
 
+    /**
+     * @name Methods for transactions
+     * The update of the document (preparing the data and laying out the edited pages) is deferred until the
+     * transaction is committed and then done only once. Transactions can be nested (e.g., a chain within a
+     * transaction), in which case the update is done when the outermost transaction is committed.
+     */
+    ///@{
+    void BeginTransaction() { ++m_transactionDepth; }
+    bool CommitTransaction();
+    void AbortTransaction();
+    bool IsInTransaction() const { return (m_transactionDepth > 0); }
+    ///@}
+
+protected:
+    /**
+     * Prepare the data of the document and lay out the page (if any) after an action.
+     * Within a transaction, this is deferred until the transaction is committed.
+     */
+    void UpdateDocument(Page *page);
+
+private:
+    /**
+     * Prepare the data and lay out the pages marked in UpdateDocument.
+     */
+    void ApplyPendingUpdates();
+
 protected:
     Doc *m_doc;
     View *m_view;
     jsonxx::Object m_editInfo;
+
+private:
+    /** The nesting level of the current transaction (0 for none) */
+    int m_transactionDepth;
+    /** The flag indicating that the data has to be prepared when the transaction is committed */
+    bool m_prepareDataPending;
+    /** The indexes of the pages to lay out when the transaction is committed */
+    std::set<int> m_pagesToLayOut;
 };
 } // namespace vrv
 
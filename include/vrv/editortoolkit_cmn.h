@@ -29,14 +29,16 @@ namespace vrv {
 class EditorToolkitCMN : public EditorToolkit {
 public:
     EditorToolkitCMN(Doc *doc, View *view) : EditorToolkit(doc, view) {}
-    bool ParseEditorAction(const std::string &json_editorAction) override
-    {
-        return ParseEditorAction(json_editorAction, false);
-    }
-    bool ParseEditorAction(const std::string &json_editorAction, bool commitOnly = false);
+    bool ParseEditorAction(const std::string &json_editorAction) override;
     std::string EditInfo() override;
 
 protected:
+    /**
+     * Perform the action of a parsed JSON object.
+     * Only commit actions are performed with commitOnly (e.g., after an action of a chain failed).
+     */
+    bool ApplyEditorAction(const jsonxx::Object &json, bool commitOnly = false);
+
     /**
      * Parse JSON instructions for experimental editor functions.
      */
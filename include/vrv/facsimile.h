@@ -9,6 +9,7 @@
 #define __VRV_FACSIMILE_H__
 
 #include <cassert>
+#include <unordered_map>
 
 //----------------------------------------------------------------------------
 
@@ -43,10 +44,40 @@ public:
     ///@}
     bool IsSupportedChild(Object *object) override;
 
+    /**
+     * @name Look for a zone or a surface by ID with the index of the facsimile
+     */
+    ///@{
     Zone *FindZoneByID(const std::string &zoneId);
     const Zone *FindZoneByID(const std::string &zoneId) const;
+    Object *FindZoneOrSurfaceByID(const std::string &id);
+    const Object *FindZoneOrSurfaceByID(const std::string &id) const;
+    ///@}
+
+    /**
+     * @name Return the maximum extent of the surfaces
+     */
+    ///@{
     int GetMaxX() const;
     int GetMaxY() const;
+    ///@}
+
+private:
+    /**
+     * Rebuild the ID index and the extents if the facsimile has been modified.
+     * Adding or removing zones marks it as modified with Object::Modify, which needs to be called explicitly
+     * when the coordinates or the IDs of the zones are changed.
+     */
+    void UpdateIndex() const;
+
+public:
+    //
+private:
+    /** The zones and surfaces by ID */
+    mutable std::unordered_map<std::string, Object *> m_idIndex;
+    /** The cached extents of the surfaces */
+    mutable int m_maxX;
+    mutable int m_maxY;
 };
 
 } // namespace vrv
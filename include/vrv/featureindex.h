@@ -0,0 +1,144 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        featureindex.h
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_FEATURE_INDEX_H__
+#define __VRV_FEATURE_INDEX_H__
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vrv {
+
+class FeatureExtractor;
+
+//----------------------------------------------------------------------------
+// FeatureIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class is an inverted n-gram index of the descriptive features of many documents.
+ * For each feature (intervals, contours, pitches), the documents are indexed by the n-grams of their sequence, so
+ * that a query only verifies the documents containing its rarest n-gram. The index keeps the note IDs of each
+ * document and a query returns the notes of each match. It can be written to and read from a compact binary file.
+ */
+class FeatureIndex {
+public:
+    /**
+     * The indexed features, named after the keys of the FeatureExtractor JSON output
+     */
+    enum Feature {
+        FEATURE_intervalsChromatic = 0,
+        FEATURE_intervalsDiatonic,
+        FEATURE_intervalGrossContour,
+        FEATURE_intervalRefinedContour,
+        FEATURE_pitchesChromatic,
+        FEATURE_pitchesChromaticWithDuration,
+        FEATURE_pitchesDiatonic,
+        FEATURE_COUNT
+    };
+
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    FeatureIndex(int ngramSize = 4);
+    virtual ~FeatureIndex();
+    void Reset(int ngramSize);
+    ///@}
+
+    /**
+     * Add the features of a document.
+     * Documents are identified by the given ID, which is returned by the queries.
+     */
+    void AddDocument(const std::string &documentId, const FeatureExtractor &extractor);
+
+    /**
+     * Return the number of documents in the index
+     */
+    int GetDocumentCount() const { return (int)m_documents.size(); }
+
+    /**
+     * Return the n-gram size
+     */
+    int GetNgramSize() const { return m_ngramSize; }
+
+    /**
+     * Search the index and return the matches as a JSON string.
+     * The query is a JSON object with the "feature" name and the "query" sequence, given either as an array or as
+     * a string with space-separated values. An optional "maxResults" limits the number of matches returned.
+     */
+    std::string Search(const std::string &jsonQuery) const;
+
+    /**
+     * Write the index to and read it from a binary stream
+     */
+    ///@{
+    bool Write(std::ostream &output) const;
+    bool Read(std::istream &input);
+    ///@}
+
+    /**
+     * Return the feature with the given name, or FEATURE_COUNT if unknown
+     */
+    static Feature StrToFeature(const std::string &name);
+
+private:
+    struct Posting {
+        uint32_t m_document;
+        uint32_t m_position;
+    };
+
+    struct Document {
+        std::string m_id;
+        // The sequence of each feature as token IDs
+        std::vector<uint32_t> m_sequences[FEATURE_COUNT];
+        // The note IDs of all the pitches, and the offset of the first note of each pitch (with an end offset)
+        std::vector<std::string> m_noteIds;
+        std::vector<uint32_t> m_pitchOffsets;
+    };
+
+    /**
+     * Return the ID of a token of a feature, adding it to the vocabulary if necessary
+     */
+    uint32_t AddToken(Feature feature, const std::string &token);
+
+    /**
+     * Return the key of the n-gram of a sequence starting at a position
+     */
+    uint64_t GetNgramKey(const std::vector<uint32_t> &sequence, size_t position) const;
+
+    /**
+     * Index the n-grams of a document
+     */
+    void IndexDocument(uint32_t documentIdx);
+
+    /**
+     * Return the note IDs of a match of a given length at a position
+     */
+    std::vector<std::string> GetMatchNoteIds(
+        const Document &document, Feature feature, uint32_t position, uint32_t length) const;
+
+public:
+    //
+private:
+    /** The n-gram size */
+    int m_ngramSize;
+    /** The tokens of each feature and their IDs */
+    std::vector<std::string> m_tokens[FEATURE_COUNT];
+    std::unordered_map<std::string, uint32_t> m_tokenIds[FEATURE_COUNT];
+    /** The postings of each n-gram for each feature */
+    std::unordered_map<uint64_t, std::vector<Posting>> m_postings[FEATURE_COUNT];
+    /** The documents */
+    std::vector<Document> m_documents;
+};
+
+} // namespace vrv
+
+#endif // __VRV_FEATURE_INDEX_H__
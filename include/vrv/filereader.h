@@ -81,6 +81,56 @@ private:
 
 }; // class ZipFileReader
 
+//----------------------------------------------------------------------------
+// ZipFileWriter
+//----------------------------------------------------------------------------
+
+/**
+ * This class is a writer for zip archives.
+ * The archive is built in memory and retrieved as a buffer of bytes.
+ */
+class ZipFileWriter {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    ZipFileWriter();
+    ~ZipFileWriter();
+    ///@}
+
+    /**
+     * Reset the archive being written.
+     */
+    void Reset();
+
+    /**
+     * Add a text file to the archive.
+     */
+    void WriteTextFile(const std::string &filename, const std::string &content);
+
+    /**
+     * Finalize the archive and return its content.
+     * The writer is reset afterwards.
+     */
+    std::vector<unsigned char> GetBytes();
+
+    /**
+     * Encode an 8-bit RGBA image as PNG using the miniz deflate implementation.
+     * The image rows are expected to be contiguous and top-down.
+     */
+    static std::vector<unsigned char> EncodePNG(const unsigned char *rgba, int width, int height);
+
+private:
+    //
+public:
+    //
+private:
+    /** A pointer to the miniz zip file */
+    miniz_cpp::zip_file *m_file;
+
+}; // class ZipFileWriter
+
 } // namespace vrv
 
 #endif // __VRV_FILEREADER_H__
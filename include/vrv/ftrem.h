@@ -89,6 +89,7 @@ protected:
      * Filter the flat list and keep only Note or Chords elements.
      */
     void FilterList(ListOfConstObjects &childList) const override;
+    bool IncludesDrawingParts() const override { return false; }
 
     /**
      * See LayerElement::SetElementShortening
@@ -76,6 +76,17 @@ public:
      */
     virtual bool ImplementsEndInterface() const = 0;
 
+    /**
+     * Getters/Setters for the processing flag and the visit count (see Object::Process and ProfilerFunctor)
+     */
+    ///@{
+    bool IsProcessing() const { return m_isProcessing; }
+    void SetProcessing(bool isProcessing) { m_isProcessing = isProcessing; }
+    long GetVisitCount() const { return m_visitCount; }
+    void ResetVisitCount() { m_visitCount = 0; }
+    void IncrementVisitCount() { ++m_visitCount; }
+    ///@}
+
 private:
     //
 public:
@@ -89,6 +100,10 @@ private:
     bool m_visibleOnly = true;
     // Direction
     bool m_direction = FORWARD;
+    // Flag set during the outermost Object::Process call
+    bool m_isProcessing = false;
+    // The number of objects visited by the outermost Object::Process call
+    long m_visitCount = 0;
 };
 
 //----------------------------------------------------------------------------
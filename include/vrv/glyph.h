@@ -9,6 +9,7 @@
 #define __VRV_GLYPH_H__
 
 #include <algorithm>
+#include <array>
 #include <optional>
 #include <string>
 
@@ -159,8 +160,8 @@ private:
     std::string m_path;
     /** XML of the content for files loaded from zip archive custom font */
     std::string m_xml;
-    /** A map of the available anchors */
-    std::map<SMuFLGlyphAnchor, Point> m_anchors;
+    /** The available anchors indexed by SMuFLGlyphAnchor */
+    std::array<std::optional<Point>, SMUFL_ANCHOR_COUNT> m_anchors;
     /** A flag indicating it is a fallback */
     bool m_isFallback;
 };
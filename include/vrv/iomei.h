@@ -10,6 +10,7 @@
 
 #include <sstream>
 #include <stack>
+#include <unordered_set>
 
 //----------------------------------------------------------------------------
 
@@ -610,6 +611,9 @@ public:
     bool Import(const std::string &mei) override;
 
 private:
+    // A method reading an element and adding it to the parent
+    typedef bool (MEIInput::*ElementReader)(Object *parent, pugi::xml_node element);
+
     bool ReadDoc(pugi::xml_node root);
     bool ReadIncipits(pugi::xml_node root);
 
@@ -638,6 +642,19 @@ private:
     ///@{
     bool ReadSection(Object *parent, pugi::xml_node section);
     bool ReadSectionChildren(Object *parent, pugi::xml_node parentNode);
+    ///@}
+
+    /**
+     * @name Methods for reading a run of <measure>, <sb>, <pb> and comment siblings concurrently.
+     * The run is split into chunks of measures, each read into a temporary container by a separate MEIInput
+     * on its own copy of the nodes. The IDs generated for each chunk are then renumbered as if the chunks had
+     * been read one after the other, for the output to be identical to the one of a sequential reading.
+     */
+    ///@{
+    int GetThreadCount() const;
+    std::vector<pugi::xml_node> GetMeasureRun(pugi::xml_node measure) const;
+    std::vector<int> SplitMeasureRun(const std::vector<pugi::xml_node> &run, int threadCount) const;
+    bool ReadMeasureRun(Object *parent, const std::vector<pugi::xml_node> &run, const std::vector<int> &chunkStarts);
     bool ReadEnding(Object *parent, pugi::xml_node ending);
     bool ReadExpansion(Object *parent, pugi::xml_node expansion);
     bool ReadPb(Object *parent, pugi::xml_node pb);
@@ -859,7 +876,7 @@ private:
     /**
      * Returns true if the element is name is an editorial element (e.g., "app", "supplied", etc.)
      */
-    bool IsEditorialElementName(std::string elementName);
+    bool IsEditorialElementName(const std::string &elementName);
 
     /**
      * Normalize attributes of xmlElement, removing white spaces if necessary
@@ -946,7 +963,7 @@ private:
     /**
      * Check if an element is allowed within a given parent
      */
-    bool IsAllowed(std::string element, Object *filterParent);
+    bool IsAllowed(const std::string &element, Object *filterParent);
 
     /**
      * The selected <mdiv>.
@@ -959,6 +976,11 @@ private:
      */
     std::string m_comment;
 
+    /**
+     * The objects with an ID read from the file, collected only when reading a chunk of a measure run
+     */
+    std::unordered_set<const Object *> *m_objectsWithMeiID;
+
     //----------------//
     // Static members //
     //----------------//
@@ -25,10 +25,12 @@ class BeamElementCoord;
 class FTrem;
 class Layer;
 class Liquescent;
+class Measure;
 class Mensur;
 class MeterSig;
 class Staff;
 class StaffAlignment;
+class System;
 
 // Helper enums
 enum StaffSearch { ANCESTOR_ONLY = 0, RESOLVE_CROSS_STAFF };
@@ -224,6 +226,31 @@ public:
     const Staff *GetAncestorStaff(StaffSearch strategy = ANCESTOR_ONLY, bool assertExistence = true) const;
     ///@}
 
+    /**
+     * @name Get the first ancestor layer, measure and system (NULL if none)
+     * The cached ancestors are used when available, otherwise they are looked up.
+     */
+    ///@{
+    Layer *GetAncestorLayer();
+    const Layer *GetAncestorLayer() const;
+    Measure *GetAncestorMeasure();
+    const Measure *GetAncestorMeasure() const;
+    System *GetAncestorSystem();
+    const System *GetAncestorSystem() const;
+    ///@}
+
+    /**
+     * Cache the ancestor layer, staff, measure and system in a single walk up the parent chain.
+     * Called by CacheAncestorsFunctor once the page content is in place before the layout.
+     */
+    void CacheAncestors();
+
+    /**
+     * Reset the cached ancestors, and the ones of the descendants.
+     * Called by Object::SetParent and Object::ResetParent.
+     */
+    void ResetCachedAncestors() override;
+
     /**
      * Look for a cross or a a parent LayerElement (note, chord, rest) with a cross staff.
      * Also set the corresponding m_crossLayer to layer if a cross staff is found.
@@ -379,6 +406,11 @@ protected:
 private:
     int GetDrawingArticulationTopOrBottom(data_STAFFREL place, ArticType type) const;
 
+    /**
+     * Return true if the ancestors are cached for the current parent
+     */
+    bool HasCachedAncestors() const { return (m_cachedParent && (m_cachedParent == this->GetParent())); }
+
     /**
      * Get above/below overflow for the chord elements
      */
@@ -443,6 +475,18 @@ private:
 
     // flag to indicate that layerElement belongs to the beamSpan
     bool m_isInBeamspan;
+
+    /**
+     * The cached ancestors, with the parent they were looked up for.
+     * Checking the parent also invalidates them in copies.
+     */
+    ///@{
+    Layer *m_cachedLayer;
+    Staff *m_cachedStaff;
+    Measure *m_cachedMeasure;
+    System *m_cachedSystem;
+    const Object *m_cachedParent;
+    ///@}
 };
 
 } // namespace vrv
@@ -56,6 +56,45 @@ private:
     Page *m_page;
 };
 
+//----------------------------------------------------------------------------
+// CacheAncestorsFunctor
+//----------------------------------------------------------------------------
+
+/**
+ * This class caches the ancestors of the layer elements.
+ */
+class CacheAncestorsFunctor : public Functor {
+public:
+    /**
+     * @name Constructors, destructors
+     */
+    ///@{
+    CacheAncestorsFunctor();
+    virtual ~CacheAncestorsFunctor() = default;
+    ///@}
+
+    /*
+     * Abstract base implementation
+     */
+    bool ImplementsEndInterface() const override { return false; }
+
+    /*
+     * Functor interface
+     */
+    ///@{
+    FunctorCode VisitLayerElement(LayerElement *layerElement) override;
+    ///@}
+
+protected:
+    //
+private:
+    //
+public:
+    //
+private:
+    //
+};
+
 //----------------------------------------------------------------------------
 // GetAlignmentLeftRightFunctor
 //----------------------------------------------------------------------------
@@ -354,7 +354,14 @@ public:
      * Reset the parent of the Object.
      * The current parent is not expected to be NULL.
      */
-    void ResetParent() { m_parent = NULL; }
+    void ResetParent();
+
+    /**
+     * Reset the ancestors cached by the layer elements of the subtree.
+     * Called every time the parent changes since this changes the ancestors of all the descendants.
+     * See LayerElement::CacheAncestors.
+     */
+    virtual void ResetCachedAncestors();
 
     /**
      * Base method for checking if a child can be added.
@@ -591,6 +598,13 @@ public:
      */
     void Modify(bool modified = true) const;
 
+    /**
+     * Mark the object and its parent (if any) as modified after the child was added or removed.
+     * For drawing parts (stem, flag, dots, tuplet bracket and num), the objects with a flat list never including them
+     * (e.g., Beam or Chord) are not marked, so their list is not rebuilt.
+     */
+    void ModifyFor(const Object *child) const;
+
     /**
      * @name Setter and getter of the attribute flag
      */
@@ -667,6 +681,21 @@ public:
 
     static std::string GenerateHashID();
 
+    /**
+     * Get and set the counter of the IDs generated in the calling thread.
+     * Setting the counter also prevents it from being seeded when the thread creates its first object.
+     */
+    ///@{
+    static uint32_t GetIDCounter() { return s_xmlIDCounter; }
+    static void SetIDCounter(uint32_t counter);
+    ///@}
+
+    /**
+     * Retrieve the counter a hash ID was generated with by GenerateHashID.
+     * Return false if the string cannot be a generated hash ID.
+     */
+    static bool GetHashIDCounter(const std::string &hashID, uint32_t &counter);
+
     static uint32_t Hash(uint32_t number, bool reverse = false);
 
     static bool sortByUlx(Object *a, Object *b);
@@ -863,6 +892,13 @@ public:
      */
     void ResetList() const;
 
+    /**
+     * Return true if the list can include drawing parts (stem, flag, dots, tuplet bracket and num).
+     * Classes filtering them out should override it so that adding or removing them does not invalidate the list.
+     * See Object::ModifyFor
+     */
+    virtual bool IncludesDrawingParts() const { return true; }
+
     /**
      * Convenience functions that check if the list is up-to-date
      * If not, the list is updated before returning the result
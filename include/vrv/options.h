@@ -99,6 +99,23 @@ class OptionJson;
 
 enum class OptionsCategory { None, Base, General, Layout, Mensural, Margins, Midi, Selectors, Full };
 
+/**
+ * The layout stages affected by an option, as bit mask values.
+ * They are used for redoing only the invalidated stages in Toolkit::RedoLayout.
+ * Redoing a stage also redoes the ones following it (i.e., the ones with a lower value).
+ * LAYOUT_STAGE_PAGES includes the layout done when rendering a page. LAYOUT_STAGE_DATA is for the options applied
+ * when loading the data, which cannot be redone without reloading it.
+ */
+enum LayoutStage {
+    LAYOUT_STAGE_NONE = 0,
+    LAYOUT_STAGE_PAGES = 0x01,
+    LAYOUT_STAGE_VERTICAL = 0x02,
+    LAYOUT_STAGE_SYSTEMS = 0x04,
+    LAYOUT_STAGE_HORIZONTAL = 0x08,
+    LAYOUT_STAGE_DATA = 0x10,
+    LAYOUT_STAGE_ALL = 0x1F
+};
+
 #ifdef RUST_LIBRARY
 
 struct OptionStringView {
@@ -118,6 +135,7 @@ public:
     {
         m_shortOption = 0;
         m_isCmdOnly = false;
+        m_layoutStages = LAYOUT_STAGE_ALL;
     }
     virtual ~Option() {}
     virtual void CopyTo(Option *option) = 0;
@@ -144,6 +162,14 @@ public:
     bool IsCmdOnly() const { return m_isCmdOnly; }
     virtual bool IsArgumentRequired() const { return true; }
 
+    /**
+     * @name Set and get the layout stages (LayoutStage bit mask) affected by the option
+     */
+    ///@{
+    void SetLayoutStages(int layoutStages) { m_layoutStages = layoutStages; }
+    int GetLayoutStages() const { return m_layoutStages; }
+    ///@}
+
 #ifdef RUST_LIBRARY
 
     bool SetValueArray(const OptionStringView *values, size_t numValues)
@@ -207,6 +233,8 @@ private:
     char m_shortOption;
     /* a flag indicating that the option is available only on the command line */
     bool m_isCmdOnly;
+    /* the layout stages affected by the option - all by default */
+    int m_layoutStages;
 };
 
 //----------------------------------------------------------------------------
@@ -712,7 +740,7 @@ public:
     void Sync();
 
 private:
-    void Register(Option *option, const std::string &key, OptionGrp *grp);
+    void Register(Option *option, const std::string &key, OptionGrp *grp, int layoutStages = LAYOUT_STAGE_ALL);
 
 public:
     /**
@@ -723,6 +751,11 @@ public:
     // These options are only given for documentation - except for m_scale
     // They are ordered by short option alphabetical order
     OptionBool m_standardOutput;
+    OptionBool m_server;
+    OptionString m_serverSocket;
+    OptionBool m_profile;
+    OptionString m_batch;
+    OptionInt m_jobs;
     OptionString m_help;
     OptionBool m_allPages;
     OptionString m_inputFrom;
@@ -753,6 +786,7 @@ public:
     OptionIntMap m_footer;
     OptionIntMap m_header;
     OptionBool m_humType;
+    OptionInt m_importThreads;
     OptionBool m_incip;
     OptionBool m_justifyVertically;
     OptionBool m_landscape;
@@ -774,6 +808,7 @@ public:
     OptionInt m_pageWidth;
     OptionIntMap m_pedalStyle;
     OptionBool m_preserveAnalyticalMarkup;
+    OptionBool m_progressiveLayout;
     OptionBool m_removeIds;
     OptionBool m_scaleToPageSize;
     OptionBool m_setLocale;
@@ -787,6 +822,7 @@ public:
     OptionBool m_svgHtml5;
     OptionBool m_svgFormatRaw;
     OptionBool m_svgRemoveXlink;
+    OptionBool m_svgCompact;
     OptionArray m_svgAdditionalAttribute;
     OptionDbl m_unit;
     OptionBool m_useFacsimile;
@@ -982,6 +1018,11 @@ private:
 enum OptionsMemberOffsets {
     m_baseOptions = offsetof(Options, m_baseOptions),
     m_standardOutput = offsetof(Options, m_standardOutput),
+    m_server = offsetof(Options, m_server),
+    m_serverSocket = offsetof(Options, m_serverSocket),
+    m_profile = offsetof(Options, m_profile),
+    m_batch = offsetof(Options, m_batch),
+    m_jobs = offsetof(Options, m_jobs),
     m_help = offsetof(Options, m_help),
     m_allPages = offsetof(Options, m_allPages),
     m_inputFrom = offsetof(Options, m_inputFrom),
@@ -1007,6 +1048,7 @@ enum OptionsMemberOffsets {
     m_footer = offsetof(Options, m_footer),
     m_header = offsetof(Options, m_header),
     m_humType = offsetof(Options, m_humType),
+    m_importThreads = offsetof(Options, m_importThreads),
     m_incip = offsetof(Options, m_incip),
     m_justifyVertically = offsetof(Options, m_justifyVertically),
     m_landscape = offsetof(Options, m_landscape),
@@ -1030,6 +1072,7 @@ enum OptionsMemberOffsets {
     m_pageWidth = offsetof(Options, m_pageWidth),
     m_pedalStyle = offsetof(Options, m_pedalStyle),
     m_preserveAnalyticalMarkup = offsetof(Options, m_preserveAnalyticalMarkup),
+    m_progressiveLayout = offsetof(Options, m_progressiveLayout),
     m_removeIds = offsetof(Options, m_removeIds),
     m_scaleToPageSize = offsetof(Options, m_scaleToPageSize),
     m_showRuntime = offsetof(Options, m_showRuntime),
@@ -1042,6 +1085,7 @@ enum OptionsMemberOffsets {
     m_svgHtml5 = offsetof(Options, m_svgHtml5),
     m_svgFormatRaw = offsetof(Options, m_svgFormatRaw),
     m_svgRemoveXlink = offsetof(Options, m_svgRemoveXlink),
+    m_svgCompact = offsetof(Options, m_svgCompact),
     m_svgAdditionalAttribute = offsetof(Options, m_svgAdditionalAttribute),
     m_unit = offsetof(Options, m_unit),
     m_useFacsimile = offsetof(Options, m_useFacsimile),
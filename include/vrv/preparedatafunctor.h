@@ -337,7 +337,7 @@ public:
      * Getter and modifier for the interface / id pairs
      */
     ///@{
-    const ArrayOfPlistInterfaceIDPairs &GetInterfaceIDPairs() const { return m_interfaceIDPairs; }
+    const MapOfPlistInterfaceIDPairs &GetInterfaceIDPairs() const { return m_interfaceIDPairs; }
     void InsertInterfaceIDPair(const std::string &elementID, PlistInterface *interface);
     ///@}
 
@@ -355,8 +355,8 @@ private:
 public:
     //
 private:
-    // Holds the interface / id pairs to match
-    ArrayOfPlistInterfaceIDPairs m_interfaceIDPairs;
+    // Holds the interface / id pairs to match, by id
+    MapOfPlistInterfaceIDPairs m_interfaceIDPairs;
 };
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,120 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        profiler.h
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_PROFILER_H__
+#define __VRV_PROFILER_H__
+
+#include <chrono>
+#include <string>
+#include <typeinfo>
+
+namespace vrv {
+
+class FunctorBase;
+
+//----------------------------------------------------------------------------
+// Profiler
+//----------------------------------------------------------------------------
+
+/**
+ * This class records the wall time of the pipeline stages and of the functors.
+ * For each of them, it counts the calls and the objects visited by the functors.
+ * The records are thread local, each thread recording its own, and are reset by Toolkit::LoadData.
+ */
+class Profiler {
+public:
+    /**
+     * Reset the records of the calling thread
+     */
+    static void Reset();
+
+    /**
+     * Record a functor call (see Object::Process)
+     */
+    static void AddFunctor(const std::type_info &functorType, double milliseconds, long visits);
+
+    /**
+     * Record a stage (see ProfilerStage)
+     */
+    static void AddStage(const std::string &name, double milliseconds, long visits);
+
+    /**
+     * Return the number of objects visited by the functors recorded so far
+     */
+    static long GetVisitCount();
+
+    /**
+     * Return the records as a JSON string.
+     * Stages are given in the order they were first recorded. They can be nested (e.g., the layout within the
+     * cast-off) and the visits of a stage are the ones of the functors processed during it.
+     * Functors are given from the slowest to the fastest.
+     */
+    static std::string GetJson();
+};
+
+//----------------------------------------------------------------------------
+// ProfilerStage
+//----------------------------------------------------------------------------
+
+/**
+ * This class records a stage in the Profiler during its lifetime.
+ */
+class ProfilerStage {
+public:
+    /**
+     * @name Constructors, destructors
+     */
+    ///@{
+    ProfilerStage(const std::string &name);
+    ~ProfilerStage();
+    ///@}
+
+private:
+    //
+public:
+    //
+private:
+    // The name of the stage
+    std::string m_name;
+    // The start time
+    std::chrono::steady_clock::time_point m_start;
+    // The visit count at the start
+    long m_startVisits;
+};
+
+//----------------------------------------------------------------------------
+// ProfilerFunctor
+//----------------------------------------------------------------------------
+
+/**
+ * This class records a functor call in the Profiler during its lifetime.
+ * It is instantiated by the outermost Object::Process call of the functor.
+ */
+class ProfilerFunctor {
+public:
+    /**
+     * @name Constructors, destructors
+     */
+    ///@{
+    ProfilerFunctor(FunctorBase &functor);
+    ~ProfilerFunctor();
+    ///@}
+
+private:
+    //
+public:
+    //
+private:
+    // The functor
+    FunctorBase &m_functor;
+    // The start time
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace vrv
+
+#endif // __VRV_PROFILER_H__
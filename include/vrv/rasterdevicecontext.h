@@ -0,0 +1,373 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        rasterdevicecontext.h
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_RASTER_DC_H__
+#define __VRV_RASTER_DC_H__
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "devicecontext.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+class Glyph;
+
+/** The number of sub-scanlines per pixel row for anti-aliasing */
+#define RASTER_SUBSAMPLES 4
+
+/** The maximum number of pixels of a page (256 MB of RGBA) */
+#define RASTER_MAX_PIXELS (64 * 1024 * 1024)
+
+//----------------------------------------------------------------------------
+// Raster structures
+//----------------------------------------------------------------------------
+
+/**
+ * A point in pixels (or in font units for glyph outlines)
+ */
+struct RasterPoint {
+    double x;
+    double y;
+};
+
+/**
+ * A closed contour given as a list of points.
+ */
+typedef std::vector<RasterPoint> RasterContour;
+
+/**
+ * A command of a glyph outline in font units (absolute coordinates, y-axis up).
+ * The type is one of 'M', 'L', 'Q', 'C' or 'Z', with 1, 1, 2, 3 and 0 points respectively.
+ */
+struct RasterPathCommand {
+    char m_type;
+    RasterPoint m_points[3];
+};
+
+/**
+ * A glyph of a text run with its horizontal offset from the start of the run.
+ * Outlined glyphs are music font glyphs. Other glyphs are text font glyphs for which only the bounding box is known
+ * and that are drawn with the stroke font.
+ */
+struct RasterTextGlyph {
+    const Glyph *m_glyph;
+    int m_x;
+    bool m_outline;
+    char32_t m_code;
+};
+
+/**
+ * A text run waiting for its line to be aligned.
+ */
+struct RasterTextRun {
+    std::vector<RasterTextGlyph> m_glyphs;
+    int m_y;
+    int m_width;
+    int m_pointSize;
+    int m_color;
+    float m_opacity;
+    bool m_bold;
+    bool m_italic;
+};
+
+/**
+ * The state of a graphic group: the color, the visibility and the rotation.
+ */
+struct RasterGraphic {
+    int m_color;
+    bool m_visible;
+    double m_angle;
+    Point m_rotationOrigin;
+};
+
+//----------------------------------------------------------------------------
+// RasterDeviceContext
+//----------------------------------------------------------------------------
+
+/**
+ * This class implements a drawing context that rasterizes directly into an RGBA buffer on the CPU.
+ * It renders the same page as the SVG output (same size and scaling) and can encode it as PNG.
+ *
+ * Shapes are filled with an anti-aliased scanline rasterizer using the non-zero winding rule. Bézier curves are
+ * flattened and strokes are converted to outlines. Music glyphs are rendered from the SMuFL path data of the
+ * resources. Since only the bounding boxes of the text fonts are available, text in a text font is rendered with a
+ * basic stroke font fitted into the glyph boxes (with boxes for the characters other than ASCII), whereas text in a
+ * SMuFL font is rendered with the glyph outlines. Pages larger than RASTER_MAX_PIXELS are not rendered.
+ * Embedded images and SVG shapes are not rendered.
+ */
+class RasterDeviceContext : public DeviceContext {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    RasterDeviceContext();
+    virtual ~RasterDeviceContext();
+    ///@}
+
+    /**
+     * @name Setters
+     */
+    ///@{
+    void SetBackground(int color, int style = AxSOLID) override;
+    void SetBackgroundImage(void *image, double opacity = 1.0) override {};
+    void SetBackgroundMode(int mode) override {};
+    void SetTextForeground(int color) override;
+    void SetTextBackground(int color) override {};
+    void SetLogicalOrigin(int x, int y) override;
+    ///@}
+
+    /**
+     * @name Getters
+     */
+    ///@{
+    Point GetLogicalOrigin() override;
+    ///@}
+
+    /**
+     * Setting the facsimile flag - the page is then not scaled with the DEFINITION_FACTOR
+     */
+    void SetFacsimile(bool facsimile) { m_facsimile = facsimile; }
+
+    /**
+     * @name Getters for the raster image
+     * The pixels are 8-bit RGBA without pre-multiplied alpha.
+     */
+    ///@{
+    int GetPixelWidth() const { return m_pixelWidth; }
+    int GetPixelHeight() const { return m_pixelHeight; }
+    std::vector<uint8_t> GetRGBA() const;
+    ///@}
+
+    /**
+     * Return the raster image encoded as PNG.
+     */
+    std::vector<uint8_t> GetPNG() const;
+
+    /**
+     * @name Drawing methods
+     */
+    ///@{
+    void DrawQuadBezierPath(Point bezier[3]) override;
+    void DrawCubicBezierPath(Point bezier[4]) override;
+    void DrawCubicBezierPathFilled(Point bezier1[4], Point bezier2[4]) override;
+    void DrawCircle(int x, int y, int radius) override;
+    void DrawEllipse(int x, int y, int width, int height) override;
+    void DrawEllipticArc(int x, int y, int width, int height, double start, double end) override;
+    void DrawLine(int x1, int y1, int x2, int y2) override;
+    void DrawPolyline(int n, Point points[], int xOffset, int yOffset) override;
+    void DrawPolygon(int n, Point points[], int xOffset, int yOffset) override;
+    void DrawRectangle(int x, int y, int width, int height) override;
+    void DrawRotatedText(const std::string &text, int x, int y, double angle) override {};
+    void DrawRoundedRectangle(int x, int y, int width, int height, int radius) override;
+    void DrawText(const std::string &text, const std::u32string &wtext = U"", int x = VRV_UNSET, int y = VRV_UNSET,
+        int width = VRV_UNSET, int height = VRV_UNSET) override;
+    void DrawMusicText(const std::u32string &text, int x, int y, bool setSmuflGlyph = false) override;
+    void DrawSpline(int n, Point points[]) override {};
+    void DrawGraphicUri(int x, int y, int width, int height, const std::string &uri) override {};
+    void DrawSvgShape(int x, int y, int width, int height, double scale, pugi::xml_node svg) override {};
+    void DrawBackgroundImage(int x = 0, int y = 0) override {};
+    ///@}
+
+    /**
+     * @name Method for starting and ending a text
+     */
+    ///@{
+    void StartText(int x, int y, data_HORIZONTALALIGNMENT alignment = HORIZONTALALIGNMENT_left) override;
+    void EndText() override;
+
+    /**
+     * @name Move a text to the specified position, for example when starting a new line.
+     */
+    ///@{
+    void MoveTextTo(int x, int y, data_HORIZONTALALIGNMENT alignment) override;
+    void MoveTextVerticallyTo(int y) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending a graphic
+     */
+    ///@{
+    void StartGraphic(Object *object, const std::string &gClass, const std::string &gId, GraphicID graphicID = PRIMARY,
+        bool prepend = false) override;
+    void EndGraphic(Object *object, View *view) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending a graphic custom graphic that do not correspond to an Object
+     */
+    ///@{
+    void StartCustomGraphic(const std::string &name, std::string gClass = "", std::string gId = "") override;
+    void EndCustomGraphic() override;
+    ///@}
+
+    /**
+     * Method for changing the color of a custom graphic
+     */
+    void SetCustomGraphicColor(const std::string &color) override;
+
+    /**
+     * @name Methods for re-starting and ending a graphic for objects drawn in separate steps
+     */
+    ///@{
+    void ResumeGraphic(Object *object, std::string gId) override;
+    void EndResumedGraphic(Object *object, View *view) override;
+    ///@}
+
+    /**
+     * @name Method for rotating a graphic (clockwise).
+     */
+    ///@{
+    void RotateGraphic(Point const &orig, double angle) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending page
+     */
+    ///@{
+    void StartPage() override;
+    void EndPage() override;
+    ///@}
+
+    /**
+     * Parse a CSS color (#rgb, #rrggbb, rgb() or a basic color name) into an RGB value.
+     * Return AxNONE if the color cannot be parsed.
+     */
+    static int ParseColor(const std::string &color);
+
+private:
+    /**
+     * Convert logical coordinates to pixels, including the rotation of the current graphic.
+     */
+    RasterPoint ToPixel(double x, double y) const;
+
+    /**
+     * Return the width of the pen in pixels, with a minimum value in logical units.
+     */
+    double GetPenPixelWidth(int minWidth) const;
+
+    /**
+     * Resolve a pen or brush color (AxNONE being the color of the current graphic).
+     */
+    int ResolveColor(int color) const;
+
+    /**
+     * Return true if drawing is currently visible.
+     */
+    bool IsVisible() const { return m_graphicStack.back().m_visible; }
+
+    /**
+     * @name Methods for flattening curves in pixels
+     */
+    ///@{
+    void FlattenQuad(RasterContour &contour, const RasterPoint &p1, const RasterPoint &p2) const;
+    void FlattenCubic(
+        RasterContour &contour, const RasterPoint &p1, const RasterPoint &p2, const RasterPoint &p3) const;
+    ///@}
+
+    /**
+     * Add a disc (with the same orientation as the stroke segments) to the contours.
+     */
+    void AddDisc(std::vector<RasterContour> &contours, const RasterPoint &center, double radius) const;
+
+    /**
+     * Stroke a polyline given in pixels with the current pen.
+     * The dash and gap lengths are in logical units.
+     */
+    void StrokeContour(const RasterContour &points, bool closed, double width, int lineCap, int lineJoin,
+        int dashLength, int gapLength, int color, float opacity);
+
+    /**
+     * Fill the contours with the non-zero winding rule.
+     */
+    void FillContours(const std::vector<RasterContour> &contours, int color, float opacity);
+
+    /**
+     * Fill a rectangle given in logical units.
+     */
+    void FillRectangle(int x, int y, int width, int height, int color, float opacity);
+
+    /**
+     * Blend a color into a pixel with the given coverage.
+     */
+    void BlendPixel(int x, int y, int color, float alpha);
+
+    /**
+     * Return the outline of a glyph, parsing the SVG path data of the glyph if not done yet.
+     */
+    const std::vector<RasterPathCommand> &GetGlyphOutline(const Glyph *glyph);
+
+    /**
+     * Fill a glyph outline at the logical position with the font size and the width to height ratio.
+     */
+    void FillGlyph(const Glyph *glyph, int x, int y, int pointSize, double ratio, int color, float opacity);
+
+    /**
+     * Draw a text font glyph of a run with the stroke font at the logical position of the run.
+     */
+    void StrokeTextGlyph(const RasterTextGlyph &textGlyph, const RasterTextRun &run, int x);
+
+    /**
+     * Draw the text runs of the current line with the current alignment and clear them.
+     */
+    void FlushTextLine();
+
+    /**
+     * Push a graphic state inheriting from the current one.
+     */
+    void PushGraphic();
+
+public:
+    //
+private:
+    /** The RGBA pixels (pre-multiplied alpha) */
+    std::vector<uint8_t> m_pixels;
+
+    /** The size of the image in pixels */
+    int m_pixelWidth, m_pixelHeight;
+
+    /** The scale and offset from logical units to pixels */
+    double m_pixelScale, m_pixelOffsetX, m_pixelOffsetY;
+
+    /** The background color (AxNONE for transparent) */
+    int m_backgroundColor;
+
+    /** Flag for facsimile pages */
+    bool m_facsimile;
+
+    /** The stack of graphic states */
+    std::vector<RasterGraphic> m_graphicStack;
+
+    /** The graphic states with an explicit color or visibility, by id, for resumed graphics */
+    std::map<std::string, RasterGraphic> m_resumableGraphics;
+
+    /** The outlines of the glyphs already parsed */
+    std::map<const Glyph *, std::vector<RasterPathCommand>> m_glyphOutlines;
+
+    /**
+     * Members for the current text line.
+     * Runs are buffered because the alignment needs the width of the full line.
+     */
+    ///@{
+    int m_textX, m_textY;
+    data_HORIZONTALALIGNMENT m_textAlignment;
+    std::vector<RasterTextRun> m_textRuns;
+    ///@}
+
+    int m_originX, m_originY;
+};
+
+} // namespace vrv
+
+#endif // __VRV_RASTER_DC_H__
@@ -11,6 +11,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 //----------------------------------------------------------------------------
 
@@ -21,6 +22,10 @@ namespace vrv {
 
 class ResourceIO;
 
+/** The range of the SMuFL code points (private use area) looked up in a dense table */
+#define SMUFL_CODE_FIRST 0xE000
+#define SMUFL_CODE_LAST 0xF8FF
+
 //----------------------------------------------------------------------------
 // Resources
 //----------------------------------------------------------------------------
@@ -94,6 +99,12 @@ public:
     bool IsFontLoaded(const std::string &fontName) const { return m_loadedFonts.find(fontName) != m_loadedFonts.end(); }
     ///@}
 
+    /**
+     * Return the revision of the fonts, which changes each time the current font, the fallback font or the loaded
+     * fonts change. It can be used for invalidating values derived from the glyphs.
+     */
+    int GetRevision() const { return m_revision; }
+
     /**
      * Retrieving glyphs
      */
@@ -180,12 +191,29 @@ private:
     const GlyphTable &GetCurrentGlyphTable() const { return m_loadedFonts.at(m_currentFontName).GetGlyphTable(); };
     const GlyphTable &GetFallbackGlyphTable() const { return m_loadedFonts.at(m_fallbackFontName).GetGlyphTable(); };
 
+    /**
+     * Build the dense table of the SMuFL glyphs for the current font (with the fallback font)
+     */
+    void BuildSmuflGlyphTable() const;
+
     std::string m_path;
     std::string m_defaultFontName;
     std::string m_fallbackFontName;
     std::map<std::string, LoadedFont> m_loadedFonts;
     std::string m_currentFontName;
 
+    /** The revision of the fonts */
+    int m_revision;
+
+    /**
+     * The glyphs of the current font (or of the fallback font) indexed by code point from SMUFL_CODE_FIRST.
+     * The table is built lazily when the revision changes.
+     */
+    ///@{
+    mutable std::vector<const Glyph *> m_smuflGlyphs;
+    mutable int m_smuflGlyphsRevision;
+    ///@}
+
     /** A text font used for bounding box calculations */
     GlyphTextMap m_textFont;
     mutable StyleAttributes m_currentStyle;
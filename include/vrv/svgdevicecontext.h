@@ -71,6 +71,14 @@ public:
      */
     std::string GetStringSVG(bool xml_declaration = false);
 
+    /**
+     * Merge SVGs into one with the SVGs stacked vertically.
+     * The glyph definitions and the styles are shared, and each SVG is nested with the ID prefix and its index as
+     * ID. An SVG that cannot be parsed is replaced with an empty one.
+     */
+    static std::string CreateSpriteSheet(const std::vector<std::string> &svgs, const std::string &idPrefix,
+        bool xml_declaration = false, int indent = 3, bool formatRaw = false);
+
     /**
      * @name Drawing methods
      */
@@ -225,6 +233,14 @@ public:
      */
     void SetRemoveXlink(bool removeXlink) { m_removeXlink = removeXlink; }
 
+    /**
+     * Set the SVG to be compact. Stroke styles shared by most paths are replaced by CSS classes (prefixed with vrv-),
+     * numbers are written without trailing zeros, empty groups without id or class are removed and the formatting
+     * is raw.
+     * Since the CSS classes are defined in the global style, this has no effect with mm output.
+     */
+    void SetCompact(bool compact) { m_compact = compact; }
+
     /**
      * Setter for an additional CSS
      */
@@ -300,8 +316,24 @@ private:
     void AppendStrokeLineCap(pugi::xml_node node, const Pen &pen);
     void AppendStrokeLineJoin(pugi::xml_node node, const Pen &pen);
     void AppendStrokeDashArray(pugi::xml_node node, const Pen &pen);
+    void AppendStroke(pugi::xml_node node, const Pen &pen, bool roundStroke = false, bool noFill = false);
     ///@}
 
+    /**
+     * Return true if the output is compact (which requires global styling)
+     */
+    bool IsCompact() { return m_compact && this->UseGlobalStyling(); }
+
+    /**
+     * Format a floating point number (without the trailing zeros in compact mode)
+     */
+    std::string FormatDouble(double value);
+
+    /**
+     * Remove the groups without children, id and class from the node and its descendants (in compact mode)
+     */
+    void RemoveEmptyGroups(pugi::xml_node node);
+
 public:
     //
 private:
@@ -373,6 +405,8 @@ private:
     bool m_formatRaw;
     // remove xlink from href attributes
     bool m_removeXlink;
+    // compact output
+    bool m_compact;
     // indentation value (-1 for tabs)
     int m_indent;
     // postfix to be added to font glyphs
@@ -219,6 +219,15 @@ public:
     int m_castOffTotalWidth;
     int m_castOffJustifiableWidth;
     ///@}
+    /**
+     * @name The cast off Y relative position (from the top of the page content) and height of the system.
+     * They are stored when the systems are laid out vertically on a single page before casting off the pages.
+     * This makes it possible to cast off the pages again without the vertical layout, e.g., for a new page height.
+     */
+    ///@{
+    int m_castOffYRel;
+    int m_castOffHeight;
+    ///@}
 
 protected:
     /**
@@ -77,6 +77,7 @@ protected:
      * Filter the flat list and keep only Note elements.
      */
     void FilterList(ListOfConstObjects &childList) const override;
+    bool IncludesDrawingParts() const override { return false; }
 
 private:
     //
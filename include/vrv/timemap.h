@@ -9,7 +9,7 @@
 #define __VRV_TIMEMAP_H__
 
 #include <cassert>
-#include <map>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -20,20 +20,22 @@ namespace vrv {
 class Object;
 
 //----------------------------------------------------------------------------
-// TimemapEntry
+// TimemapEvent
 //----------------------------------------------------------------------------
 
+enum TimemapEventType : uint8_t { TIMEMAP_noteOn = 0, TIMEMAP_noteOff, TIMEMAP_restOn, TIMEMAP_restOff, TIMEMAP_measureOn };
+
 /**
- * Helper struct to store timemap entries
+ * Helper struct to store timemap events.
+ * The events are stored in the order they are generated and grouped by time when the timemap is written.
  */
-struct TimemapEntry {
-    double tempo = -1000.0;
+struct TimemapEvent {
+    double time;
     double qstamp;
-    std::vector<std::string> notesOn;
-    std::vector<std::string> notesOff;
-    std::vector<std::string> restsOn;
-    std::vector<std::string> restsOff;
-    std::string measureOn;
+    // The tempo at the event, or -1000.0 for events not setting it
+    double tempo;
+    const Object *object;
+    TimemapEventType type;
 };
 
 //----------------------------------------------------------------------------
@@ -42,6 +44,9 @@ struct TimemapEntry {
 
 /**
  * This class holds a timemap for exporting onset / offset values.
+ * It can be written as an array of objects with one object for each time (see Timemap::ToJson), or in a columnar
+ * layout with one array for each value and the IDs stored once in a table (see Timemap::ToColumnarJson and
+ * Timemap::ToBinary).
  */
 class Timemap {
 public:
@@ -57,22 +62,69 @@ public:
     void Reset();
 
     /**
-     * Return (and possibly add) an entry for the given time.
+     * Add an event at the given time.
      */
-    TimemapEntry &GetEntry(double time) { return m_map[time]; }
+    void AddEvent(double time, double qstamp, TimemapEventType type, const Object *object, double tempo = -1000.0)
+    {
+        m_events.push_back({ time, qstamp, tempo, object, type });
+    }
 
     /**
      * Write the current timemap to a JSON string
      */
     void ToJson(std::string &output, bool includetRests, bool includetMeasures);
 
+    /**
+     * Write the current timemap to a columnar JSON string.
+     * The object has the "tstamp" and "qstamp" arrays, the "ids" table, and for the notes (and optionally the rests)
+     * an array of indexes in the table with the offsets of each time in it (e.g., the IDs of the notes turned on at
+     * time i are the ones of "on" from onOffsets[i] to onOffsets[i + 1]). The measures are given by their time
+     * index and ID index, and the tempo by the time index where it changes and its value.
+     */
+    void ToColumnarJson(std::string &output, bool includeRests, bool includeMeasures);
+
+    /**
+     * Write the current timemap to a binary buffer with the same content as the columnar JSON.
+     * All the values are little-endian: the "VTM1" signature, the flags (1 for the rests, 2 for the measures)
+     * and the time count as uint32, the tstamp and qstamp values as float64, the ID count as uint32 followed by
+     * each ID with its length as uint32, then for each index array the offsets (time count + 1) and the indexes
+     * as uint32, then the measure count as uint32 and the measure time and ID indexes, and finally the tempo
+     * count as uint32 followed by the time indexes as uint32 and the tempo values as float64.
+     */
+    void ToBinary(std::vector<uint8_t> &output, bool includeRests, bool includeMeasures);
+
 private:
-    //
+    /**
+     * The timemap in a columnar layout
+     */
+    struct Columns {
+        std::vector<double> tstamps;
+        std::vector<double> qstamps;
+        std::vector<const Object *> ids;
+        // The offsets and the ID indexes for the notes on and off and the rests on and off
+        std::vector<uint32_t> offsets[4];
+        std::vector<uint32_t> indexes[4];
+        std::vector<uint32_t> measureTimes;
+        std::vector<uint32_t> measureIds;
+        std::vector<uint32_t> tempoTimes;
+        std::vector<double> tempos;
+    };
+
+    /**
+     * Sort the events by time, keeping the generation order for events at the same time
+     */
+    void SortEvents();
+
+    /**
+     * Build the columns from the sorted events
+     */
+    void GetColumns(Columns &columns, bool includeRests, bool includeMeasures);
+
 public:
     //
 private:
-    /** The map with time values as keys */
-    std::map<double, TimemapEntry> m_map;
+    /** The events in the order they were added */
+    std::vector<TimemapEvent> m_events;
 
 }; // class Timemap
 
@@ -23,6 +23,7 @@
 namespace vrv {
 
 class EditorToolkit;
+class FeatureIndex;
 class RuntimeClock;
 
 /**
@@ -98,11 +99,30 @@ public:
 
     /**
      * Get the log content for the latest operation.
+     * The log buffer is thread local and contains only the messages logged by the calling thread.
      *
      * @return The log content as a string
      */
     std::string GetLog();
 
+    /**
+     * Get the log content for the latest operation as structured entries.
+     * Each message is given once with its level and the number of times it was logged.
+     *
+     * @return A stringified JSON array with the level, count and message of each entry
+     */
+    std::string GetLogEntries();
+
+    /**
+     * Get the profile of the latest loaded data.
+     * The profile gives the time spent in the pipeline stages (import, layout, rendering, etc.) and in each
+     * functor, with the number of calls and of objects visited. It is reset by Toolkit::LoadData and is thread
+     * local.
+     *
+     * @return A stringified JSON object with the "stages" and the "functors" arrays
+     */
+    std::string GetProfile();
+
     /**
      * Return the version number.
      *
@@ -198,10 +218,22 @@ public:
      *
      * The number of pages depends one the page size and if encoded layout was taken into account or not.
      *
+     * With the progressiveLayout option, the number of pages increases as the layout progresses.
+     * See IsPageCountFinal().
+     *
      * @return The number of pages
      */
     int GetPageCount() const;
 
+    /**
+     * Return true if the number of pages returned by GetPageCount() is final.
+     *
+     * This is always the case unless the progressiveLayout option is enabled and the layout is not completed.
+     *
+     * @return True if all the pages are laid out
+     */
+    bool IsPageCountFinal() const;
+
     ///@}
 
     /**
@@ -340,6 +372,30 @@ public:
      **/
     std::string EditInfo();
 
+    /**
+     * Start an edit transaction.
+     *
+     * The document is updated only once when the transaction is committed instead of after each edit action.
+     * The MEI of the document is kept as undo log until the transaction is committed or rolled back.
+     *
+     * @return True if the transaction was started
+     **/
+    bool BeginEditTransaction();
+
+    /**
+     * Commit the current edit transaction and update the document.
+     *
+     * @return True if a transaction was committed
+     **/
+    bool CommitEditTransaction();
+
+    /**
+     * Roll back the current edit transaction by reloading the document from the undo log.
+     *
+     * @return True if the document was reloaded
+     **/
+    bool RollbackEditTransaction();
+
     ///@}
 
     /**
@@ -361,6 +417,24 @@ public:
      */
     std::string RenderData(const std::string &data, const std::string &jsonOptions);
 
+    /**
+     * Render many incipits (e.g., Plaine & Easie) on a single system each.
+     *
+     * The incipits are rendered with the options of the toolkit, the header, the footer and the breaks being
+     * turned off and the page height adjusted. They are distributed to toolkits rendering them concurrently, which
+     * are kept for the next calls. When the xmlIdSeed option is set, the IDs are seeded before each incipit, and
+     * with xmlIdSeed + the index of the incipit in a sprite sheet.
+     *
+     * @param jsonIncipits A stringified JSON array with the incipits given as strings or as objects (for
+     * Plaine & Easie with keys)
+     * @param jsonOptions A stringified JSON object with "threads" (0 for one per core), "spriteSheet" for
+     * returning one SVG with the incipits stacked and sharing the glyph definitions, "xmlDeclaration", and
+     * "options" with the options applied to the incipits only
+     * @return A stringified JSON array with the SVG of each incipit (empty for an incipit that could not be
+     * loaded), or the SVG sprite sheet
+     */
+    std::string RenderIncipitsToSVG(const std::string &jsonIncipits, const std::string &jsonOptions = "");
+
     /**
      * Render a page to SVG.
      *
@@ -381,11 +455,39 @@ public:
      */
     bool RenderToSVGFile(const std::string &filename, int pageNo = 1);
 
-#ifdef RUST_LIBRARY
+    /**
+     * Render a page to a binary display list.
+     *
+     * The display list records the drawing operations (paths, glyphs, text runs and groups with their ids and
+     * classes) so that it can be replayed by a client without parsing SVG. See DisplayListDeviceContext for the
+     * format.
+     *
+     * @param pageNo The page to render (1-based)
+     * @return The display list as a buffer of bytes
+     */
+    std::vector<uint8_t> RenderToDisplayList(int pageNo = 1);
 
-    std::vector<uint8_t> RenderToMIDIBinary();
+    /**
+     * Render a page to a PNG image.
+     *
+     * The page is rasterized directly without going through SVG, with the same size as the SVG output.
+     * Text in a text font is rendered as greeked boxes. See RasterDeviceContext.
+     *
+     * @param pageNo The page to render (1-based)
+     * @return The PNG image as a buffer of bytes (empty if the page could not be rendered)
+     */
+    std::vector<uint8_t> RenderToPNG(int pageNo = 1);
 
-#endif
+    /**
+     * Render a page to a PNG image and save it to the file.
+     *
+     * @remark nojs
+     *
+     * @param filename The output filename
+     * @param pageNo The page to render (1-based)
+     * @return True if the file was successfully written
+     */
+    bool RenderToPNGFile(const std::string &filename, int pageNo = 1);
 
     /**
      * Render the document to MIDI.
@@ -394,6 +496,15 @@ public:
      */
     std::string RenderToMIDI();
 
+    /**
+     * Render the document to MIDI as a buffer of bytes.
+     *
+     * This avoids the base64 encoding of Toolkit::RenderToMIDI.
+     *
+     * @return A MIDI file as a buffer of bytes
+     */
+    std::vector<uint8_t> RenderToMIDIBinary();
+
     /**
      * Render a document to MIDI and save it to the file.
      *
@@ -428,11 +539,24 @@ public:
     /**
      * Render a document to a timemap.
      *
+     * With the "columnar" option, the timemap is an object with one array for each value and the IDs given once
+     * in a table, which is more compact for long scores.
+     *
      * @param jsonOptions A stringified JSON objects with the timemap options
      * @return The timemap as a string
      */
     std::string RenderToTimemap(const std::string &jsonOptions = "");
 
+    /**
+     * Render a document to a timemap in a binary form.
+     *
+     * The buffer has the same content as the columnar timemap (see Timemap::ToBinary for the layout).
+     *
+     * @param jsonOptions A stringified JSON objects with the timemap options
+     * @return The timemap as a buffer of bytes
+     */
+    std::vector<uint8_t> RenderToTimemapBinary(const std::string &jsonOptions = "");
+
     /**
      * Render a document's expansionMap, if existing
      *
@@ -538,6 +662,17 @@ public:
      */
     bool SaveFile(const std::string &filename, const std::string &jsonOptions = "");
 
+    /**
+     * Get the MEI as a zip-compressed archive.
+     *
+     * The archive contains the MEI file and a META-INF/container.xml file pointing to it, so it can be reloaded
+     * with Toolkit::LoadZipDataBuffer.
+     *
+     * @param jsonOptions A stringified JSON object with the output options (see Toolkit::GetMEI)
+     * @return The zip archive as a buffer of bytes (empty if the MEI could not be generated)
+     */
+    std::vector<uint8_t> GetMEIZipBinary(const std::string &jsonOptions = "");
+
     ///@}
 
     /**
@@ -557,6 +692,51 @@ public:
      */
     std::string GetDescriptiveFeatures(const std::string &jsonOptions);
 
+    /**
+     * Add the descriptive features of the loaded document to the feature index of the toolkit.
+     *
+     * The index is kept when loading other data, so a collection is indexed by loading each of its documents
+     * and adding it. The index can then be saved, loaded and searched without the documents.
+     *
+     * @param documentId The ID identifying the document in the search results
+     * @return True if the features were added
+     */
+    bool AddToFeatureIndex(const std::string &documentId);
+
+    /**
+     * Clear the feature index of the toolkit.
+     *
+     * @param jsonOptions A stringified JSON object with the index options (e.g., "ngramSize": 4)
+     */
+    void ResetFeatureIndex(const std::string &jsonOptions = "");
+
+    /**
+     * Load the feature index from a file, replacing the index of the toolkit.
+     *
+     * @param filename The file written by Toolkit::SaveFeatureIndexFile
+     * @return True if the file was successfully read
+     */
+    bool LoadFeatureIndexFile(const std::string &filename);
+
+    /**
+     * Save the feature index of the toolkit to a binary file.
+     *
+     * @param filename The output filename
+     * @return True if the file was successfully written
+     */
+    bool SaveFeatureIndexFile(const std::string &filename);
+
+    /**
+     * Search the feature index for a melodic sequence.
+     *
+     * The query gives the feature (e.g., "intervalsChromatic" or "pitchesDiatonic", as in the descriptive features)
+     * and the sequence to look for as an array or a space-separated string (e.g., "2 2 -4").
+     *
+     * @param jsonQuery A stringified JSON object with the "feature", the "query" and optionally "maxResults"
+     * @return A stringified JSON object with the matching documents and the note IDs of each match
+     */
+    std::string SearchFeatureIndex(const std::string &jsonQuery);
+
     /**
      * Return array of IDs of elements being currently played.
      *
@@ -565,6 +745,17 @@ public:
      */
     std::string GetElementsAtTime(int millisec);
 
+    /**
+     * Return the IDs of the elements with a facsimile zone at a point or within a rectangle.
+     *
+     * This works only with a document rendered from its facsimile (see the useFacsimile option).
+     *
+     * @param jsonOptions A stringified JSON object with the point (x, y) or the rectangle (ulx, uly, lrx, lry) in
+     * facsimile coordinates, and optionally the names of the elements to look for (e.g., "types": ["staff", "nc"])
+     * @return A stringified JSON object with the IDs of the elements by element name
+     */
+    std::string GetElementsAtPosition(const std::string &jsonOptions);
+
     /**
      * Return the page on which the element is the ID (\@xml:id) is rendered
      *
@@ -645,8 +836,13 @@ public:
      * This can be called once the rendering option were changed, for example with a new page (sceen) height or a new
      * zoom level.
      *
+     * Only the layout stages invalidated by the options changed since the last layout are redone (see LayoutStage).
+     * For example, changing only the page height casts off the pages again without redoing the layout of the systems,
+     * and changing only SVG output options does not redo anything.
+     *
      * @param jsonOptions A stringified JSON object with the action options
-     * resetCache: true or false; true by default;
+     * resetCache: true or false for redoing the entire layout with or without resetting the cached horizontal layout;
+     * not set by default;
      */
     void RedoLayout(const std::string &jsonOptions = "");
 
@@ -658,6 +854,16 @@ public:
      */
     void RedoPagePitchPosLayout();
 
+    /**
+     * Continue the layout when the progressiveLayout option is enabled.
+     *
+     * Pages are laid out only as far as needed for rendering them. This can be called, for example when the
+     * application is idle, for laying out the remaining pages. It does nothing when the layout is completed.
+     *
+     * @param pageNo The page number (1-based) up to which the layout is continued; all pages with 0
+     */
+    void ContinueLayout(int pageNo = 0);
+
     ///@}
 
     //------------------------------------------------//
@@ -703,6 +909,29 @@ public:
      */
     const char *GetCString();
 
+    /**
+     * Move the data to the binary internal buffer.
+     *
+     * @ingroup nodoc
+     */
+    void SetCBuffer(std::vector<uint8_t> &&data);
+
+    /**
+     * Return the content of the binary internal buffer.
+     *
+     * Return NULL if the buffer is empty.
+     *
+     * @ingroup nodoc
+     */
+    const uint8_t *GetCBuffer() const;
+
+    /**
+     * Return the size of the binary internal buffer.
+     *
+     * @ingroup nodoc
+     */
+    int GetCBufferSize() const { return (int)m_cBuffer.size(); }
+
     /**
      * Write the Humdrum buffer to the outputstream.
      *
@@ -751,14 +980,6 @@ public:
      */
     int GetOutputTo() { return m_outputTo; }
 
-    /**
-     * Setting the global locale.
-     */
-    ///@{
-    void SetLocale();
-    void ResetLocale();
-    ///@}
-
     /**
      * Measuring runtime.
      *
@@ -806,6 +1027,15 @@ private:
      */
     std::string GetOptions(bool defaultValues) const;
 
+    /**
+     * @name Methods for tracking the layout stages invalidated since the last layout
+     * The values of the options are stored when the layout is done and compared when it is redone.
+     */
+    ///@{
+    void ResetLayoutStages();
+    int GetInvalidatedLayoutStages() const;
+    ///@}
+
 public:
     //
 private:
@@ -817,25 +1047,42 @@ private:
 
     Options *m_options;
 
-    std::optional<std::locale> m_previousLocale;
+    /** The option values and the scale of the current layout */
+    std::map<std::string, std::string> m_layoutOptionValues;
+    int m_layoutScale;
+    /** The layout stages invalidated by other changes than options (e.g., editing or changing the font) */
+    int m_layoutStages;
 
     /**
      * The C buffer string.
      */
     char *m_cString;
 
+    /**
+     * The Humdrum buffer string.
+     */
+    char *m_humdrumBuffer;
+
+    /**
+     * The binary buffer for the C wrapper
+     */
+    std::vector<uint8_t> m_cBuffer;
+
     EditorToolkit *m_editorToolkit;
 
+    /** The feature index, created when first used */
+    FeatureIndex *m_featureIndex;
+
+    /** The toolkits rendering incipits, created when first used */
+    std::vector<Toolkit *> m_incipitToolkits;
+
+    /** The MEI of the document when the edit transaction was started */
+    std::string m_editUndoLog;
+
 #ifndef NO_RUNTIME
     /** Measuring runtime */
     RuntimeClock *m_runtimeClock;
 #endif
-
-    //----------------//
-    // Static members //
-    //----------------//
-
-    static char *m_humdrumBuffer;
 };
 
 } // namespace vrv
@@ -27,7 +27,8 @@ enum FileFormat {
     ESAC,
     MIDI,
     TIMEMAP,
-    EXPANSIONMAP
+    EXPANSIONMAP,
+    PNG
 };
 
 enum { LOG_OFF = 0, LOG_ERROR, LOG_WARNING, LOG_INFO, LOG_DEBUG };
@@ -50,6 +51,8 @@ void SetDefaultResourcePath(const std::string &path);
 
 void EnableLog(LogLevel level);
 void EnableLogToBuffer(bool value);
+// The maximum number of distinct messages kept in the log buffer of each thread (10000 by default)
+void SetLogBufferMaxSize(int size);
 
 } // namespace vrv
 
@@ -139,6 +139,7 @@ protected:
      * Filter the flat list and keep only Note elements.
      */
     void FilterList(ListOfConstObjects &childList) const override;
+    bool IncludesDrawingParts() const override { return false; }
 
 private:
     //
@@ -8,6 +8,7 @@
 #ifndef __VRV_H__
 #define __VRV_H__
 
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
@@ -49,10 +50,108 @@ void LogError(const char *fmt, ...);
 void LogInfo(const char *fmt, ...);
 void LogWarning(const char *fmt, ...);
 
+//----------------------------------------------------------------------------
+// LogBuffer
+//----------------------------------------------------------------------------
+
+/**
+ * This class stores the messages when logging to a buffer.
+ * A message logged several times is stored once with the number of times it was logged.
+ * The number of distinct messages is limited (see SetLogBufferMaxSize) and the messages logged once the
+ * buffer is full are only counted.
+ */
+class LogBuffer {
+public:
+    struct Entry {
+        std::string m_message;
+        LogLevel m_level;
+        int m_count;
+    };
+
+    /**
+     * Add a message, or increase its count if it is already in the buffer
+     */
+    void Add(const std::string &message, LogLevel level);
+
+    /**
+     * Check if a message is in the buffer
+     */
+    bool Contains(const std::string &message) const { return m_index.contains(message); }
+
+    /**
+     * Remove all the messages
+     */
+    void Clear();
+
+    /**
+     * Getters for the messages in the order they were first logged and the number of messages dropped
+     */
+    ///@{
+    const std::vector<Entry> &GetEntries() const { return m_entries; }
+    int GetDroppedCount() const { return m_droppedCount; }
+    ///@}
+
+private:
+    // The messages in the order they were first logged
+    std::vector<Entry> m_entries;
+    // The position of each message in the entries
+    std::unordered_map<std::string, int> m_index;
+    // The number of messages not stored because the buffer was full
+    int m_droppedCount = 0;
+};
+
+//----------------------------------------------------------------------------
+// LogCapture
+//----------------------------------------------------------------------------
+
 /**
- * Member and functions specific to logging that uses a vector of string to buffer the logs.
+ * This class captures the messages logged by a thread between Start and Stop.
+ * This is used by worker threads, for the messages to be logged afterwards in a deterministic order (see Replay).
  */
-extern std::vector<std::string> logBuffer;
+class LogCapture {
+public:
+    /**
+     * @name Constructors, destructors
+     */
+    ///@{
+    LogCapture() = default;
+    ~LogCapture() = default;
+    ///@}
+
+    /**
+     * Start and stop capturing the messages logged by the calling thread.
+     * Both have to be called by the same thread.
+     */
+    ///@{
+    void Start();
+    void Stop();
+    ///@}
+
+    /**
+     * Log the captured messages on the calling thread
+     */
+    void Replay() const;
+
+    /**
+     * Add a message to the capture of the calling thread, if any, and return true if it was captured
+     */
+    static bool Capture(const std::string &message, LogLevel level);
+
+private:
+    // The messages in the order they were logged
+    std::vector<std::pair<std::string, LogLevel>> m_messages;
+    // The capture of the thread when it was started
+    LogCapture *m_previous = NULL;
+    // The capture of each thread
+    static thread_local LogCapture *s_current;
+};
+
+/**
+ * Member and functions specific to logging that uses a buffer.
+ * The buffer is thread local, each thread logging to its own buffer.
+ */
+extern thread_local LogBuffer logBuffer;
+extern std::atomic<int> logBufferMaxSize;
 bool LogBufferContains(const std::string &s);
 void LogString(std::string message, LogLevel level);
 
@@ -99,11 +198,19 @@ std::u32string UTF8to32(const std::string &in);
 /**
  * Format a string using vsnprintf.
  * The maximum length is giving by STRING_FORMAT_MAX_LEN
+ * Numbers are always formatted with the C locale, whatever the locale of the process is.
  */
 std::string StringFormat(const char *fmt, ...);
 // This is the implementation callable with variable arguments
 std::string StringFormatVariable(const char *format, va_list arg);
 
+/**
+ * Convert a string to a double (as atof) with the C locale, whatever the locale of the process is.
+ */
+double StringToDouble(const std::string &value);
+// This is the implementation returning the end of the number (as strtod)
+double StringToDouble(const char *value, char **end);
+
 /**
  * Return a formatted version (####.####.####) of the file version.
  * This can be used for comparing if the file version is < or >
@@ -126,6 +233,12 @@ std::string GetVersion();
  */
 std::string BaseEncodeInt(uint32_t value, uint8_t base);
 
+/**
+ * Decode a string encoded with BaseEncodeInt.
+ * Return false if the string is not the encoding of a value (invalid character, leading zero or overflow).
+ */
+bool BaseDecodeInt(const std::string &encoded, uint8_t base, uint32_t &value);
+
 /**
  * Convert string from camelCase.
  */
@@ -139,8 +252,8 @@ std::string ToCamelCase(const std::string &s);
 /**
  *
  */
-extern LogLevel logLevel;
-extern bool loggingToBuffer;
+extern std::atomic<LogLevel> logLevel;
+extern std::atomic<bool> loggingToBuffer;
 
 /**
  * Functions for logging in milliseconds the elapsed time of an
@@ -153,7 +266,7 @@ extern bool loggingToBuffer;
  * ... Do something
  * LogElapsedTimeEnd("name of the operation");
  */
-extern struct timeval start;
+extern thread_local struct timeval start;
 void LogElapsedTimeStart();
 void LogElapsedTimeEnd(const char *msg = "unspecified operation");
 
@@ -14,6 +14,7 @@
 #include <map>
 #include <set>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -272,6 +273,8 @@ enum ClassId : uint16_t {
     //
     BBOX_DEVICE_CONTEXT,
     SVG_DEVICE_CONTEXT,
+    DISPLAYLIST_DEVICE_CONTEXT,
+    RASTER_DEVICE_CONTEXT,
     CUSTOM_DEVICE_CONTEXT,
     //
     UNSPECIFIED
@@ -334,9 +337,9 @@ typedef std::vector<Object *> ArrayOfObjects;
 
 typedef std::vector<const Object *> ArrayOfConstObjects;
 
-typedef std::list<Object *> ListOfObjects;
+typedef std::vector<Object *> ListOfObjects;
 
-typedef std::list<const Object *> ListOfConstObjects;
+typedef std::vector<const Object *> ListOfConstObjects;
 
 typedef std::vector<Note *> ChordNoteGroup;
 
@@ -352,7 +355,7 @@ typedef std::multimap<std::string, LinkingInterface *> MapOfLinkingInterfaceIDPa
 
 typedef std::map<std::string, Note *> MapOfNoteIDPairs;
 
-typedef std::vector<std::pair<PlistInterface *, std::string>> ArrayOfPlistInterfaceIDPairs;
+typedef std::unordered_multimap<std::string, PlistInterface *> MapOfPlistInterfaceIDPairs;
 
 typedef std::vector<CurveSpannedElement *> ArrayOfCurveSpannedElements;
 
@@ -555,6 +558,8 @@ enum SMuFLGlyphAnchor {
     SMUFL_cutOutSW
 };
 
+#define SMUFL_ANCHOR_COUNT 6
+
 //----------------------------------------------------------------------------
 // Spanning types for control events
 //----------------------------------------------------------------------------
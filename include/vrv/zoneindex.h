@@ -0,0 +1,160 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        zoneindex.h
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_ZONEINDEX_H__
+#define __VRV_ZONEINDEX_H__
+
+#include <map>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "vrvdef.h"
+
+namespace vrv {
+
+class Object;
+class Zone;
+
+/** The maximum number of children of a node of the zone index */
+#define ZONEINDEX_NODE_SIZE 16
+
+//----------------------------------------------------------------------------
+// ZoneIndexEntry
+//----------------------------------------------------------------------------
+
+/**
+ * An element with its zone in the zone index.
+ * The bounding box includes the rotation of the zone.
+ */
+struct ZoneIndexEntry {
+    int m_ulx;
+    int m_uly;
+    int m_lrx;
+    int m_lry;
+    Object *m_object;
+    const Zone *m_zone;
+    /** The position of the element in the document, for returning the elements in the document order */
+    int m_order;
+};
+
+//----------------------------------------------------------------------------
+// ZoneIndexNode
+//----------------------------------------------------------------------------
+
+/**
+ * A node of the zone index with its bounding box and the range of its children.
+ * The children are entries for a leaf and nodes of the level below otherwise.
+ */
+struct ZoneIndexNode {
+    int m_ulx;
+    int m_uly;
+    int m_lrx;
+    int m_lry;
+    int m_first;
+    int m_count;
+    bool m_isLeaf;
+};
+
+//----------------------------------------------------------------------------
+// ZoneIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class implements a spatial index (an R-tree) of the elements of a facsimile document with a zone.
+ * There is one tree for each class of element (e.g., staff, syllable, nc, clef, custos). The trees are packed with
+ * the sort-tile-recursive algorithm when the index is built. They are not updated when the elements or the zones
+ * are edited, and the index has to be reset (see Doc::ResetZoneIndex) before it is built again.
+ *
+ * Distances and hits take the rotation of the zones into account (as for staves) within the horizontal extent of
+ * the zones.
+ */
+class ZoneIndex {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    ZoneIndex();
+    virtual ~ZoneIndex();
+    ///@}
+
+    /**
+     * Build the index for all the elements with a zone in the object (e.g., the document).
+     */
+    void Build(Object *root);
+
+    /**
+     * Clear the index.
+     */
+    void Reset();
+
+    /**
+     * Return true if the index has been built and not reset since then.
+     */
+    bool IsBuilt() const { return m_isBuilt; }
+
+    /**
+     * Return the elements of the given classes (all of them if empty) with a zone containing the point.
+     * The elements are returned in the document order.
+     */
+    ListOfObjects FindAtPoint(int x, int y, const std::vector<ClassId> &classIds = {}) const;
+
+    /**
+     * Return the elements of the given classes (all of them if empty) with a zone intersecting the rectangle.
+     * The elements are returned in the document order.
+     */
+    ListOfObjects FindInRect(int ulx, int uly, int lrx, int lry, const std::vector<ClassId> &classIds = {}) const;
+
+    /**
+     * Return the element of the given class with the zone closest to the point.
+     * The first element in the document order is returned if several are at the same distance.
+     */
+    Object *FindClosest(int x, int y, ClassId classId) const;
+
+    /**
+     * Return the distance between a point and a zone, taking its rotation into account.
+     */
+    static double GetDistance(const Zone *zone, int x, int y);
+
+private:
+    /**
+     * One R-tree with the entries and the nodes, the root being the last node.
+     */
+    struct Tree {
+        std::vector<ZoneIndexEntry> m_entries;
+        std::vector<ZoneIndexNode> m_nodes;
+    };
+
+    /**
+     * Pack the entries of a tree and build its nodes.
+     */
+    void BuildTree(Tree &tree);
+
+    /**
+     * Add the entries of a tree intersecting the rectangle to the list.
+     */
+    void FindInTree(const Tree &tree, int ulx, int uly, int lrx, int lry, std::vector<const ZoneIndexEntry *> &entries,
+        bool exactHit) const;
+
+    /**
+     * Return the distance between a point and a bounding box.
+     */
+    static double GetBoxDistance(int ulx, int uly, int lrx, int lry, int x, int y);
+
+public:
+    //
+private:
+    /** The trees by class of element */
+    std::map<ClassId, Tree> m_trees;
+    /** The flag indicating that the index is built */
+    bool m_isBuilt;
+};
+
+} // namespace vrv
+
+#endif // __VRV_ZONEINDEX_H__
@@ -49,7 +49,7 @@ std::string Att::VUToStr(data_VU data) const
 
 double Att::StrToDbl(const std::string &value) const
 {
-    return atof(value.c_str());
+    return StringToDouble(value);
 }
 
 int Att::StrToInt(const std::string &value) const
@@ -64,7 +64,7 @@ data_VU Att::StrToVU(const std::string &value, bool logWarning) const
         if (logWarning && !value.empty()) LogWarning("Unsupported virtual unit value '%s'", value.c_str());
         return MEI_UNSET;
     }
-    return atof(value.substr(0, value.find("vu")).c_str());
+    return StringToDouble(value.substr(0, value.find("vu")));
 }
 
 // Converters for writing and reading
@@ -318,7 +318,7 @@ data_FONTSIZENUMERIC Att::StrToFontsizenumeric(const std::string &value, bool lo
         if (logWarning && !value.empty()) LogWarning("Unsupported data.FONTSIZENUMERIC '%s'", value.c_str());
         return MEI_UNSET;
     }
-    return atof(value.substr(0, value.find("pt")).c_str());
+    return StringToDouble(value.substr(0, value.find("pt")));
 }
 
 std::string Att::KeysignatureToStr(data_KEYSIGNATURE data) const
@@ -382,10 +382,10 @@ data_MEASUREBEAT Att::StrToMeasurebeat(std::string value, bool) const
     int plus = (int)value.find_last_of('+');
     if (m != -1) measure = atoi(value.substr(0, m).c_str());
     if (plus != -1) {
-        timePoint = atof(value.substr(plus).c_str());
+        timePoint = StringToDouble(value.substr(plus));
     }
     else {
-        timePoint = atof(value.c_str());
+        timePoint = StringToDouble(value);
     }
     return { measure, timePoint };
 }
@@ -412,7 +412,7 @@ data_MEASUREMENTSIGNED Att::StrToMeasurementsigned(const std::string &value, boo
         data.SetPx(atoi(value.substr(0, value.find("px")).c_str()) * DEFINITION_FACTOR);
     }
     else {
-        data.SetVu(atof(value.c_str()));
+        data.SetVu(StringToDouble(value));
     }
 
     if (logWarning && !value.empty() && !data.HasValue())
@@ -622,7 +622,7 @@ data_PERCENT Att::StrToPercent(const std::string &value, bool logWarning) const
         if (logWarning) LogWarning("Unsupported data.PERCENT '%s'", value.c_str());
         return 0;
     }
-    return atof(value.substr(0, value.find("%")).c_str());
+    return StringToDouble(value.substr(0, value.find("%")));
 }
 
 std::string Att::PercentLimitedToStr(data_PERCENT_LIMITED data) const
@@ -637,7 +637,7 @@ data_PERCENT_LIMITED Att::StrToPercentLimited(const std::string &value, bool log
         if (logWarning) LogWarning("Unsupported data.PERCENT.LIMITED '%s'", value.c_str());
         return 0;
     }
-    return atof(value.substr(0, value.find("%")).c_str());
+    return StringToDouble(value.substr(0, value.find("%")));
 }
 
 std::string Att::PercentLimitedSignedToStr(data_PERCENT_LIMITED_SIGNED data) const
@@ -652,7 +652,7 @@ data_PERCENT_LIMITED_SIGNED Att::StrToPercentLimitedSigned(const std::string &va
         if (logWarning) LogWarning("Unsupported data.PERCENT.LIMITED.SIGNEd '%s'", value.c_str());
         return 0;
     }
-    return atof(value.substr(0, value.find("%")).c_str());
+    return StringToDouble(value.substr(0, value.find("%")));
 }
 
 std::string Att::PitchnameToStr(data_PITCHNAME data) const
@@ -94,7 +94,7 @@ FunctorCode AdjustBeamsFunctor::VisitBeamEnd(Beam *beam)
 
     if (beam->m_drawingPlace == BEAMPLACE_mixed) return FUNCTOR_CONTINUE;
 
-    Layer *parentLayer = vrv_cast<Layer *>(beam->GetFirstAncestor(LAYER));
+    Layer *parentLayer = beam->GetAncestorLayer();
     if (parentLayer) {
         // find elements on the other layers for the duration of the current beam
         auto otherLayersElements = parentLayer->GetLayerElementsForTimeSpanOf(beam, true);
@@ -203,7 +203,7 @@ FunctorCode AdjustBeamsFunctor::VisitFTremEnd(FTrem *fTrem)
 
     if (fTrem->m_drawingPlace == BEAMPLACE_mixed) return FUNCTOR_CONTINUE;
 
-    Layer *parentLayer = vrv_cast<Layer *>(fTrem->GetFirstAncestor(LAYER));
+    Layer *parentLayer = fTrem->GetAncestorLayer();
     if (parentLayer) {
         // find elements on the other layers for the duration of the current beam
         auto otherLayersElements = parentLayer->GetLayerElementsForTimeSpanOf(fTrem, true);
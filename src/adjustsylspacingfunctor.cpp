@@ -12,8 +12,11 @@
 #include "doc.h"
 #include "label.h"
 #include "labelabbr.h"
+#include "layer.h"
+#include "page.h"
 #include "staff.h"
 #include "syl.h"
+#include "system.h"
 #include "verse.h"
 
 //----------------------------------------------------------------------------
@@ -26,6 +29,8 @@ namespace vrv {
 
 AdjustSylSpacingFunctor::AdjustSylSpacingFunctor(Doc *doc) : DocFunctor(doc)
 {
+    m_currentStaffN = VRV_UNSET;
+    m_currentLayerN = VRV_UNSET;
     m_previousVerse = NULL;
     m_lastSyl = NULL;
     m_previousMeasure = NULL;
@@ -34,7 +39,84 @@ AdjustSylSpacingFunctor::AdjustSylSpacingFunctor(Doc *doc) : DocFunctor(doc)
     m_staffSize = 100;
 }
 
+FunctorCode AdjustSylSpacingFunctor::VisitLayer(Layer *layer)
+{
+    m_currentLayerN = layer->GetN();
+
+    return FUNCTOR_CONTINUE;
+}
+
 FunctorCode AdjustSylSpacingFunctor::VisitMeasureEnd(Measure *measure)
+{
+    m_events.push_back({ EventType::MeasureEnd, measure, {} });
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode AdjustSylSpacingFunctor::VisitPageEnd(Page *page)
+{
+    // Process the events for each staff / layer / verse @n in turn, as if the page was traversed for each of them
+    for (const std::tuple<int, int, int> &verseKey : m_verseKeys) {
+        m_overlappingSyl.clear();
+        m_previousVerse = NULL;
+        m_lastSyl = NULL;
+        m_previousMeasure = NULL;
+        m_currentLabelAbbr = NULL;
+        m_freeSpace = 0;
+        m_staffSize = 100;
+        for (const Event &event : m_events) {
+            switch (event.m_type) {
+                case EventType::Verse:
+                    if (event.m_key == verseKey) this->AdjustVerse(vrv_cast<Verse *>(event.m_object));
+                    break;
+                case EventType::Staff:
+                    if (std::get<0>(event.m_key) == std::get<0>(verseKey)) {
+                        this->AdjustStaff(vrv_cast<Staff *>(event.m_object));
+                    }
+                    break;
+                case EventType::MeasureEnd: this->AdjustMeasureEnd(vrv_cast<Measure *>(event.m_object)); break;
+                case EventType::System: this->AdjustSystem(); break;
+                case EventType::SystemEnd: this->AdjustSystemEnd(); break;
+            }
+        }
+    }
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode AdjustSylSpacingFunctor::VisitStaff(Staff *staff)
+{
+    m_currentStaffN = staff->GetN();
+    m_events.push_back({ EventType::Staff, staff, { m_currentStaffN, VRV_UNSET, VRV_UNSET } });
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode AdjustSylSpacingFunctor::VisitSystem(System *system)
+{
+    m_events.push_back({ EventType::System, system, {} });
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode AdjustSylSpacingFunctor::VisitSystemEnd(System *system)
+{
+    m_events.push_back({ EventType::SystemEnd, system, {} });
+
+    return FUNCTOR_CONTINUE;
+}
+
+FunctorCode AdjustSylSpacingFunctor::VisitVerse(Verse *verse)
+{
+    const std::tuple<int, int, int> verseKey = { m_currentStaffN, m_currentLayerN, verse->GetN() };
+    m_events.push_back({ EventType::Verse, verse, verseKey });
+    m_verseKeys.insert(verseKey);
+
+    // Nothing to record within the verse
+    return FUNCTOR_SIBLINGS;
+}
+
+void AdjustSylSpacingFunctor::AdjustMeasureEnd(Measure *measure)
 {
     // At the end of the measure - pass it along for overlapping verses
     m_previousMeasure = measure;
@@ -42,19 +124,15 @@ FunctorCode AdjustSylSpacingFunctor::VisitMeasureEnd(Measure *measure)
     // Adjust the position of the alignment according to what we have collected for this verse
     measure->m_measureAligner.AdjustProportionally(m_overlappingSyl);
     m_overlappingSyl.clear();
-
-    return FUNCTOR_CONTINUE;
 }
 
-FunctorCode AdjustSylSpacingFunctor::VisitStaff(Staff *staff)
+void AdjustSylSpacingFunctor::AdjustStaff(Staff *staff)
 {
     // Set the staff size for this pass
     m_staffSize = staff->m_drawingStaffSize;
-
-    return FUNCTOR_CONTINUE;
 }
 
-FunctorCode AdjustSylSpacingFunctor::VisitSystem(System *system)
+void AdjustSylSpacingFunctor::AdjustSystem()
 {
     // reset it
     m_overlappingSyl.clear();
@@ -62,14 +140,12 @@ FunctorCode AdjustSylSpacingFunctor::VisitSystem(System *system)
     m_previousMeasure = NULL;
     m_freeSpace = 0;
     m_staffSize = 100;
-
-    return FUNCTOR_CONTINUE;
 }
 
-FunctorCode AdjustSylSpacingFunctor::VisitSystemEnd(System *system)
+void AdjustSylSpacingFunctor::AdjustSystemEnd()
 {
     if (!m_previousMeasure) {
-        return FUNCTOR_CONTINUE;
+        return;
     }
 
     // Here we also need to handle the last syl of the measure - we check the alignment with the right barline
@@ -86,11 +162,9 @@ FunctorCode AdjustSylSpacingFunctor::VisitSystemEnd(System *system)
     // Adjust the position of the alignment according to what we have collected for this verse
     m_previousMeasure->m_measureAligner.AdjustProportionally(m_overlappingSyl);
     m_overlappingSyl.clear();
-
-    return FUNCTOR_CONTINUE;
 }
 
-FunctorCode AdjustSylSpacingFunctor::VisitVerse(Verse *verse)
+void AdjustSylSpacingFunctor::AdjustVerse(Verse *verse)
 {
     /****** find label / labelAbbr */
 
@@ -133,7 +207,7 @@ FunctorCode AdjustSylSpacingFunctor::VisitVerse(Verse *verse)
         }
     }
 
-    if (syls.empty()) return FUNCTOR_CONTINUE;
+    if (syls.empty()) return;
 
     Syl *firstSyl = vrv_cast<Syl *>(syls.front());
     assert(firstSyl);
@@ -154,7 +228,7 @@ FunctorCode AdjustSylSpacingFunctor::VisitVerse(Verse *verse)
         // No free space because we never move the first one back
         m_freeSpace = 0;
         m_previousMeasure = NULL;
-        return FUNCTOR_CONTINUE;
+        return;
     }
 
     int xShift = 0;
@@ -197,8 +271,6 @@ FunctorCode AdjustSylSpacingFunctor::VisitVerse(Verse *verse)
     m_lastSyl = lastSyl;
     m_freeSpace = nextFreeSpace;
     m_previousMeasure = NULL;
-
-    return FUNCTOR_CONTINUE;
 }
 
 } // namespace vrv
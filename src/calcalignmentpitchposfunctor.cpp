@@ -38,7 +38,7 @@ FunctorCode CalcAlignmentPitchPosFunctor::VisitLayerElement(LayerElement *layerE
 
     LayerElement *layerElementY = layerElement;
     Staff *staffY = layerElement->GetAncestorStaff();
-    Layer *layerY = vrv_cast<Layer *>(layerElement->GetFirstAncestor(LAYER));
+    Layer *layerY = layerElement->GetAncestorLayer();
     assert(layerY);
 
     PitchInterface *pitchInterface = layerElement->GetPitchInterface();
@@ -293,7 +293,7 @@ FunctorCode CalcAlignmentPitchPosFunctor::VisitLayerElement(LayerElement *layerE
                 }
             }
 
-            Layer *layer = vrv_cast<Layer *>(layerElement->GetFirstAncestor(LAYER));
+            Layer *layer = layerElement->GetAncestorLayer();
             if (rest) {
                 loc = rest->GetOptimalLayerLocation(staff, layer, loc);
             }
@@ -40,7 +40,7 @@ FunctorCode CalcArticFunctor::VisitArtic(Artic *artic)
 
     /************** placement **************/
 
-    Layer *layer = vrv_cast<Layer *>(artic->GetFirstAncestor(LAYER));
+    Layer *layer = artic->GetAncestorLayer();
     assert(layer);
 
     if (m_parent->m_crossLayer) {
@@ -102,7 +102,7 @@ FunctorCode CalcArticFunctor::VisitChord(Chord *chord)
     m_stemDir = chord->GetDrawingStemDir();
 
     Staff *staff = chord->GetAncestorStaff();
-    Layer *layer = vrv_cast<Layer *>(chord->GetFirstAncestor(LAYER));
+    Layer *layer = chord->GetAncestorLayer();
     assert(layer);
 
     m_staffAbove = staff;
@@ -145,7 +145,7 @@ FunctorCode CalcArticFunctor::VisitNote(Note *note)
     m_stemDir = note->GetDrawingStemDir();
 
     Staff *staff = note->GetAncestorStaff();
-    Layer *layer = vrv_cast<Layer *>(note->GetFirstAncestor(LAYER));
+    Layer *layer = note->GetAncestorLayer();
     assert(layer);
 
     m_staffAbove = staff;
@@ -50,7 +50,7 @@ FunctorCode CalcStemFunctor::VisitBeam(Beam *beam)
         return FUNCTOR_CONTINUE;
     }
 
-    Layer *layer = vrv_cast<Layer *>(beam->GetFirstAncestor(LAYER));
+    Layer *layer = beam->GetAncestorLayer();
     assert(layer);
     Staff *staff = vrv_cast<Staff *>(layer->GetFirstAncestor(STAFF));
     assert(staff);
@@ -81,9 +81,9 @@ FunctorCode CalcStemFunctor::VisitBeamSpan(BeamSpan *beamSpan)
 {
     if (!beamSpan->GetStart() || !beamSpan->GetEnd() || beamSpan->GetBeamedElements().empty()) return FUNCTOR_CONTINUE;
 
-    Layer *layer = vrv_cast<Layer *>(beamSpan->GetStart()->GetFirstAncestor(LAYER));
+    Layer *layer = beamSpan->GetStart()->GetAncestorLayer();
     Staff *staff = vrv_cast<Staff *>(beamSpan->GetStart()->GetFirstAncestor(STAFF));
-    Measure *measure = vrv_cast<Measure *>(beamSpan->GetStart()->GetFirstAncestor(MEASURE));
+    Measure *measure = beamSpan->GetStart()->GetAncestorMeasure();
 
     beamSpan->InitCoords(beamSpan->GetBeamedElements(), staff, beamSpan->GetPlace());
 
@@ -119,7 +119,7 @@ FunctorCode CalcStemFunctor::VisitChord(Chord *chord)
     Stem *stem = chord->GetDrawingStem();
     assert(stem);
     Staff *staff = chord->GetAncestorStaff();
-    Layer *layer = vrv_cast<Layer *>(chord->GetFirstAncestor(LAYER));
+    Layer *layer = chord->GetAncestorLayer();
     assert(layer);
 
     if (chord->m_crossStaff) {
@@ -181,7 +181,7 @@ FunctorCode CalcStemFunctor::VisitFTrem(FTrem *fTrem)
         return FUNCTOR_CONTINUE;
     }
 
-    Layer *layer = vrv_cast<Layer *>(fTrem->GetFirstAncestor(LAYER));
+    Layer *layer = fTrem->GetAncestorLayer();
     assert(layer);
     Staff *staff = vrv_cast<Staff *>(layer->GetFirstAncestor(STAFF));
     assert(staff);
@@ -234,7 +234,7 @@ FunctorCode CalcStemFunctor::VisitNote(Note *note)
     Stem *stem = note->GetDrawingStem();
     assert(stem);
     Staff *staff = note->GetAncestorStaff();
-    Layer *layer = vrv_cast<Layer *>(note->GetFirstAncestor(LAYER));
+    Layer *layer = note->GetAncestorLayer();
     assert(layer);
 
     if (note->m_crossStaff) {
@@ -504,7 +504,7 @@ FunctorCode CalcStemFunctor::VisitTabDurSym(TabDurSym *tabDurSym)
     // Cache to avoid further lookup
     m_staff = tabDurSym->GetAncestorStaff();
     assert(m_staff);
-    m_layer = vrv_cast<Layer *>(tabDurSym->GetFirstAncestor(LAYER));
+    m_layer = tabDurSym->GetAncestorLayer();
     assert(m_layer);
     m_interface = tabDurSym;
     // Grace and stem sameas not supported in tablature
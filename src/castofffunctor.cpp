@@ -350,10 +350,13 @@ FunctorCode CastOffPagesFunctor::VisitSystem(System *system)
         currentShift += m_pgHead2Height + m_pgFoot2Height;
     }
 
+    // Use the position stored when the system was laid out since the drawing one changes when a page is laid out
+    const int systemYRel = system->m_castOffYRel + m_pageHeight;
+
     const int systemMaxPerPage = m_doc->GetOptions()->m_systemMaxPerPage.GetValue();
     const int systemChildCount = m_currentPage->GetChildCount(SYSTEM);
     if ((systemMaxPerPage && (systemMaxPerPage == systemChildCount))
-        || ((systemChildCount > 0) && (system->GetDrawingYRel() - system->GetHeight() - currentShift < 0))) {
+        || ((systemChildCount > 0) && (systemYRel - system->m_castOffHeight - currentShift < 0))) {
         // If this is the last system in the list, it doesn't fit the page and it's a leftover system (has just one
         // measure) => add the system content to the previous system
         Object *nextSystem = m_contentPage->GetNext(system, SYSTEM);
@@ -371,7 +374,7 @@ FunctorCode CastOffPagesFunctor::VisitSystem(System *system)
         m_pgHeadHeight = VRV_UNSET;
         assert(m_doc->GetPages());
         m_doc->GetPages()->AddChild(m_currentPage);
-        m_shift = system->GetDrawingYRel() - m_pageHeight;
+        m_shift = systemYRel - m_pageHeight;
     }
 
     // First add all pending objects
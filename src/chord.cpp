@@ -213,7 +213,7 @@ void Chord::AddChild(Object *child)
     else {
         children.push_back(child);
     }
-    Modify();
+    this->ModifyFor(child);
 }
 
 void Chord::FilterList(ListOfConstObjects &childList) const
@@ -230,7 +230,7 @@ void Chord::FilterList(ListOfConstObjects &childList) const
         }
     }
 
-    childList.sort(DiatonicSort());
+    std::stable_sort(childList.begin(), childList.end(), DiatonicSort());
 }
 
 int Chord::PositionInChord(const Note *note) const
@@ -90,7 +90,7 @@ data_STAFFREL ControlElement::GetLayerPlace(data_STAFFREL defaultValue) const
     const LayerElement *start = interface->GetStart();
     if (!start || start->Is(TIMESTAMP_ATTR)) return defaultValue;
 
-    const Layer *layer = vrv_cast<const Layer *>(start->GetFirstAncestor(LAYER));
+    const Layer *layer = start->GetAncestorLayer();
     // We are only looking that the element cross-staff. We could use LayerElement::GetCrossStaff(Layer  *&)
     if (start->m_crossLayer) layer = start->m_crossLayer;
     assert(layer);
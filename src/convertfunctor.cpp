@@ -541,7 +541,7 @@ FunctorCode ConvertMarkupAnalyticalFunctor::VisitNote(Note *note)
     }
     assert(check);
 
-    Object *currentMeasure = note->GetFirstAncestor(MEASURE);
+    Object *currentMeasure = note->GetAncestorMeasure();
     assert(currentMeasure);
 
     std::vector<Note *>::iterator iter = m_currentNotes.begin();
@@ -0,0 +1,538 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        displaylistdevicecontext.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "displaylistdevicecontext.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <sstream>
+
+//----------------------------------------------------------------------------
+
+#include "atts_shared.h"
+#include "glyph.h"
+#include "object.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// DisplayListDeviceContext
+//----------------------------------------------------------------------------
+
+DisplayListDeviceContext::DisplayListDeviceContext() : DeviceContext(DISPLAYLIST_DEVICE_CONTEXT)
+{
+    m_originX = 0;
+    m_originY = 0;
+
+    m_hasFlushedPen = false;
+    m_hasFlushedBrush = false;
+
+    this->SetBrush(AxNONE, AxSOLID);
+    this->SetPen(AxNONE, 1, AxSOLID);
+
+    // Magic number and version
+    m_buffer = { 'V', 'R', 'D', 'L', DISPLAYLIST_VERSION };
+}
+
+DisplayListDeviceContext::~DisplayListDeviceContext() {}
+
+void DisplayListDeviceContext::WriteUInt(uint32_t value)
+{
+    while (value >= 0x80) {
+        m_buffer.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    m_buffer.push_back((uint8_t)value);
+}
+
+void DisplayListDeviceContext::WriteInt(int value)
+{
+    // zigzag encoding for keeping small negative values short
+    this->WriteUInt(((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+void DisplayListDeviceContext::WriteColor(int color)
+{
+    this->WriteUInt((color == AxNONE) ? 0 : (uint32_t)(color & 0xFFFFFF) + 1);
+}
+
+void DisplayListDeviceContext::WriteOpacity(float opacity)
+{
+    this->WriteByte((uint8_t)std::clamp((int)std::lround(opacity * 255.0), 0, 255));
+}
+
+void DisplayListDeviceContext::WritePoint(const Point &point)
+{
+    this->WriteInt(point.x - m_cursor.x);
+    this->WriteInt(point.y - m_cursor.y);
+    m_cursor = point;
+}
+
+uint32_t DisplayListDeviceContext::GetStringRef(const std::string &value)
+{
+    if (value.empty()) return 0;
+
+    auto iter = m_strings.find(value);
+    if (iter != m_strings.end()) return iter->second;
+
+    this->WriteOp(DL_DEFINE_STRING);
+    this->WriteUInt((uint32_t)value.size());
+    m_buffer.insert(m_buffer.end(), value.begin(), value.end());
+
+    const uint32_t ref = (uint32_t)m_strings.size() + 1;
+    m_strings[value] = ref;
+    return ref;
+}
+
+uint32_t DisplayListDeviceContext::GetGlyphRef(const Glyph *glyph)
+{
+    assert(glyph);
+
+    auto iter = m_glyphs.find(glyph);
+    if (iter != m_glyphs.end()) return iter->second;
+
+    // Extract the path data and the units from the glyph <symbol>
+    std::string pathData;
+    int units = glyph->GetUnitsPerEm() / 10;
+    pugi::xml_document glyphDoc;
+    glyphDoc.load_string(glyph->GetXML().c_str());
+    pugi::xml_node symbol = glyphDoc.first_child();
+    if (symbol.attribute("viewBox")) {
+        std::istringstream viewBox(symbol.attribute("viewBox").value());
+        int minX, minY;
+        viewBox >> minX >> minY >> units;
+    }
+    for (pugi::xml_node path : symbol.children("path")) {
+        if (!pathData.empty()) pathData += " ";
+        pathData += path.attribute("d").value();
+    }
+
+    const uint32_t fontRef = this->GetStringRef(glyph->GetFontName());
+    const uint32_t pathRef = this->GetStringRef(pathData);
+
+    this->WriteOp(DL_DEFINE_GLYPH);
+    this->WriteUInt((uint32_t)std::strtol(glyph->GetCodeStr().c_str(), NULL, 16));
+    this->WriteUInt(fontRef);
+    this->WriteUInt((uint32_t)units);
+    this->WriteUInt(pathRef);
+
+    const uint32_t ref = (uint32_t)m_glyphs.size() + 1;
+    m_glyphs[glyph] = ref;
+    return ref;
+}
+
+void DisplayListDeviceContext::FlushPenAndBrush()
+{
+    assert(!m_penStack.empty());
+    assert(!m_brushStack.empty());
+
+    const Pen &pen = m_penStack.top();
+    if (!m_hasFlushedPen || (pen.GetColor() != m_flushedPen.GetColor()) || (pen.GetWidth() != m_flushedPen.GetWidth())
+        || (pen.GetOpacity() != m_flushedPen.GetOpacity()) || (pen.GetDashLength() != m_flushedPen.GetDashLength())
+        || (pen.GetGapLength() != m_flushedPen.GetGapLength()) || (pen.GetLineCap() != m_flushedPen.GetLineCap())
+        || (pen.GetLineJoin() != m_flushedPen.GetLineJoin())) {
+        this->WriteOp(DL_SET_PEN);
+        this->WriteColor(pen.GetColor());
+        this->WriteUInt(std::max(0, pen.GetWidth()));
+        this->WriteOpacity(pen.GetOpacity());
+        this->WriteUInt(std::max(0, pen.GetDashLength()));
+        this->WriteUInt(std::max(0, pen.GetGapLength()));
+        this->WriteUInt(std::max(0, pen.GetLineCap()));
+        this->WriteUInt(std::max(0, pen.GetLineJoin()));
+        m_flushedPen = pen;
+        m_hasFlushedPen = true;
+    }
+
+    const Brush &brush = m_brushStack.top();
+    if (!m_hasFlushedBrush || (brush.GetColor() != m_flushedBrush.GetColor())
+        || (brush.GetOpacity() != m_flushedBrush.GetOpacity())) {
+        this->WriteOp(DL_SET_BRUSH);
+        this->WriteColor(brush.GetColor());
+        this->WriteOpacity(brush.GetOpacity());
+        m_flushedBrush = brush;
+        m_hasFlushedBrush = true;
+    }
+}
+
+void DisplayListDeviceContext::StartPath(uint8_t flags, int segmentCount, const Point &start)
+{
+    this->FlushPenAndBrush();
+
+    this->WriteOp(DL_PATH);
+    this->WriteByte(flags);
+    this->WriteUInt((uint32_t)segmentCount);
+    m_cursor = Point(0, 0);
+    this->WritePoint(start);
+}
+
+void DisplayListDeviceContext::WriteStartGroup(
+    const std::string &gClass, const std::string &gId, const std::string &color)
+{
+    // Strings need to be defined before the operation
+    const uint32_t classRef = this->GetStringRef(gClass);
+    const uint32_t idRef = this->GetStringRef(gId);
+    const uint32_t colorRef = this->GetStringRef(color);
+
+    this->WriteOp(DL_START_GROUP);
+    this->WriteUInt(classRef);
+    this->WriteUInt(idRef);
+    this->WriteUInt(colorRef);
+}
+
+void DisplayListDeviceContext::SetTextForeground(int color)
+{
+    m_brushStack.top().SetColor(color); // we use the brush color for text
+}
+
+void DisplayListDeviceContext::SetLogicalOrigin(int x, int y)
+{
+    m_originX = -x;
+    m_originY = -y;
+}
+
+Point DisplayListDeviceContext::GetLogicalOrigin()
+{
+    return Point(m_originX, m_originY);
+}
+
+void DisplayListDeviceContext::StartPage()
+{
+    this->WriteOp(DL_START_PAGE);
+    this->WriteUInt((uint32_t)std::max(0, this->GetWidth()));
+    this->WriteUInt((uint32_t)std::max(0, this->GetHeight()));
+    this->WriteUInt((uint32_t)std::max(0, this->GetContentHeight()));
+    this->WriteUInt((uint32_t)std::lround(this->GetUserScaleX() * 1000.0));
+    this->WriteInt(m_originX);
+    this->WriteInt(m_originY);
+}
+
+void DisplayListDeviceContext::EndPage()
+{
+    this->WriteOp(DL_END_PAGE);
+}
+
+void DisplayListDeviceContext::StartGraphic(
+    Object *object, const std::string &gClass, const std::string &gId, GraphicID graphicID, bool prepend)
+{
+    // Same class naming as in the SVG output - prepending is ignored since the display list is sequential
+    std::string gClassFull = object->GetClassName();
+    std::transform(gClassFull.begin(), gClassFull.begin() + 1, gClassFull.begin(), ::tolower);
+    if (graphicID != PRIMARY) {
+        gClassFull.append(" id-" + gId + ((graphicID == SPANNING) ? " spanning" : " symbol-ref"));
+    }
+    if (!gClass.empty()) {
+        gClassFull.append(" " + gClass);
+    }
+    if (object->HasAttClass(ATT_TYPED)) {
+        AttTyped *att = dynamic_cast<AttTyped *>(object);
+        assert(att);
+        if (att->HasType()) gClassFull.append(" " + att->GetType());
+    }
+
+    std::string color;
+    if (object->HasAttClass(ATT_COLOR)) {
+        AttColor *att = dynamic_cast<AttColor *>(object);
+        assert(att);
+        if (att->HasColor()) color = att->GetColor();
+    }
+
+    // As in the SVG output, SVG graphics have no ID because they might be duplicated
+    const bool hasId = (graphicID == PRIMARY) && !object->Is(SVG);
+    this->WriteStartGroup(gClassFull, (hasId) ? gId : "", color);
+}
+
+void DisplayListDeviceContext::EndGraphic(Object *object, View *view)
+{
+    this->WriteOp(DL_END_GROUP);
+}
+
+void DisplayListDeviceContext::StartCustomGraphic(const std::string &name, std::string gClass, std::string gId)
+{
+    this->WriteStartGroup((gClass.empty()) ? name : name + " " + gClass, gId, "");
+}
+
+void DisplayListDeviceContext::EndCustomGraphic()
+{
+    this->WriteOp(DL_END_GROUP);
+}
+
+void DisplayListDeviceContext::SetCustomGraphicColor(const std::string &color)
+{
+    const uint32_t colorRef = this->GetStringRef(color);
+    this->WriteOp(DL_GROUP_COLOR);
+    this->WriteUInt(colorRef);
+}
+
+void DisplayListDeviceContext::ResumeGraphic(Object *object, std::string gId)
+{
+    const uint32_t idRef = this->GetStringRef(gId);
+    this->WriteOp(DL_RESUME_GROUP);
+    this->WriteUInt(idRef);
+}
+
+void DisplayListDeviceContext::EndResumedGraphic(Object *object, View *view)
+{
+    this->WriteOp(DL_END_GROUP);
+}
+
+void DisplayListDeviceContext::RotateGraphic(Point const &orig, double angle)
+{
+    this->WriteOp(DL_ROTATE);
+    this->WriteInt(orig.x);
+    this->WriteInt(orig.y);
+    this->WriteInt((int)std::lround(angle * 1000.0));
+}
+
+void DisplayListDeviceContext::DrawQuadBezierPath(Point bezier[3])
+{
+    this->StartPath(DL_PATH_STROKE, 1, bezier[0]);
+    this->WriteOp(DL_PATH_QUAD_TO);
+    this->WritePoint(bezier[1]);
+    this->WritePoint(bezier[2]);
+}
+
+void DisplayListDeviceContext::DrawCubicBezierPath(Point bezier[4])
+{
+    this->StartPath(DL_PATH_STROKE, 1, bezier[0]);
+    this->WriteOp(DL_PATH_CUBIC_TO);
+    this->WritePoint(bezier[1]);
+    this->WritePoint(bezier[2]);
+    this->WritePoint(bezier[3]);
+}
+
+void DisplayListDeviceContext::DrawCubicBezierPathFilled(Point bezier1[4], Point bezier2[4])
+{
+    this->StartPath(DL_PATH_FILL | DL_PATH_STROKE | DL_PATH_CLOSE, 2, bezier1[0]);
+    this->WriteOp(DL_PATH_CUBIC_TO);
+    this->WritePoint(bezier1[1]);
+    this->WritePoint(bezier1[2]);
+    this->WritePoint(bezier1[3]);
+    this->WriteOp(DL_PATH_CUBIC_TO);
+    this->WritePoint(bezier2[2]);
+    this->WritePoint(bezier2[1]);
+    this->WritePoint(bezier2[0]);
+}
+
+void DisplayListDeviceContext::DrawCircle(int x, int y, int radius)
+{
+    this->DrawEllipse(x - radius, y - radius, 2 * radius, 2 * radius);
+}
+
+void DisplayListDeviceContext::DrawEllipse(int x, int y, int width, int height)
+{
+    this->FlushPenAndBrush();
+
+    this->WriteOp(DL_ELLIPSE);
+    this->WriteInt(x);
+    this->WriteInt(y);
+    this->WriteInt(width);
+    this->WriteInt(height);
+}
+
+void DisplayListDeviceContext::DrawEllipticArc(int x, int y, int width, int height, double start, double end)
+{
+    // Approximate the arc with line segments (one every 10 degrees)
+    const double rx = width / 2.0;
+    const double ry = height / 2.0;
+    const double xc = x + rx;
+    const double yc = y + ry;
+    if (end < start) end += 360.0;
+    const int segmentCount = std::max(1, (int)std::ceil((end - start) / 10.0));
+
+    this->StartPath(DL_PATH_FILL | DL_PATH_STROKE, segmentCount,
+        Point(xc + rx * cos(DegToRad(start)), yc - ry * sin(DegToRad(start))));
+    for (int i = 1; i <= segmentCount; ++i) {
+        const double angle = start + (end - start) * i / segmentCount;
+        this->WriteOp(DL_PATH_LINE_TO);
+        this->WritePoint(Point(xc + rx * cos(DegToRad(angle)), yc - ry * sin(DegToRad(angle))));
+    }
+}
+
+void DisplayListDeviceContext::DrawLine(int x1, int y1, int x2, int y2)
+{
+    this->StartPath(DL_PATH_STROKE, 1, Point(x1, y1));
+    this->WriteOp(DL_PATH_LINE_TO);
+    this->WritePoint(Point(x2, y2));
+}
+
+void DisplayListDeviceContext::DrawPolyline(int n, Point points[], int xOffset, int yOffset)
+{
+    this->FlushPenAndBrush();
+
+    this->WriteOp(DL_POLYLINE);
+    this->WriteUInt((uint32_t)n);
+    m_cursor = Point(0, 0);
+    for (int i = 0; i < n; ++i) {
+        this->WritePoint(Point(points[i].x + xOffset, points[i].y + yOffset));
+    }
+}
+
+void DisplayListDeviceContext::DrawPolygon(int n, Point points[], int xOffset, int yOffset)
+{
+    this->FlushPenAndBrush();
+
+    this->WriteOp(DL_POLYGON);
+    this->WriteUInt((uint32_t)n);
+    m_cursor = Point(0, 0);
+    for (int i = 0; i < n; ++i) {
+        this->WritePoint(Point(points[i].x + xOffset, points[i].y + yOffset));
+    }
+}
+
+void DisplayListDeviceContext::DrawRectangle(int x, int y, int width, int height)
+{
+    this->DrawRoundedRectangle(x, y, width, height, 0);
+}
+
+void DisplayListDeviceContext::DrawRoundedRectangle(int x, int y, int width, int height, int radius)
+{
+    this->FlushPenAndBrush();
+
+    // negative heights or widths are normalized as in the SVG output
+    if (height < 0) {
+        height = -height;
+        y -= height;
+    }
+    if (width < 0) {
+        width = -width;
+        x -= width;
+    }
+
+    this->WriteOp(DL_RECTANGLE);
+    this->WriteInt(x);
+    this->WriteInt(y);
+    this->WriteInt(width);
+    this->WriteInt(height);
+    this->WriteInt(radius);
+}
+
+void DisplayListDeviceContext::StartText(int x, int y, data_HORIZONTALALIGNMENT alignment)
+{
+    this->FlushPenAndBrush();
+
+    this->WriteOp(DL_START_TEXT);
+    this->WriteInt(x);
+    this->WriteInt(y);
+    this->WriteUInt((uint32_t)alignment);
+}
+
+void DisplayListDeviceContext::MoveTextTo(int x, int y, data_HORIZONTALALIGNMENT alignment)
+{
+    this->WriteOp(DL_MOVE_TEXT);
+    this->WriteInt(x);
+    this->WriteInt(y);
+    this->WriteUInt((uint32_t)alignment);
+}
+
+void DisplayListDeviceContext::MoveTextVerticallyTo(int y)
+{
+    this->WriteOp(DL_MOVE_TEXT);
+    this->WriteInt(VRV_UNSET);
+    this->WriteInt(y);
+    this->WriteUInt((uint32_t)HORIZONTALALIGNMENT_NONE);
+}
+
+void DisplayListDeviceContext::EndText()
+{
+    this->WriteOp(DL_END_TEXT);
+}
+
+void DisplayListDeviceContext::DrawText(
+    const std::string &text, const std::u32string &wtext, int x, int y, int width, int height)
+{
+    assert(m_fontStack.top());
+
+    const FontInfo *font = m_fontStack.top();
+    std::string faceName = font->GetFaceName();
+    if (font->GetSmuflFont() == SMUFL_FONT_FALLBACK) faceName = "Leipzig";
+
+    const uint32_t textRef = this->GetStringRef(text);
+    const uint32_t fontRef = this->GetStringRef(faceName);
+
+    this->WriteOp(DL_TEXT);
+    this->WriteUInt(textRef);
+    this->WriteUInt(fontRef);
+    this->WriteUInt((uint32_t)std::max(0, font->GetPointSize()));
+    this->WriteUInt((uint32_t)font->GetStyle());
+    this->WriteUInt((uint32_t)font->GetWeight());
+    this->WriteInt(font->GetLetterSpacing());
+    this->WriteInt(x);
+    this->WriteInt(y);
+}
+
+void DisplayListDeviceContext::DrawMusicText(const std::u32string &text, int x, int y, bool setSmuflGlyph)
+{
+    assert(m_fontStack.top());
+
+    const Resources *resources = this->GetResources();
+    assert(resources);
+
+    this->FlushPenAndBrush();
+
+    const FontInfo *font = m_fontStack.top();
+    int w, h, gx, gy;
+
+    for (char32_t c : text) {
+        const Glyph *glyph = resources->GetGlyph(c);
+        if (!glyph) {
+            continue;
+        }
+
+        const uint32_t glyphRef = this->GetGlyphRef(glyph);
+        this->WriteOp(DL_GLYPH);
+        this->WriteUInt(glyphRef);
+        this->WriteInt(x);
+        this->WriteInt(y);
+        this->WriteUInt((uint32_t)std::max(0, font->GetPointSize()));
+        this->WriteUInt((uint32_t)std::lround(font->GetWidthToHeightRatio() * 1000.0));
+
+        // Same advance as in the SVG output
+        if (glyph->GetHorizAdvX() > 0)
+            x += glyph->GetHorizAdvX() * font->GetPointSize() / glyph->GetUnitsPerEm();
+        else {
+            glyph->GetBoundingBox(gx, gy, w, h);
+            x += w * font->GetPointSize() / glyph->GetUnitsPerEm();
+        }
+    }
+}
+
+void DisplayListDeviceContext::DrawGraphicUri(int x, int y, int width, int height, const std::string &uri)
+{
+    const uint32_t uriRef = this->GetStringRef(uri);
+
+    this->WriteOp(DL_IMAGE);
+    this->WriteInt(x);
+    this->WriteInt(y);
+    this->WriteInt(width);
+    this->WriteInt(height);
+    this->WriteUInt(uriRef);
+}
+
+void DisplayListDeviceContext::DrawSvgShape(int x, int y, int width, int height, double scale, pugi::xml_node svg)
+{
+    std::ostringstream svgStream;
+    for (pugi::xml_node child : svg.children()) {
+        child.print(svgStream, "", pugi::format_raw);
+    }
+    const uint32_t svgRef = this->GetStringRef(svgStream.str());
+
+    this->WriteOp(DL_SVG_SHAPE);
+    this->WriteInt(x);
+    this->WriteInt(y);
+    this->WriteInt(width);
+    this->WriteInt(height);
+    this->WriteUInt((uint32_t)std::lround(scale * DEFINITION_FACTOR * 1000.0));
+    this->WriteUInt(svgRef);
+}
+
+} // namespace vrv
@@ -50,6 +50,7 @@
 #include "pgfoot.h"
 #include "pghead.h"
 #include "preparedatafunctor.h"
+#include "profiler.h"
 #include "resetfunctor.h"
 #include "runningelement.h"
 #include "score.h"
@@ -91,6 +92,7 @@ Doc::Doc() : Object(DOC, "doc-")
     // owned pointers need to be set to NULL;
     m_selectionPreceding = NULL;
     m_selectionFollowing = NULL;
+    m_castOffPagesFunctor = NULL;
 
     this->Reset();
 }
@@ -98,6 +100,7 @@ Doc::Doc() : Object(DOC, "doc-")
 Doc::~Doc()
 {
     this->ClearSelectionPages();
+    this->ResetPendingCastOff();
 
     delete m_options;
 }
@@ -133,6 +136,10 @@ void Doc::Reset()
     m_markup = MARKUP_DEFAULT;
     m_isMensuralMusicOnly = false;
     m_isCastOff = false;
+    m_hasCastOffPositions = false;
+    this->ResetPendingCastOff();
+    this->ResetVerticalLayoutCache();
+    this->ResetZoneIndex();
     m_visibleScores.clear();
 
     m_facsimile = NULL;
@@ -140,6 +147,11 @@ void Doc::Reset()
     m_drawingSmuflFontSize = 0;
     m_drawingLyricFontSize = 0;
 
+    m_glyphMetrics.clear();
+    m_glyphMetricsSet.clear();
+    m_glyphMetricsRevision = -1;
+    m_glyphMetricsFontSize = 0;
+
     m_header.reset();
     m_front.reset();
     m_back.reset();
@@ -531,7 +543,38 @@ void Doc::ExportMIDI(smf::MidiFile *midiFile)
     }
 }
 
-bool Doc::ExportTimemap(std::string &output, bool includeRests, bool includeMeasures)
+bool Doc::ExportTimemap(std::string &output, bool includeRests, bool includeMeasures, bool columnar)
+{
+    Timemap timemap;
+    if (!this->GenerateTimemap(timemap)) {
+        output = "{}";
+        return false;
+    }
+
+    if (columnar) {
+        timemap.ToColumnarJson(output, includeRests, includeMeasures);
+    }
+    else {
+        timemap.ToJson(output, includeRests, includeMeasures);
+    }
+
+    return true;
+}
+
+bool Doc::ExportTimemapBinary(std::vector<uint8_t> &output, bool includeRests, bool includeMeasures)
+{
+    Timemap timemap;
+    if (!this->GenerateTimemap(timemap)) {
+        output.clear();
+        return false;
+    }
+
+    timemap.ToBinary(output, includeRests, includeMeasures);
+
+    return true;
+}
+
+bool Doc::GenerateTimemap(Timemap &timemap)
 {
     if (!this->HasTimemap()) {
         // generate MIDI timemap before progressing
@@ -539,16 +582,12 @@ bool Doc::ExportTimemap(std::string &output, bool includeRests, bool includeMeas
     }
     if (!this->HasTimemap()) {
         LogWarning("Calculation of the timemap failed, the timemap cannot be exported.");
-        output = "{}";
         return false;
     }
-    Timemap timemap;
     GenerateTimemapFunctor generateTimemap(&timemap);
     generateTimemap.SetCueExclusion(this->GetOptions()->m_midiNoCue.GetValue());
     this->Process(generateTimemap);
 
-    timemap.ToJson(output, includeRests, includeMeasures);
-
     return true;
 }
 
@@ -563,6 +602,18 @@ bool Doc::ExportExpansionMap(std::string &output)
 }
 
 bool Doc::ExportFeatures(std::string &output, const std::string &options)
+{
+    FeatureExtractor extractor(options);
+    if (!this->ExtractFeatures(extractor)) {
+        output = "{}";
+        return false;
+    }
+    extractor.ToJson(output);
+
+    return true;
+}
+
+bool Doc::ExtractFeatures(FeatureExtractor &extractor)
 {
     if (!this->HasTimemap()) {
         // generate MIDI timemap before progressing
@@ -570,25 +621,26 @@ bool Doc::ExportFeatures(std::string &output, const std::string &options)
     }
     if (!this->HasTimemap()) {
         LogWarning("Calculation of the timemap failed, the features cannot be exported.");
-        output = "{}";
         return false;
     }
-    FeatureExtractor extractor(options);
     GenerateFeaturesFunctor generateFeatures(&extractor);
     this->Process(generateFeatures);
-    extractor.ToJson(output);
 
     return true;
 }
 
 void Doc::PrepareData()
 {
+    ProfilerStage profilerStage("prepareData");
+
     /************ Reset and initialization ************/
 
     if (m_dataPreparationDone) {
         ResetDataFunctor resetData;
         this->Process(resetData);
     }
+    // The zones of the elements are prepared again
+    this->ResetZoneIndex();
     PrepareDataInitializationFunctor prepareDataInitialization(this);
     this->Process(prepareDataInitialization);
 
@@ -948,6 +1000,8 @@ void Doc::CastOffSmartDoc()
 
 void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
 {
+    ProfilerStage profilerStage("castOff");
+
     Pages *pages = this->GetPages();
     assert(pages);
 
@@ -1023,7 +1077,36 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
     // Here we redo the alignment because of the new scoreDefs
     // Because of the new scoreDef, we need to reset cached drawingX
     castOffSinglePage->ResetCachedDrawingX();
-    castOffSinglePage->LayOutVertically();
+
+    // With a progressive layout, the single page is kept as pending page and only the systems needed for the first
+    // page are laid out vertically and cast off
+    if (m_options->m_progressiveLayout.GetValue()) {
+        pages->DetachChild(0);
+        assert(castOffSinglePage && !castOffSinglePage->GetParent());
+        this->ResetDataPage();
+
+        for (Score *score : scores) {
+            score->CalcRunningElementHeight(this);
+        }
+
+        Page *castOffFirstPage = new Page();
+        m_castOffPagesFunctor = new CastOffPagesFunctor(castOffSinglePage, this, castOffFirstPage);
+        m_castOffPagesFunctor->SetPageHeight(m_drawingPageContentHeight);
+        m_castOffPagesFunctor->SetLeftoverSystem(leftoverSystem);
+        pages->AddChild(castOffFirstPage);
+
+        m_castOffPendingPage = castOffSinglePage;
+        m_castOffPendingBottom = VRV_UNSET;
+        m_castOffPendingSystems = CASTOFF_PENDING_SYSTEMS;
+        m_castOffPendingOptimize = optimize;
+        m_isCastOff = true;
+        m_hasCastOffPositions = (leftoverSystem == NULL);
+
+        this->CastOffPendingPages(0);
+        return;
+    }
+
+    this->LayOutCastOffSystemsVertically(castOffSinglePage);
 
     // Detach the contentPage to prepare for CastOffPages
     pages->DetachChild(0);
@@ -1049,6 +1132,268 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
     }
 
     m_isCastOff = true;
+    // The content of a leftover system can have been moved to the previous one
+    m_hasCastOffPositions = (leftoverSystem == NULL);
+}
+
+void Doc::CastOffPendingPages(int pageIdx)
+{
+    if (!m_castOffPendingPage) return;
+    if ((pageIdx != VRV_UNSET) && (this->GetPageCount() > pageIdx + 1)) return;
+
+    ProfilerStage profilerStage("castOff");
+
+    Pages *pages = this->GetPages();
+    assert(pages);
+
+    // Keep the drawing page for setting it back
+    const int drawingPageIdx = (m_drawingPage) ? m_drawingPage->GetIdx() : VRV_UNSET;
+
+    // Detach the pending page - the pages cast off are added at the end
+    if (m_castOffPendingPage->GetParent()) {
+        assert(m_castOffPendingPage == pages->GetLast());
+        pages->DetachChild(m_castOffPendingPage->GetIdx());
+    }
+    this->ResetDataPage();
+
+    // A page is final once the next one has been started
+    while (m_castOffPendingPage->GetChildCount() > 0) {
+        if ((pageIdx != VRV_UNSET) && (pages->GetChildCount() > pageIdx + 1)) break;
+        this->CastOffPendingSystems(m_castOffPendingSystems);
+    }
+    // Lay out more systems at once the next time for keeping the overhead of each continuation low
+    m_castOffPendingSystems *= 2;
+
+    if (m_castOffPendingPage->GetChildCount() > 0) {
+        pages->AddChild(m_castOffPendingPage);
+    }
+    else {
+        delete m_castOffPendingPage;
+        this->ResetPendingCastOff();
+    }
+
+    this->ScoreDefSetCurrentDoc(true);
+    if (m_castOffPendingOptimize) {
+        this->ScoreDefOptimizeDoc();
+    }
+
+    if (drawingPageIdx != VRV_UNSET) {
+        this->SetDrawingPage(drawingPageIdx);
+    }
+}
+
+void Doc::CastOffPendingSystems(int systemCount)
+{
+    Pages *pages = this->GetPages();
+    assert(pages);
+    assert(m_castOffPendingPage && m_castOffPagesFunctor);
+
+    Page *contentPage = new Page();
+    contentPage->m_score = m_castOffPendingPage->m_score;
+    contentPage->m_scoreEnd = m_castOffPendingPage->m_scoreEnd;
+
+    // Move the systems with the page elements preceding them, and everything that is left after the last system
+    while (m_castOffPendingPage->GetChildCount() > 0) {
+        if ((systemCount == 0) && m_castOffPendingPage->FindDescendantByType(SYSTEM, 1)) break;
+        Object *child = m_castOffPendingPage->DetachChild(0);
+        if (child->Is(SYSTEM)) --systemCount;
+        contentPage->AddChild(child);
+    }
+
+    pages->AddChild(contentPage);
+    this->SetDrawingPage(contentPage->GetIdx());
+    contentPage->LayOutVertically();
+    pages->DetachChild(contentPage->GetIdx());
+    this->ResetDataPage();
+
+    // Shift the systems to follow the ones previously laid out, as if they had been laid out on a single page
+    const int unit = this->GetDrawingUnit(100);
+    const int systemSpacing = std::max(int(m_options->m_spacingSystem.GetValue() * unit), 2 * unit);
+    int shift = 0;
+    bool firstSystem = true;
+    for (Object *child : contentPage->GetChildren()) {
+        if (!child->Is(SYSTEM)) continue;
+        System *system = vrv_cast<System *>(child);
+        assert(system);
+        if (firstSystem && (m_castOffPendingBottom != VRV_UNSET)) {
+            shift = m_castOffPendingBottom - systemSpacing - system->GetDrawingYRel();
+        }
+        firstSystem = false;
+        if (shift != 0) system->SetDrawingYRel(system->GetDrawingYRel() + shift);
+        m_castOffPendingBottom = system->GetDrawingYRel() - system->GetHeight();
+    }
+    this->StoreCastOffPositions(contentPage);
+
+    m_castOffPagesFunctor->SetContentPage(contentPage);
+    contentPage->Process(*m_castOffPagesFunctor);
+    delete contentPage;
+}
+
+void Doc::CastOffPagesDoc()
+{
+    if (!this->CanCastOffPagesDoc()) {
+        LogDebug("Pages cannot be cast off again");
+        return;
+    }
+
+    Pages *pages = this->GetPages();
+    assert(pages);
+
+    std::list<Score *> scores = this->GetVisibleScores();
+    assert(!scores.empty());
+
+    // Move the content of all the pages back to a single page
+    Page *castOffSinglePage = new Page();
+    for (Object *child : pages->GetChildren()) {
+        Page *page = vrv_cast<Page *>(child);
+        assert(page);
+        castOffSinglePage->MoveChildrenFrom(page);
+    }
+    pages->ClearChildren();
+    this->ResetDataPage();
+
+    // This also updates the page drawing sizes
+    for (Score *score : scores) {
+        score->CalcRunningElementHeight(this);
+    }
+
+    Page *castOffFirstPage = new Page();
+    CastOffPagesFunctor castOffPages(castOffSinglePage, this, castOffFirstPage);
+    castOffPages.SetPageHeight(m_drawingPageContentHeight);
+
+    pages->AddChild(castOffFirstPage);
+    castOffSinglePage->Process(castOffPages);
+    delete castOffSinglePage;
+
+    bool optimize = false;
+    for (Score *score : scores) {
+        if (score->ScoreDefNeedsOptimization(m_options->m_condense.GetValue())) {
+            optimize = true;
+            break;
+        }
+    }
+
+    this->ScoreDefSetCurrentDoc(true);
+    if (optimize) {
+        this->ScoreDefOptimizeDoc();
+    }
+}
+
+bool Doc::CanCastOffPagesDoc() const
+{
+    return (m_isCastOff && m_hasCastOffPositions && !this->HasPendingCastOff() && !this->HasSelection());
+}
+
+void Doc::StoreCastOffPositions(Page *page)
+{
+    assert(page);
+
+    for (Object *child : page->GetChildren()) {
+        if (!child->Is(SYSTEM)) continue;
+        System *system = vrv_cast<System *>(child);
+        assert(system);
+        system->m_castOffYRel = system->GetDrawingYRel() - m_drawingPageContentHeight;
+        system->m_castOffHeight = system->GetHeight();
+    }
+}
+
+void Doc::LayOutCastOffSystemsVertically(Page *page)
+{
+    assert(page && (page == m_drawingPage));
+
+    // The systems laid out with other option values cannot be reused
+    const std::string optionValues = this->GetVerticalLayoutOptionValues();
+    if (optionValues != m_verticalLayoutOptionValues) {
+        m_verticalLayoutCache.clear();
+        m_verticalLayoutOptionValues = optionValues;
+    }
+
+    // Detach the systems found in the cache for laying out only the other ones
+    std::vector<std::pair<int, Object *>> cachedSystems;
+    bool firstSystem = true;
+    for (int i = 0; i < page->GetChildCount(); ++i) {
+        Object *child = page->GetChild(i);
+        if (!child->Is(SYSTEM)) continue;
+        const std::string key = this->GetVerticalLayoutKey(vrv_cast<System *>(child));
+        if (!firstSystem && m_verticalLayoutCache.contains(key)) {
+            cachedSystems.push_back({ i, child });
+        }
+        firstSystem = false;
+    }
+    for (auto iter = cachedSystems.rbegin(); iter != cachedSystems.rend(); ++iter) {
+        page->DetachChild(iter->first);
+    }
+
+    page->LayOutVertically();
+
+    for (const auto &[idx, child] : cachedSystems) {
+        page->InsertChild(child, idx);
+    }
+
+    // Position the systems as Page::LayOutVertically does, from the height laid out or cached
+    const int unit = this->GetDrawingUnit(100);
+    const int systemSpacing = std::max(int(m_options->m_spacingSystem.GetValue() * unit), 2 * unit);
+    int bottom = VRV_UNSET;
+    int cachedIdx = 0;
+    for (Object *child : page->GetChildren()) {
+        if (!child->Is(SYSTEM)) continue;
+        System *system = vrv_cast<System *>(child);
+        assert(system);
+        int height = 0;
+        if ((cachedIdx < (int)cachedSystems.size()) && (cachedSystems.at(cachedIdx).second == system)) {
+            height = m_verticalLayoutCache.at(this->GetVerticalLayoutKey(system));
+            ++cachedIdx;
+        }
+        else {
+            height = system->GetHeight();
+            m_verticalLayoutCache[this->GetVerticalLayoutKey(system)] = height;
+        }
+        if (bottom != VRV_UNSET) system->SetDrawingYRel(bottom - systemSpacing);
+        system->m_castOffYRel = system->GetDrawingYRel() - m_drawingPageContentHeight;
+        system->m_castOffHeight = height;
+        bottom = system->GetDrawingYRel() - height;
+    }
+}
+
+std::string Doc::GetVerticalLayoutKey(const System *system) const
+{
+    assert(system);
+
+    const Object *first = system->GetFirst();
+    const Object *last = system->GetLast();
+    if (!first || !last) return "";
+
+    return StringFormat("%s-%s-%d", first->GetID().c_str(), last->GetID().c_str(), system->GetChildCount());
+}
+
+std::string Doc::GetVerticalLayoutOptionValues() const
+{
+    const int layoutStages = LAYOUT_STAGE_VERTICAL | LAYOUT_STAGE_HORIZONTAL | LAYOUT_STAGE_DATA;
+
+    std::string values;
+    for (const auto &[key, option] : *m_options->GetItems()) {
+        if (!(option->GetLayoutStages() & layoutStages)) continue;
+        values += key + "=" + option->GetStrValue() + ";";
+    }
+    return values;
+}
+
+void Doc::ResetVerticalLayoutCache()
+{
+    m_verticalLayoutCache.clear();
+    m_verticalLayoutOptionValues.clear();
+}
+
+void Doc::ResetPendingCastOff()
+{
+    if (m_castOffPagesFunctor) {
+        delete m_castOffPagesFunctor;
+    }
+    m_castOffPagesFunctor = NULL;
+    m_castOffPendingPage = NULL;
+    m_castOffPendingBottom = VRV_UNSET;
+    m_castOffPendingSystems = CASTOFF_PENDING_SYSTEMS;
+    m_castOffPendingOptimize = false;
 }
 
 void Doc::UnCastOffDoc(bool resetCache)
@@ -1067,6 +1412,8 @@ void Doc::UnCastOffDoc(bool resetCache)
     this->Process(unCastOff);
 
     pages->ClearChildren();
+    this->ResetPendingCastOff();
+    m_hasCastOffPositions = false;
 
     pages->AddChild(unCastOffPage);
 
@@ -1082,6 +1429,8 @@ void Doc::UnCastOffDoc(bool resetCache)
 
 void Doc::CastOffEncodingDoc()
 {
+    ProfilerStage profilerStage("castOff");
+
     if (this->IsCastOff()) {
         LogDebug("Document is already cast off");
         return;
@@ -1390,6 +1739,8 @@ void Doc::ConvertMarkupDoc(bool permanent)
 
 void Doc::SyncFromFacsimileDoc()
 {
+    this->ResetZoneIndex();
+
     PrepareFacsimileFunctor prepareFacsimile(this->GetFacsimile());
     this->Process(prepareFacsimile);
 
@@ -1397,8 +1748,19 @@ void Doc::SyncFromFacsimileDoc()
     this->Process(syncFromFacsimileFunctor);
 }
 
+const ZoneIndex &Doc::GetZoneIndex()
+{
+    if (!m_zoneIndex.IsBuilt()) {
+        m_zoneIndex.Build(this);
+    }
+    return m_zoneIndex;
+}
+
 void Doc::SyncToFacsimileDoc()
 {
+    // The zones are created again
+    this->ResetZoneIndex();
+
     // Create a new facsimile object if we do not have one already
     if (!this->HasFacsimile()) {
         Facsimile *facsimile = new Facsimile();
@@ -1412,6 +1774,9 @@ void Doc::SyncToFacsimileDoc()
 
     SyncToFacsimileFunctor syncToFacimileFunctor(this);
     this->Process(syncToFacimileFunctor);
+
+    // The coordinates of the zones have been set after adding them
+    m_facsimile->Modify();
 }
 
 void Doc::TransposeDoc()
@@ -1487,9 +1852,8 @@ void Doc::ExpandExpansions()
 
 bool Doc::HasPage(int pageIdx) const
 {
-    const Pages *pages = this->GetPages();
-    assert(pages);
-    return ((pageIdx >= 0) && (pageIdx < pages->GetChildCount()));
+    assert(this->GetPages());
+    return ((pageIdx >= 0) && (pageIdx < this->GetPageCount()));
 }
 
 Pages *Doc::GetPages()
@@ -1505,7 +1869,12 @@ const Pages *Doc::GetPages() const
 int Doc::GetPageCount() const
 {
     const Pages *pages = this->GetPages();
-    return ((pages) ? pages->GetChildCount() : 0);
+    if (!pages) return 0;
+    // The pending page of a progressive cast-off is not a page of the document
+    if (m_castOffPendingPage && (m_castOffPendingPage->GetParent() == pages)) {
+        return pages->GetChildCount() - 1;
+    }
+    return pages->GetChildCount();
 }
 
 ScoreDef *Doc::GetFirstScoreDef()
@@ -1584,42 +1953,60 @@ void Doc::CollectVisibleScores()
     }
 }
 
-int Doc::GetGlyphHeight(char32_t code, int staffSize, bool graceSize) const
+GlyphMetrics Doc::GetGlyphMetrics(char32_t code) const
 {
-    int x, y, w, h;
     const Resources &resources = this->GetResources();
-    const Glyph *glyph = resources.GetGlyph(code);
-    assert(glyph);
-    glyph->GetBoundingBox(x, y, w, h);
-    h = h * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
-    if (graceSize) h = h * m_options->m_graceFactor.GetValue();
-    h = h * staffSize / 100;
-    return h;
+
+    const bool isSmufl = (code >= SMUFL_CODE_FIRST) && (code <= SMUFL_CODE_LAST);
+    if (isSmufl) {
+        if ((m_glyphMetricsRevision != resources.GetRevision()) || (m_glyphMetricsFontSize != m_drawingSmuflFontSize)) {
+            m_glyphMetrics.resize(SMUFL_CODE_LAST - SMUFL_CODE_FIRST + 1);
+            m_glyphMetricsSet.assign(SMUFL_CODE_LAST - SMUFL_CODE_FIRST + 1, false);
+            m_glyphMetricsRevision = resources.GetRevision();
+            m_glyphMetricsFontSize = m_drawingSmuflFontSize;
+        }
+        if (m_glyphMetricsSet[code - SMUFL_CODE_FIRST]) return m_glyphMetrics[code - SMUFL_CODE_FIRST];
+    }
+
+    GlyphMetrics metrics;
+    metrics.m_glyph = resources.GetGlyph(code);
+    assert(metrics.m_glyph);
+    int x, y, w, h;
+    metrics.m_glyph->GetBoundingBox(x, y, w, h);
+    const int unitsPerEm = metrics.m_glyph->GetUnitsPerEm();
+    metrics.m_x = x * m_drawingSmuflFontSize / unitsPerEm;
+    metrics.m_y = y * m_drawingSmuflFontSize / unitsPerEm;
+    metrics.m_width = w * m_drawingSmuflFontSize / unitsPerEm;
+    metrics.m_height = h * m_drawingSmuflFontSize / unitsPerEm;
+    metrics.m_advX = metrics.m_glyph->GetHorizAdvX() * m_drawingSmuflFontSize / unitsPerEm;
+
+    if (isSmufl) {
+        m_glyphMetrics[code - SMUFL_CODE_FIRST] = metrics;
+        m_glyphMetricsSet[code - SMUFL_CODE_FIRST] = true;
+    }
+    return metrics;
+}
+
+int Doc::ScaleGlyphValue(int value, int staffSize, bool graceSize) const
+{
+    if (graceSize) value = value * m_options->m_graceFactor.GetValue();
+    if (staffSize != 100) value = value * staffSize / 100;
+    return value;
+}
+
+int Doc::GetGlyphHeight(char32_t code, int staffSize, bool graceSize) const
+{
+    return this->ScaleGlyphValue(this->GetGlyphMetrics(code).m_height, staffSize, graceSize);
 }
 
 int Doc::GetGlyphWidth(char32_t code, int staffSize, bool graceSize) const
 {
-    int x, y, w, h;
-    const Resources &resources = this->GetResources();
-    const Glyph *glyph = resources.GetGlyph(code);
-    assert(glyph);
-    glyph->GetBoundingBox(x, y, w, h);
-    w = w * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
-    if (graceSize) w = w * m_options->m_graceFactor.GetValue();
-    w = w * staffSize / 100;
-    return w;
+    return this->ScaleGlyphValue(this->GetGlyphMetrics(code).m_width, staffSize, graceSize);
 }
 
 int Doc::GetGlyphAdvX(char32_t code, int staffSize, bool graceSize) const
 {
-    const Resources &resources = this->GetResources();
-    const Glyph *glyph = resources.GetGlyph(code);
-    assert(glyph);
-    int advX = glyph->GetHorizAdvX();
-    advX = advX * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
-    if (graceSize) advX = advX * m_options->m_graceFactor.GetValue();
-    advX = advX * staffSize / 100;
-    return advX;
+    return this->ScaleGlyphValue(this->GetGlyphMetrics(code).m_advX, staffSize, graceSize);
 }
 
 Point Doc::ConvertFontPoint(const Glyph *glyph, const Point &fontPoint, int staffSize, bool graceSize) const
@@ -1642,38 +2029,26 @@ Point Doc::ConvertFontPoint(const Glyph *glyph, const Point &fontPoint, int staf
 
 int Doc::GetGlyphLeft(char32_t code, int staffSize, bool graceSize) const
 {
-    int x, y, w, h;
-    const Resources &resources = this->GetResources();
-    const Glyph *glyph = resources.GetGlyph(code);
-    assert(glyph);
-    glyph->GetBoundingBox(x, y, w, h);
-    x = x * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
-    if (graceSize) x = x * m_options->m_graceFactor.GetValue();
-    x = x * staffSize / 100;
-    return x;
+    return this->ScaleGlyphValue(this->GetGlyphMetrics(code).m_x, staffSize, graceSize);
 }
 
 int Doc::GetGlyphRight(char32_t code, int staffSize, bool graceSize) const
 {
-    return this->GetGlyphLeft(code, staffSize, graceSize) + this->GetGlyphWidth(code, staffSize, graceSize);
+    const GlyphMetrics metrics = this->GetGlyphMetrics(code);
+    return this->ScaleGlyphValue(metrics.m_x, staffSize, graceSize)
+        + this->ScaleGlyphValue(metrics.m_width, staffSize, graceSize);
 }
 
 int Doc::GetGlyphBottom(char32_t code, int staffSize, bool graceSize) const
 {
-    int x, y, w, h;
-    const Resources &resources = this->GetResources();
-    const Glyph *glyph = resources.GetGlyph(code);
-    assert(glyph);
-    glyph->GetBoundingBox(x, y, w, h);
-    y = y * m_drawingSmuflFontSize / glyph->GetUnitsPerEm();
-    if (graceSize) y = y * m_options->m_graceFactor.GetValue();
-    y = y * staffSize / 100;
-    return y;
+    return this->ScaleGlyphValue(this->GetGlyphMetrics(code).m_y, staffSize, graceSize);
 }
 
 int Doc::GetGlyphTop(char32_t code, int staffSize, bool graceSize) const
 {
-    return this->GetGlyphBottom(code, staffSize, graceSize) + this->GetGlyphHeight(code, staffSize, graceSize);
+    const GlyphMetrics metrics = this->GetGlyphMetrics(code);
+    return this->ScaleGlyphValue(metrics.m_y, staffSize, graceSize)
+        + this->ScaleGlyphValue(metrics.m_height, staffSize, graceSize);
 }
 
 int Doc::GetTextGlyphHeight(char32_t code, const FontInfo *font, bool graceSize) const
@@ -117,12 +117,6 @@ void BeamDrawingInterface::ClearCoords()
     m_beamElementCoords.clear();
 }
 
-void BeamDrawingInterface::InitCoords(const ArrayOfObjects &childList, Staff *staff, data_BEAMPLACE place)
-{
-    ListOfObjects children(childList.begin(), childList.end());
-    this->InitCoords(children, staff, place);
-}
-
 void BeamDrawingInterface::InitCoords(const ListOfObjects &childList, Staff *staff, data_BEAMPLACE place)
 {
     assert(staff);
@@ -0,0 +1,68 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        editortoolkit.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "editortoolkit.h"
+
+//--------------------------------------------------------------------------------
+
+#include "page.h"
+#include "vrv.h"
+
+//--------------------------------------------------------------------------------
+
+namespace vrv {
+
+//--------------------------------------------------------------------------------
+// EditorToolkit
+//--------------------------------------------------------------------------------
+
+bool EditorToolkit::CommitTransaction()
+{
+    if (m_transactionDepth == 0) {
+        LogWarning("No transaction to commit");
+        return false;
+    }
+
+    --m_transactionDepth;
+    if (m_transactionDepth == 0) this->ApplyPendingUpdates();
+
+    return true;
+}
+
+void EditorToolkit::AbortTransaction()
+{
+    m_transactionDepth = 0;
+    m_prepareDataPending = false;
+    m_pagesToLayOut.clear();
+}
+
+void EditorToolkit::UpdateDocument(Page *page)
+{
+    m_prepareDataPending = true;
+    if (page) m_pagesToLayOut.insert(page->GetIdx());
+
+    if (m_transactionDepth == 0) this->ApplyPendingUpdates();
+}
+
+void EditorToolkit::ApplyPendingUpdates()
+{
+    if (m_prepareDataPending) m_doc->PrepareData();
+    m_prepareDataPending = false;
+
+    if (m_pagesToLayOut.empty()) return;
+
+    // Lay out each edited page as the drawing page and restore the drawing page
+    Page *drawingPage = m_doc->GetDrawingPage();
+    for (int pageIdx : m_pagesToLayOut) {
+        Page *page = m_doc->SetDrawingPage(pageIdx);
+        if (page) page->LayOut(true);
+    }
+    if (drawingPage) m_doc->SetDrawingPage(drawingPage->GetIdx());
+    m_pagesToLayOut.clear();
+}
+
+} // namespace vrv
@@ -43,7 +43,7 @@ std::string EditorToolkitCMN::EditInfo()
     return m_editInfo.json();
 }
 
-bool EditorToolkitCMN::ParseEditorAction(const std::string &json_editorAction, bool commitOnly)
+bool EditorToolkitCMN::ParseEditorAction(const std::string &json_editorAction)
 {
     jsonxx::Object json;
 
@@ -53,6 +53,11 @@ bool EditorToolkitCMN::ParseEditorAction(const std::string &json_editorAction, b
         return false;
     }
 
+    return this->ApplyEditorAction(json);
+}
+
+bool EditorToolkitCMN::ApplyEditorAction(const jsonxx::Object &json, bool commitOnly)
+{
     if (!json.has<jsonxx::String>("action")) {
         LogWarning("Incorrectly formatted JSON action.");
     }
@@ -61,7 +66,7 @@ bool EditorToolkitCMN::ParseEditorAction(const std::string &json_editorAction, b
 
     // Action without parameter
     if (action == "commit") {
-        m_doc->PrepareData();
+        this->UpdateDocument(NULL);
         return true;
     }
 
@@ -202,10 +207,18 @@ bool EditorToolkitCMN::Chain(jsonxx::Array actions)
 {
     bool status = true;
     m_chainedId = "";
+    // The data is prepared only once at the end of the chain
+    this->BeginTransaction();
     for (int i = 0; i < (int)actions.size(); ++i) {
-        status = this->ParseEditorAction(actions.get<jsonxx::Object>(i).json(), !status);
+        if (!actions.has<jsonxx::Object>(i)) {
+            LogError("Action %d was not an object", i);
+            status = false;
+            continue;
+        }
+        status = this->ApplyEditorAction(actions.get<jsonxx::Object>(i), !status);
         m_editInfo.import("uuid", m_chainedId);
     }
+    this->CommitTransaction();
     return status;
 }
 
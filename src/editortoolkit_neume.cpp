@@ -59,6 +59,13 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
         return false;
     }
 
+    return this->ApplyEditorAction(json);
+}
+
+bool EditorToolkitNeume::ApplyEditorAction(const jsonxx::Object &json)
+{
+    m_editInfo.reset();
+
     if (!json.has<jsonxx::String>("action")
         || (!json.has<jsonxx::Object>("param") && !json.has<jsonxx::Array>("param"))) {
         LogWarning("Incorrectly formatted JSON action");
@@ -69,6 +76,9 @@ bool EditorToolkitNeume::ParseEditorAction(const std::string &json_editorAction)
 
     std::string action = json.get<jsonxx::String>("action");
 
+    // The elements and the zones can have been changed by the previous action (e.g., in a chain)
+    m_doc->ResetZoneIndex();
+
     if (action != "chain" && json.has<jsonxx::Array>("param")) {
         LogWarning("Only 'chain' uses 'param' as an array.");
         m_editInfo.import("status", "FAILURE");
@@ -253,17 +263,21 @@ bool EditorToolkitNeume::Chain(jsonxx::Array actions)
     // LogMessage("%s", actions.get<jsonxx::Object>(0).json().c_str());
     bool status = true;
     jsonxx::Object results;
+    // The document is updated only once at the end of the chain
+    this->BeginTransaction();
     for (int i = 0; i < (int)actions.size(); i++) {
-        if (!actions.has<jsonxx::Object>(0)) {
+        if (!actions.has<jsonxx::Object>(i)) {
             LogError("Action %d was not an object", i);
+            this->CommitTransaction();
             m_editInfo.reset();
             m_editInfo.import("status", "FAILURE");
             m_editInfo.import("message", "Action " + std::to_string(i) + " was not an object.");
             return false;
         }
-        status |= this->ParseEditorAction(actions.get<jsonxx::Object>(i).json());
+        status |= this->ApplyEditorAction(actions.get<jsonxx::Object>(i));
         results.import(std::to_string(i), m_editInfo);
     }
+    this->CommitTransaction();
     m_editInfo = results;
     return status;
 }
@@ -758,20 +772,7 @@ bool EditorToolkitNeume::Insert(std::string elementType, std::string staffId, in
 
     // Find closest valid staff
     if (staffId == "auto") {
-        ListOfObjects staves = m_doc->FindAllDescendantsByType(STAFF, false);
-        std::vector<Object *> stavesVector(staves.begin(), staves.end());
-
-        ClosestBB comp;
-        comp.x = ulx;
-        comp.y = uly;
-
-        if (staves.size() > 0) {
-            std::sort(stavesVector.begin(), stavesVector.end(), comp);
-            staff = dynamic_cast<Staff *>(stavesVector.at(0));
-        }
-        else {
-            staff = NULL;
-        }
+        staff = vrv_cast<Staff *>(m_doc->GetZoneIndex().FindClosest(ulx, uly, STAFF));
     }
     else {
         staff = dynamic_cast<Staff *>(m_doc->FindDescendantByID(staffId));
@@ -1810,8 +1811,7 @@ bool EditorToolkitNeume::Set(std::string elementId, std::string attrType, std::s
     else if (AttModule::SetVisual(element, attrType, attrValue))
         success = true;
     if (success && m_doc->GetType() != Facs) {
-        m_doc->PrepareData();
-        m_doc->GetDrawingPage()->LayOut(true);
+        this->UpdateDocument(m_doc->GetDrawingPage());
     }
     m_editInfo.import("status", success ? "OK" : "FAILURE");
     m_editInfo.import("message", success ? "" : "Could not set attribute '" + attrType + "' to '" + attrValue + "'.");
@@ -1978,8 +1978,7 @@ bool EditorToolkitNeume::SetClef(std::string elementId, std::string shape)
         }
     }
     if (success && m_doc->GetType() != Facs) {
-        m_doc->PrepareData();
-        m_doc->GetDrawingPage()->LayOut(true);
+        this->UpdateDocument(m_doc->GetDrawingPage());
     }
     m_editInfo.import("status", "OK");
     m_editInfo.import("message", "");
@@ -3298,8 +3297,7 @@ bool EditorToolkitNeume::ToggleLigature(std::vector<std::string> elementIds)
     //     return false;
     // }
     if (success1 && success2 && m_doc->GetType() != Facs) {
-        m_doc->PrepareData();
-        m_doc->GetDrawingPage()->LayOut(true);
+        this->UpdateDocument(m_doc->GetDrawingPage());
     }
     m_editInfo.import("status", "OK");
     m_editInfo.import("message", "");
@@ -3349,15 +3347,11 @@ bool EditorToolkitNeume::ChangeStaff(std::string elementId)
         return false;
     }
 
-    ListOfObjects stavesList = m_doc->FindAllDescendantsByType(STAFF, false);
-
-    std::vector<Object *> staves(stavesList.begin(), stavesList.end());
-
-    ClosestBB comp;
+    int x, y;
 
     if (element->GetFacsimileInterface()->HasFacs()) {
-        comp.x = element->GetFacsimileInterface()->GetZone()->GetUlx();
-        comp.y = element->GetFacsimileInterface()->GetZone()->GetUly();
+        x = element->GetFacsimileInterface()->GetZone()->GetUlx();
+        y = element->GetFacsimileInterface()->GetZone()->GetUly();
     }
     else if (element->Is(SYLLABLE)) {
         int ulx, uly, lrx, lry;
@@ -3368,8 +3362,8 @@ bool EditorToolkitNeume::ChangeStaff(std::string elementId)
             m_editInfo.import("message", "Couldn't generate bounding box for syllable.");
             return false;
         }
-        comp.x = (lrx + ulx) / 2;
-        comp.y = (uly + lry) / 2;
+        x = (lrx + ulx) / 2;
+        y = (uly + lry) / 2;
     }
     else {
         LogError("This element does not have a facsimile.");
@@ -3378,14 +3372,9 @@ bool EditorToolkitNeume::ChangeStaff(std::string elementId)
         return false;
     }
 
-    Staff *staff = NULL;
-
     // find the nearest staff line
-    if (staves.size() > 0) {
-        std::sort(staves.begin(), staves.end(), comp);
-        staff = dynamic_cast<Staff *>(staves.front());
-    }
-    else {
+    Staff *staff = vrv_cast<Staff *>(m_doc->GetZoneIndex().FindClosest(x, y, STAFF));
+    if (!staff) {
         LogError("Could not find any staves. This should not happen");
         m_editInfo.import("status", "FAILURE");
         m_editInfo.import("message", "Could not find any staves. This should not happen");
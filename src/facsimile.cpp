@@ -10,6 +10,7 @@
 //----------------------------------------------------------------------------
 
 #include <cassert>
+#include <utility>
 
 //----------------------------------------------------------------------------
 
@@ -26,7 +27,11 @@ namespace vrv {
 
 static const ClassRegistrar<Facsimile> s_factory("facsimile", FACSIMILE);
 
-Facsimile::Facsimile() : Object(FACSIMILE, "facsimile-"), AttTyped() {}
+Facsimile::Facsimile() : Object(FACSIMILE, "facsimile-"), AttTyped()
+{
+    m_maxX = 0;
+    m_maxY = 0;
+}
 
 Facsimile::~Facsimile() {}
 
@@ -46,38 +51,63 @@ bool Facsimile::IsSupportedChild(Object *object)
 
 Zone *Facsimile::FindZoneByID(const std::string &zoneId)
 {
-    return dynamic_cast<Zone *>(this->FindDescendantByID(zoneId));
+    return dynamic_cast<Zone *>(this->FindZoneOrSurfaceByID(zoneId));
 }
 
 const Zone *Facsimile::FindZoneByID(const std::string &zoneId) const
 {
-    return dynamic_cast<const Zone *>(this->FindDescendantByID(zoneId));
+    return dynamic_cast<const Zone *>(this->FindZoneOrSurfaceByID(zoneId));
+}
+
+Object *Facsimile::FindZoneOrSurfaceByID(const std::string &id)
+{
+    return const_cast<Object *>(std::as_const(*this).FindZoneOrSurfaceByID(id));
+}
+
+const Object *Facsimile::FindZoneOrSurfaceByID(const std::string &id) const
+{
+    this->UpdateIndex();
+
+    auto iter = m_idIndex.find(id);
+    return (iter != m_idIndex.end()) ? iter->second : NULL;
 }
 
 int Facsimile::GetMaxX() const
 {
-    ListOfConstObjects surfaces = this->FindAllDescendantsByType(SURFACE);
+    this->UpdateIndex();
 
-    int max = 0;
-    for (const Object *object : surfaces) {
-        const Surface *surface = vrv_cast<const Surface *>(object);
-        assert(surface);
-        max = (surface->GetMaxX() > max) ? surface->GetMaxX() : max;
-    }
-    return max;
+    return m_maxX;
 }
 
 int Facsimile::GetMaxY() const
 {
-    ListOfConstObjects surfaces = this->FindAllDescendantsByType(SURFACE);
+    this->UpdateIndex();
 
-    int max = 0;
-    for (const Object *object : surfaces) {
+    return m_maxY;
+}
+
+void Facsimile::UpdateIndex() const
+{
+    if (!this->IsModified()) return;
+
+    m_idIndex.clear();
+    m_maxX = 0;
+    m_maxY = 0;
+
+    ListOfObjects descendants;
+    ClassIdsComparison comparison({ SURFACE, ZONE });
+    const_cast<Facsimile *>(this)->FindAllDescendantsByComparison(&descendants, &comparison);
+    for (Object *object : descendants) {
+        // Keep the first one in case of duplicated IDs, as with Object::FindDescendantByID
+        m_idIndex.emplace(object->GetID(), object);
+        if (!object->Is(SURFACE)) continue;
         const Surface *surface = vrv_cast<const Surface *>(object);
         assert(surface);
-        max = (surface->GetMaxY() > max) ? surface->GetMaxY() : max;
+        m_maxX = std::max(m_maxX, surface->GetMaxX());
+        m_maxY = std::max(m_maxY, surface->GetMaxY());
     }
-    return max;
+
+    this->Modify(false);
 }
 
 } // namespace vrv
@@ -111,7 +111,7 @@ FunctorCode FacsimileInterface::InterfacePrepareFacsimile(PrepareFacsimileFuncto
     assert(functor.GetFacsimile());
     Facsimile *facsimile = functor.GetFacsimile();
     std::string facsID = ExtractIDFragment(this->GetFacs());
-    Object *facsDescendant = facsimile->FindDescendantByID(facsID);
+    Object *facsDescendant = facsimile->FindZoneOrSurfaceByID(facsID);
     if (!facsDescendant) {
         LogWarning("Could not find @facs '%s' in facsimile element", facsID.c_str());
         return FUNCTOR_CONTINUE;
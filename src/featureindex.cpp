@@ -0,0 +1,460 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        featureindex.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "featureindex.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
+//----------------------------------------------------------------------------
+
+#include "featureextractor.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+
+namespace vrv {
+
+namespace {
+
+    // The feature names, in the order of FeatureIndex::Feature
+    const char *featureNames[] = { "intervalsChromatic", "intervalsDiatonic", "intervalGrossContour",
+        "intervalRefinedContour", "pitchesChromatic", "pitchesChromaticWithDuration", "pitchesDiatonic" };
+
+    // The magic string and the version of the binary format
+    const char indexMagic[] = "VRVFIDX";
+    const uint8_t indexVersion = 1;
+
+    // Unsigned integers are written as LEB128 variable-length values
+    void WriteVarint(std::ostream &output, uint64_t value)
+    {
+        while (value >= 0x80) {
+            output.put((char)((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        output.put((char)value);
+    }
+
+    bool ReadVarint(std::istream &input, uint64_t &value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const int byte = input.get();
+            if (byte == EOF) return false;
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool ReadVarint(std::istream &input, uint32_t &value)
+    {
+        uint64_t value64;
+        if (!ReadVarint(input, value64) || (value64 > UINT32_MAX)) return false;
+        value = (uint32_t)value64;
+        return true;
+    }
+
+    void WriteString(std::ostream &output, const std::string &value)
+    {
+        WriteVarint(output, value.size());
+        output.write(value.data(), value.size());
+    }
+
+    bool ReadString(std::istream &input, std::string &value)
+    {
+        uint64_t size;
+        if (!ReadVarint(input, size) || (size > (1 << 20))) return false;
+        value.resize(size);
+        return (bool)input.read(value.data(), size);
+    }
+
+    // Fixed size for the n-gram keys since they are hashes
+    void WriteKey(std::ostream &output, uint64_t key)
+    {
+        for (int i = 0; i < 8; ++i) output.put((char)((key >> (8 * i)) & 0xFF));
+    }
+
+    bool ReadKey(std::istream &input, uint64_t &key)
+    {
+        key = 0;
+        for (int i = 0; i < 8; ++i) {
+            const int byte = input.get();
+            if (byte == EOF) return false;
+            key |= (uint64_t)byte << (8 * i);
+        }
+        return true;
+    }
+
+    // The interval features have one value less than the pitches, each interval spanning two pitches
+    bool IsIntervalFeature(FeatureIndex::Feature feature)
+    {
+        return (feature < FeatureIndex::FEATURE_pitchesChromatic);
+    }
+
+} // namespace
+
+//----------------------------------------------------------------------------
+// FeatureIndex
+//----------------------------------------------------------------------------
+
+FeatureIndex::FeatureIndex(int ngramSize)
+{
+    this->Reset(ngramSize);
+}
+
+FeatureIndex::~FeatureIndex() {}
+
+void FeatureIndex::Reset(int ngramSize)
+{
+    m_ngramSize = std::clamp(ngramSize, 1, 16);
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        m_tokens[i].clear();
+        m_tokenIds[i].clear();
+        m_postings[i].clear();
+    }
+    m_documents.clear();
+}
+
+FeatureIndex::Feature FeatureIndex::StrToFeature(const std::string &name)
+{
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        if (name == featureNames[i]) return (Feature)i;
+    }
+    return FEATURE_COUNT;
+}
+
+uint32_t FeatureIndex::AddToken(Feature feature, const std::string &token)
+{
+    auto [iter, inserted] = m_tokenIds[feature].try_emplace(token, (uint32_t)m_tokens[feature].size());
+    if (inserted) m_tokens[feature].push_back(token);
+    return iter->second;
+}
+
+uint64_t FeatureIndex::GetNgramKey(const std::vector<uint32_t> &sequence, size_t position) const
+{
+    // FNV-1a over the token IDs - collisions only add candidates that are discarded by the verification
+    uint64_t key = 14695981039346656037ull;
+    for (size_t i = position; i < position + m_ngramSize; ++i) {
+        key = (key ^ sequence.at(i)) * 1099511628211ull;
+    }
+    return key;
+}
+
+void FeatureIndex::AddDocument(const std::string &documentId, const FeatureExtractor &extractor)
+{
+    const jsonxx::Array *arrays[FEATURE_COUNT] = { &extractor.m_intervalsChromatic, &extractor.m_intervalsDiatonic,
+        &extractor.m_intervalGrossContour, &extractor.m_intervalRefinedContour, &extractor.m_pitchesChromatic,
+        &extractor.m_pitchesChromaticWithDuration, &extractor.m_pitchesDiatonic };
+
+    Document document;
+    document.m_id = documentId;
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        const jsonxx::Array &values = *arrays[i];
+        document.m_sequences[i].reserve(values.size());
+        for (size_t j = 0; j < values.size(); ++j) {
+            document.m_sequences[i].push_back(this->AddToken((Feature)i, values.get<jsonxx::String>((unsigned)j)));
+        }
+    }
+
+    document.m_pitchOffsets.reserve(extractor.m_pitchesIds.size() + 1);
+    for (size_t i = 0; i < extractor.m_pitchesIds.size(); ++i) {
+        document.m_pitchOffsets.push_back((uint32_t)document.m_noteIds.size());
+        const jsonxx::Array &noteIds = extractor.m_pitchesIds.get<jsonxx::Array>((unsigned)i);
+        for (size_t j = 0; j < noteIds.size(); ++j) {
+            document.m_noteIds.push_back(noteIds.get<jsonxx::String>((unsigned)j));
+        }
+    }
+    document.m_pitchOffsets.push_back((uint32_t)document.m_noteIds.size());
+
+    m_documents.push_back(std::move(document));
+    this->IndexDocument((uint32_t)m_documents.size() - 1);
+}
+
+void FeatureIndex::IndexDocument(uint32_t documentIdx)
+{
+    const Document &document = m_documents.at(documentIdx);
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        const std::vector<uint32_t> &sequence = document.m_sequences[i];
+        for (size_t position = 0; position + m_ngramSize <= sequence.size(); ++position) {
+            m_postings[i][this->GetNgramKey(sequence, position)].push_back({ documentIdx, (uint32_t)position });
+        }
+    }
+}
+
+std::vector<std::string> FeatureIndex::GetMatchNoteIds(
+    const Document &document, Feature feature, uint32_t position, uint32_t length) const
+{
+    // An interval match of n values spans n + 1 pitches
+    const uint32_t lastPitch = position + length - (IsIntervalFeature(feature) ? 0 : 1);
+    if (lastPitch + 1 >= document.m_pitchOffsets.size()) return {};
+    return std::vector<std::string>(document.m_noteIds.begin() + document.m_pitchOffsets.at(position),
+        document.m_noteIds.begin() + document.m_pitchOffsets.at(lastPitch + 1));
+}
+
+std::string FeatureIndex::Search(const std::string &jsonQuery) const
+{
+    jsonxx::Object json;
+    if (!json.parse(jsonQuery) || !json.has<jsonxx::String>("feature")) {
+        LogError("The feature index query must be a JSON object with a feature name");
+        return "{}";
+    }
+    const Feature feature = StrToFeature(json.get<jsonxx::String>("feature"));
+    if (feature == FEATURE_COUNT) {
+        LogError("Unknown feature '%s'", json.get<jsonxx::String>("feature").c_str());
+        return "{}";
+    }
+    const int maxResults = json.get<jsonxx::Number>("maxResults", 0);
+
+    // The query values as tokens
+    std::vector<std::string> tokens;
+    if (json.has<jsonxx::Array>("query")) {
+        const jsonxx::Array &values = json.get<jsonxx::Array>("query");
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (values.has<jsonxx::Number>((unsigned)i)) {
+                tokens.push_back(StringFormat("%d", (int)values.get<jsonxx::Number>((unsigned)i)));
+            }
+            else {
+                tokens.push_back(values.get<jsonxx::String>((unsigned)i, ""));
+            }
+        }
+    }
+    else {
+        std::istringstream values(json.get<jsonxx::String>("query", ""));
+        for (std::string token; values >> token;) tokens.push_back(token);
+    }
+
+    jsonxx::Object output;
+    output << "feature" << featureNames[feature];
+    jsonxx::Array documents;
+    int matchCount = 0;
+
+    // A value missing from the vocabulary cannot match
+    std::vector<uint32_t> query;
+    for (const std::string &token : tokens) {
+        auto iter = m_tokenIds[feature].find(token);
+        if (iter == m_tokenIds[feature].end()) break;
+        query.push_back(iter->second);
+    }
+
+    if (!tokens.empty() && (query.size() == tokens.size())) {
+        // Collect the candidate positions of the match, sorted by document and position
+        std::vector<Posting> candidates;
+        if ((int)query.size() >= m_ngramSize) {
+            // Use the n-gram of the query with the fewest postings
+            const std::vector<Posting> *bestPostings = NULL;
+            uint32_t bestOffset = 0;
+            for (size_t offset = 0; offset + m_ngramSize <= query.size(); ++offset) {
+                auto iter = m_postings[feature].find(this->GetNgramKey(query, offset));
+                if (iter == m_postings[feature].end()) {
+                    bestPostings = NULL;
+                    break;
+                }
+                if (!bestPostings || (iter->second.size() < bestPostings->size())) {
+                    bestPostings = &iter->second;
+                    bestOffset = (uint32_t)offset;
+                }
+            }
+            if (bestPostings) {
+                for (const Posting &posting : *bestPostings) {
+                    if (posting.m_position < bestOffset) continue;
+                    candidates.push_back({ posting.m_document, posting.m_position - bestOffset });
+                }
+            }
+        }
+        else {
+            // The query is shorter than the n-grams and all the positions are candidates
+            for (uint32_t i = 0; i < (uint32_t)m_documents.size(); ++i) {
+                const size_t size = m_documents.at(i).m_sequences[feature].size();
+                for (uint32_t position = 0; position + query.size() <= size; ++position) {
+                    candidates.push_back({ i, position });
+                }
+            }
+        }
+
+        // Verify the candidates and group the matches by document
+        jsonxx::Object jsonDocument;
+        jsonxx::Array matches;
+        uint32_t currentDocument = UINT32_MAX;
+        for (const Posting &candidate : candidates) {
+            if ((maxResults > 0) && (matchCount >= maxResults)) break;
+            const Document &document = m_documents.at(candidate.m_document);
+            const std::vector<uint32_t> &sequence = document.m_sequences[feature];
+            if (candidate.m_position + query.size() > sequence.size()) continue;
+            if (!std::equal(query.begin(), query.end(), sequence.begin() + candidate.m_position)) continue;
+            if (candidate.m_document != currentDocument) {
+                if (currentDocument != UINT32_MAX) {
+                    jsonDocument << "matches" << matches;
+                    documents << jsonDocument;
+                }
+                jsonDocument = jsonxx::Object();
+                jsonDocument << "id" << document.m_id;
+                matches = jsonxx::Array();
+                currentDocument = candidate.m_document;
+            }
+            jsonxx::Array noteIds;
+            for (const std::string &noteId :
+                this->GetMatchNoteIds(document, feature, candidate.m_position, (uint32_t)query.size())) {
+                noteIds << noteId;
+            }
+            matches << jsonxx::Value(noteIds);
+            ++matchCount;
+        }
+        if (currentDocument != UINT32_MAX) {
+            jsonDocument << "matches" << matches;
+            documents << jsonDocument;
+        }
+    }
+
+    output << "matchCount" << matchCount;
+    output << "documents" << documents;
+    return output.json();
+}
+
+bool FeatureIndex::Write(std::ostream &output) const
+{
+    output.write(indexMagic, sizeof(indexMagic) - 1);
+    output.put((char)indexVersion);
+    WriteVarint(output, m_ngramSize);
+
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        WriteVarint(output, m_tokens[i].size());
+        for (const std::string &token : m_tokens[i]) WriteString(output, token);
+    }
+
+    WriteVarint(output, m_documents.size());
+    for (const Document &document : m_documents) {
+        WriteString(output, document.m_id);
+        for (int i = 0; i < FEATURE_COUNT; ++i) {
+            WriteVarint(output, document.m_sequences[i].size());
+            for (uint32_t token : document.m_sequences[i]) WriteVarint(output, token);
+        }
+        WriteVarint(output, document.m_noteIds.size());
+        for (const std::string &noteId : document.m_noteIds) WriteString(output, noteId);
+        // The offsets are increasing and written as differences
+        WriteVarint(output, document.m_pitchOffsets.size());
+        uint32_t previousOffset = 0;
+        for (uint32_t offset : document.m_pitchOffsets) {
+            WriteVarint(output, offset - previousOffset);
+            previousOffset = offset;
+        }
+    }
+
+    // The postings by increasing key so the output is reproducible
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        std::vector<uint64_t> keys;
+        keys.reserve(m_postings[i].size());
+        for (const auto &entry : m_postings[i]) keys.push_back(entry.first);
+        std::sort(keys.begin(), keys.end());
+        WriteVarint(output, keys.size());
+        for (uint64_t key : keys) {
+            const std::vector<Posting> &postings = m_postings[i].at(key);
+            WriteKey(output, key);
+            WriteVarint(output, postings.size());
+            // Documents are increasing and written as differences, as are the positions within a document
+            Posting previous = { 0, 0 };
+            for (const Posting &posting : postings) {
+                const uint32_t documentDelta = posting.m_document - previous.m_document;
+                WriteVarint(output, documentDelta);
+                WriteVarint(output, (documentDelta == 0) ? posting.m_position - previous.m_position : posting.m_position);
+                previous = posting;
+            }
+        }
+    }
+
+    return (bool)output;
+}
+
+bool FeatureIndex::Read(std::istream &input)
+{
+    char magic[sizeof(indexMagic) - 1];
+    if (!input.read(magic, sizeof(magic)) || (std::string(magic, sizeof(magic)) != indexMagic)
+        || (input.get() != indexVersion)) {
+        LogError("The input is not a feature index or has an unsupported version");
+        return false;
+    }
+
+    uint32_t ngramSize;
+    if (!ReadVarint(input, ngramSize)) return false;
+    this->Reset(ngramSize);
+
+    bool valid = true;
+    uint32_t count;
+    for (int i = 0; valid && (i < FEATURE_COUNT); ++i) {
+        valid = ReadVarint(input, count);
+        for (uint32_t j = 0; valid && (j < count); ++j) {
+            std::string token;
+            valid = ReadString(input, token);
+            if (valid) this->AddToken((Feature)i, token);
+        }
+    }
+
+    valid = valid && ReadVarint(input, count);
+    if (valid) m_documents.resize(count);
+    for (Document &document : m_documents) {
+        if (!valid) break;
+        valid = ReadString(input, document.m_id);
+        for (int i = 0; valid && (i < FEATURE_COUNT); ++i) {
+            valid = ReadVarint(input, count);
+            if (valid) document.m_sequences[i].resize(count);
+            for (uint32_t &token : document.m_sequences[i]) {
+                if (!(valid = valid && ReadVarint(input, token) && (token < m_tokens[i].size()))) break;
+            }
+        }
+        valid = valid && ReadVarint(input, count);
+        if (valid) document.m_noteIds.resize(count);
+        for (std::string &noteId : document.m_noteIds) {
+            if (!(valid = valid && ReadString(input, noteId))) break;
+        }
+        valid = valid && ReadVarint(input, count);
+        if (valid) document.m_pitchOffsets.resize(count);
+        uint32_t offset = 0;
+        for (uint32_t &pitchOffset : document.m_pitchOffsets) {
+            uint32_t delta;
+            if (!(valid = valid && ReadVarint(input, delta))) break;
+            offset += delta;
+            pitchOffset = offset;
+        }
+    }
+
+    for (int i = 0; valid && (i < FEATURE_COUNT); ++i) {
+        valid = ReadVarint(input, count);
+        m_postings[i].reserve(count);
+        for (uint32_t j = 0; valid && (j < count); ++j) {
+            uint64_t key;
+            uint32_t postingCount;
+            valid = ReadKey(input, key) && ReadVarint(input, postingCount);
+            if (!valid) break;
+            std::vector<Posting> &postings = m_postings[i][key];
+            postings.reserve(postingCount);
+            Posting previous = { 0, 0 };
+            for (uint32_t k = 0; valid && (k < postingCount); ++k) {
+                uint32_t documentDelta, position;
+                valid = ReadVarint(input, documentDelta) && ReadVarint(input, position);
+                Posting posting = { previous.m_document + documentDelta,
+                    (documentDelta == 0) ? previous.m_position + position : position };
+                valid = valid && (posting.m_document < m_documents.size());
+                postings.push_back(posting);
+                previous = posting;
+            }
+        }
+    }
+
+    if (!valid) {
+        LogError("The feature index is truncated or corrupted");
+        this->Reset(m_ngramSize);
+        return false;
+    }
+    return true;
+}
+
+} // namespace vrv
@@ -123,4 +123,64 @@ std::string ZipFileReader::ReadTextFile(const std::string &filename)
     return "";
 }
 
+//----------------------------------------------------------------------------
+// ZipFileWriter
+//----------------------------------------------------------------------------
+
+ZipFileWriter::ZipFileWriter()
+{
+    m_file = NULL;
+
+    this->Reset();
+}
+
+ZipFileWriter::~ZipFileWriter()
+{
+    if (m_file) {
+        delete m_file;
+        m_file = NULL;
+    }
+}
+
+void ZipFileWriter::Reset()
+{
+    if (m_file) {
+        delete m_file;
+    }
+    m_file = new miniz_cpp::zip_file();
+}
+
+void ZipFileWriter::WriteTextFile(const std::string &filename, const std::string &content)
+{
+    assert(m_file);
+
+    m_file->writestr(filename, content);
+}
+
+std::vector<unsigned char> ZipFileWriter::GetBytes()
+{
+    assert(m_file);
+
+    std::vector<unsigned char> bytes;
+    m_file->save(bytes);
+    this->Reset();
+    return bytes;
+}
+
+std::vector<unsigned char> ZipFileWriter::EncodePNG(const unsigned char *rgba, int width, int height)
+{
+    assert(rgba);
+
+    size_t length = 0;
+    void *png = tdefl_write_image_to_png_file_in_memory_ex(rgba, width, height, 4, &length, MZ_DEFAULT_LEVEL, MZ_FALSE);
+    if (!png) {
+        LogError("The PNG image could not be encoded");
+        return {};
+    }
+
+    std::vector<unsigned char> bytes((unsigned char *)png, (unsigned char *)png + length);
+    mz_free(png);
+    return bytes;
+}
+
 } // namespace vrv
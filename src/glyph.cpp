@@ -141,12 +141,12 @@ void Glyph::SetAnchor(std::string anchorStr, double x, double y)
 
 bool Glyph::HasAnchor(SMuFLGlyphAnchor anchor) const
 {
-    return (m_anchors.count(anchor) == 1);
+    return m_anchors.at(anchor).has_value();
 }
 
 const Point *Glyph::GetAnchor(SMuFLGlyphAnchor anchor) const
 {
-    return &m_anchors.at(anchor);
+    return &m_anchors.at(anchor).value();
 }
 
 std::string Glyph::GetXML() const
@@ -171,8 +171,8 @@ void Hairpin::SetRightLink(ControlElement *rightLink)
 
 std::pair<int, int> Hairpin::GetBarlineOverlapAdjustment(int doubleUnit, int leftX, int rightX, int spanningType) const
 {
-    const Measure *startMeasure = vrv_cast<const Measure *>(this->GetStart()->GetFirstAncestor(MEASURE));
-    const Measure *endMeasure = vrv_cast<const Measure *>(this->GetEnd()->GetFirstAncestor(MEASURE));
+    const Measure *startMeasure = this->GetStart()->GetAncestorMeasure();
+    const Measure *endMeasure = this->GetEnd()->GetAncestorMeasure();
 
     if (!startMeasure || !endMeasure) return { 0, 0 };
 
@@ -198,7 +198,7 @@ std::pair<int, int> Hairpin::GetBarlineOverlapAdjustment(int doubleUnit, int lef
         rightBarline = endMeasure->GetRightBarLine();
     }
     else if (spanningType == SPANNING_START) {
-        const System *startSystem = vrv_cast<const System *>(this->GetStart()->GetFirstAncestor(SYSTEM));
+        const System *startSystem = this->GetStart()->GetAncestorSystem();
         if (startSystem) {
             ClassIdComparison cmp(MEASURE);
             const Measure *measure
@@ -617,7 +617,7 @@ bool Alignment::AddLayerElementRef(LayerElement *element)
         }
         // Non cross staff normal case
         else {
-            layerRef = vrv_cast<Layer *>(element->GetFirstAncestor(LAYER));
+            layerRef = element->GetAncestorLayer();
             if (layerRef) staffRef = vrv_cast<Staff *>(layerRef->GetFirstAncestor(STAFF));
             if (staffRef) {
                 layerN = layerRef->GetN();
@@ -66,16 +66,16 @@ namespace vrv {
 
 #ifndef NO_ABC_SUPPORT
 
-// Global variables:
-std::string abcLine;
+// Global variables (thread local for importing from several threads):
+thread_local std::string abcLine;
 #define MAX_DATA_LEN 1024 // One line of the abc file would not be that long!
-char dataKey[MAX_DATA_LEN];
-char dataValue[MAX_DATA_LEN]; // ditto as above
+thread_local char dataKey[MAX_DATA_LEN];
+thread_local char dataValue[MAX_DATA_LEN]; // ditto as above
 
 const std::string pitch = "FCGDAEB";
 const std::string shorthandDecoration = ".~HLMOPSTuv";
-std::string keyPitchAlter = "";
-int keyPitchAlterAmount = 0;
+thread_local std::string keyPitchAlter = "";
+thread_local int keyPitchAlterAmount = 0;
 
 //----------------------------------------------------------------------------
 // ABCInput
@@ -788,7 +788,7 @@ void ABCInput::parseTempo(const std::string &tempoString)
     Tempo *tempo = new Tempo();
     if (tempoString.find('=') != std::string::npos) {
         const int numStart = int(tempoString.find('=') + 1);
-        tempo->SetMm(std::atof(tempoString.substr(numStart).c_str()));
+        tempo->SetMm(StringToDouble(tempoString.substr(numStart)));
     }
     if (tempoString.find('\"') != std::string::npos) {
         std::string tempoWord = tempoString.substr(tempoString.find('\"') + 1);
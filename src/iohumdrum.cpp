@@ -8309,7 +8309,7 @@ void HumdrumInput::addInstrumentDefinition(StaffDef *staffdef, hum::HTp partstar
 
     // Allowing users to assign MIDI instrument numbers in data would be useful, but
     // currently only allowed via insturment codes.
-    static hum::HumInstrument imap;
+    static thread_local hum::HumInstrument imap;
     int gmpc = imap.getGM(*instcode);
 
     //   gmpc is -1 if no mapping, so don't add General MIDI insturment number in that case
@@ -30007,7 +30007,7 @@ static const EntityNameEntry StaticEntityNames[] = {
 
 typedef std::map<std::string, unsigned int> EntityNameMap;
 typedef std::pair<std::string, unsigned int> EntityNamePair;
-static EntityNameMap EntityNames;
+static thread_local EntityNameMap EntityNames;
 
 //////////////////////////////
 //
@@ -11,6 +11,8 @@
 
 #include <cassert>
 #include <iostream>
+#include <thread>
+#include <unordered_map>
 
 //----------------------------------------------------------------------------
 
@@ -184,7 +186,8 @@ bool MEIOutput::Export()
         // When saving page-based MEI we also want to keep IDs for milestone elements
         findAllReferencedObjects.IncludeMilestoneReferences(this->IsPageBasedMEI());
         m_doc->Process(findAllReferencedObjects);
-        m_referredObjects.unique();
+        m_referredObjects.erase(
+            std::unique(m_referredObjects.begin(), m_referredObjects.end()), m_referredObjects.end());
     }
 
     try {
@@ -3354,6 +3357,7 @@ MEIInput::MEIInput(Doc *doc) : Input(doc)
     m_hasScoreDef = false;
     m_readingScoreBased = false;
     m_meiversion = meiVersion_MEIVERSION_NONE;
+    m_objectsWithMeiID = NULL;
 }
 
 MEIInput::~MEIInput() {}
@@ -3374,7 +3378,7 @@ bool MEIInput::Import(const std::string &mei)
     }
 }
 
-bool MEIInput::IsAllowed(std::string element, Object *filterParent)
+bool MEIInput::IsAllowed(const std::string &element, Object *filterParent)
 {
     if (!filterParent || (element == "")) {
         return true;
@@ -4415,11 +4419,23 @@ bool MEIInput::ReadSectionChildren(Object *parent, pugi::xml_node parentNode)
     assert(dynamic_cast<Section *>(parent) || dynamic_cast<Ending *>(parent) || dynamic_cast<Expansion *>(parent)
         || dynamic_cast<EditorialElement *>(parent));
 
+    const bool concurrent = parent->Is({ SECTION, ENDING, EXPANSION }) && (this->GetThreadCount() > 1);
+
     bool success = true;
     pugi::xml_node current;
     Measure *unmeasured = NULL;
     for (current = parentNode.first_child(); current; current = current.next_sibling()) {
         if (!success) break;
+        // long runs of measures
+        if (concurrent && !m_doc->IsMensuralMusicOnly() && (std::string(current.name()) == "measure")) {
+            const std::vector<pugi::xml_node> run = this->GetMeasureRun(current);
+            const std::vector<int> chunkStarts = this->SplitMeasureRun(run, this->GetThreadCount());
+            if (chunkStarts.size() > 1) {
+                success = this->ReadMeasureRun(parent, run, chunkStarts);
+                current = run.back();
+                continue;
+            }
+        }
         this->NormalizeAttributes(current);
         // editorial
         if (this->IsEditorialElementName(current.name())) {
@@ -4491,6 +4507,162 @@ bool MEIInput::ReadSectionChildren(Object *parent, pugi::xml_node parentNode)
     return success;
 }
 
+int MEIInput::GetThreadCount() const
+{
+#ifdef __EMSCRIPTEN__
+    return 1;
+#else
+    const int threadCount = m_doc->GetOptions()->m_importThreads.GetValue();
+    if (threadCount > 0) return threadCount;
+    return std::max(1, (int)std::thread::hardware_concurrency());
+#endif
+}
+
+std::vector<pugi::xml_node> MEIInput::GetMeasureRun(pugi::xml_node measure) const
+{
+    std::vector<pugi::xml_node> run;
+    for (pugi::xml_node current = measure; current; current = current.next_sibling()) {
+        const std::string currentName = current.name();
+        if ((currentName != "measure") && (currentName != "sb") && (currentName != "pb")
+            && (current.type() != pugi::node_comment)) {
+            break;
+        }
+        run.push_back(current);
+    }
+    // Trailing comments are attached to what follows the run or to the parent
+    while (run.back().type() == pugi::node_comment) run.pop_back();
+    return run;
+}
+
+std::vector<int> MEIInput::SplitMeasureRun(const std::vector<pugi::xml_node> &run, int threadCount) const
+{
+    // The minimum number of measures for reading them in a separate thread to pay off
+    const int minChunkSize = 16;
+
+    std::vector<int> measures;
+    for (int i = 0; i < (int)run.size(); ++i) {
+        if (std::string(run.at(i).name()) == "measure") measures.push_back(i);
+    }
+    const int chunkCount = std::min(threadCount, (int)measures.size() / minChunkSize);
+
+    std::vector<int> chunkStarts;
+    for (int i = 0; i < chunkCount; ++i) {
+        int start = measures.at(i * (int)measures.size() / chunkCount);
+        // The comments before the first measure of a chunk are attached to it
+        while ((start > 0) && (run.at(start - 1).type() == pugi::node_comment)) --start;
+        chunkStarts.push_back(start);
+    }
+    return chunkStarts;
+}
+
+bool MEIInput::ReadMeasureRun(Object *parent, const std::vector<pugi::xml_node> &run, const std::vector<int> &chunkStarts)
+{
+    struct Chunk {
+        int start;
+        int end;
+        // The counter the IDs of the chunk are generated from and the number of IDs generated
+        uint32_t firstID;
+        uint32_t idCount = 0;
+        std::string comment;
+        Section *container = NULL;
+        std::unordered_set<const Object *> objectsWithMeiID;
+        LogCapture logCapture;
+        LayoutInformation layoutInformation = LAYOUT_NONE;
+        bool success = false;
+    };
+
+    // Each chunk generates its IDs in a separate range, renumbered afterwards
+    const uint32_t firstID = Object::GetIDCounter();
+    const uint32_t idRange = 0x80000000 / (uint32_t)chunkStarts.size();
+
+    std::vector<Chunk> chunks(chunkStarts.size());
+    for (int i = 0; i < (int)chunks.size(); ++i) {
+        chunks.at(i).start = chunkStarts.at(i);
+        chunks.at(i).end = (i + 1 < (int)chunks.size()) ? chunkStarts.at(i + 1) : (int)run.size();
+        chunks.at(i).firstID = firstID + 0x80000000 + i * idRange;
+    }
+    chunks.front().comment = m_comment;
+    m_comment.clear();
+
+    auto readChunk = [this, &run](Chunk &chunk) {
+        chunk.logCapture.Start();
+        try {
+            // The nodes are copied because reading them modifies them
+            pugi::xml_document document;
+            for (int i = chunk.start; i < chunk.end; ++i) document.append_copy(run.at(i));
+
+            chunk.container = new Section();
+            Object::SetIDCounter(chunk.firstID);
+
+            MEIInput input(m_doc);
+            input.m_meiversion = m_meiversion;
+            input.m_readingScoreBased = m_readingScoreBased;
+            input.m_hasScoreDef = m_hasScoreDef;
+            input.m_comment = chunk.comment;
+            input.m_objectsWithMeiID = &chunk.objectsWithMeiID;
+
+            chunk.success = true;
+            for (pugi::xml_node current : document.children()) {
+                if (!chunk.success) break;
+                input.NormalizeAttributes(current);
+                const std::string currentName = current.name();
+                if (currentName == "measure") {
+                    chunk.success = input.ReadMeasure(chunk.container, current);
+                }
+                else if (currentName == "sb") {
+                    chunk.success = input.ReadSb(chunk.container, current);
+                }
+                else if (currentName == "pb") {
+                    chunk.success = input.ReadPb(chunk.container, current);
+                }
+                else {
+                    chunk.success = input.ReadXMLComment(chunk.container, current);
+                }
+            }
+            chunk.idCount = Object::GetIDCounter() - chunk.firstID;
+            chunk.layoutInformation = input.m_layoutInformation;
+        }
+        catch (char *str) {
+            LogError("%s", str);
+            chunk.success = false;
+        }
+        chunk.logCapture.Stop();
+    };
+
+    std::vector<std::thread> threads;
+    for (Chunk &chunk : chunks) threads.push_back(std::thread(readChunk, std::ref(chunk)));
+    for (std::thread &thread : threads) thread.join();
+
+    bool success = true;
+    uint32_t nextID = firstID;
+    for (Chunk &chunk : chunks) {
+        // Renumber the generated IDs as if the chunks had been read one after the other
+        ArrayOfObjects objects = chunk.container->GetChildren();
+        while (!objects.empty()) {
+            Object *object = objects.back();
+            objects.pop_back();
+            objects.insert(objects.end(), object->GetChildren().begin(), object->GetChildren().end());
+            if (chunk.objectsWithMeiID.count(object)) continue;
+            const std::string &id = object->GetID();
+            uint32_t counter;
+            if ((id.size() < 2) || !Object::GetHashIDCounter(id.substr(1), counter)) continue;
+            const uint32_t index = counter - chunk.firstID;
+            if ((index == 0) || (index > chunk.idCount)) continue;
+            object->SetID(id.at(0) + BaseEncodeInt(Object::Hash(nextID + index), 36));
+        }
+        nextID += chunk.idCount;
+
+        parent->MoveChildrenFrom(chunk.container, -1, true);
+        delete chunk.container;
+        chunk.logCapture.Replay();
+        if (chunk.layoutInformation == LAYOUT_ENCODED) m_layoutInformation = LAYOUT_ENCODED;
+        success = success && chunk.success;
+    }
+    Object::SetIDCounter(nextID);
+
+    return success;
+}
+
 bool MEIInput::ReadSystemElement(pugi::xml_node element, SystemElement *object)
 {
     this->SetMeiID(element, object);
@@ -5385,6 +5557,39 @@ bool MEIInput::ReadMeasure(Object *parent, pugi::xml_node measure)
 
 bool MEIInput::ReadMeasureChildren(Object *parent, pugi::xml_node parentNode)
 {
+    // The reading method of each element within <measure> without specific handling
+    static const std::unordered_map<std::string, ElementReader> measureReaders = {
+        { "anchoredText", &MEIInput::ReadAnchoredText },
+        { "arpeg", &MEIInput::ReadArpeg },
+        { "beamSpan", &MEIInput::ReadBeamSpan },
+        { "bracketSpan", &MEIInput::ReadBracketSpan },
+        { "breath", &MEIInput::ReadBreath },
+        { "caesura", &MEIInput::ReadCaesura },
+        { "dir", &MEIInput::ReadDir },
+        { "dynam", &MEIInput::ReadDynam },
+        { "fermata", &MEIInput::ReadFermata },
+        { "fing", &MEIInput::ReadFing },
+        { "gliss", &MEIInput::ReadGliss },
+        { "hairpin", &MEIInput::ReadHairpin },
+        { "harm", &MEIInput::ReadHarm },
+        { "lv", &MEIInput::ReadLv },
+        { "mNum", &MEIInput::ReadMNum },
+        { "mordent", &MEIInput::ReadMordent },
+        { "octave", &MEIInput::ReadOctave },
+        { "ornam", &MEIInput::ReadOrnam },
+        { "pedal", &MEIInput::ReadPedal },
+        { "phrase", &MEIInput::ReadPhrase },
+        { "pitchInflection", &MEIInput::ReadPitchInflection },
+        { "reh", &MEIInput::ReadReh },
+        { "repeatMark", &MEIInput::ReadRepeatMark },
+        { "slur", &MEIInput::ReadSlur },
+        { "staff", &MEIInput::ReadStaff },
+        { "tempo", &MEIInput::ReadTempo },
+        { "tie", &MEIInput::ReadTie },
+        { "trill", &MEIInput::ReadTrill },
+        { "turn", &MEIInput::ReadTurn },
+    };
+
     assert(dynamic_cast<Measure *>(parent) || dynamic_cast<EditorialElement *>(parent));
 
     bool success = true;
@@ -5398,92 +5603,8 @@ bool MEIInput::ReadMeasureChildren(Object *parent, pugi::xml_node parentNode)
             success = this->ReadEditorialElement(parent, current, EDITORIAL_MEASURE);
         }
         // content
-        else if (currentName == "anchoredText") {
-            success = this->ReadAnchoredText(parent, current);
-        }
-        else if (currentName == "arpeg") {
-            success = this->ReadArpeg(parent, current);
-        }
-        else if (currentName == "beamSpan") {
-            success = this->ReadBeamSpan(parent, current);
-        }
-        else if (currentName == "bracketSpan") {
-            success = this->ReadBracketSpan(parent, current);
-        }
-        else if (currentName == "breath") {
-            success = this->ReadBreath(parent, current);
-        }
-        else if (currentName == "caesura") {
-            success = this->ReadCaesura(parent, current);
-        }
-        else if (currentName == "dir") {
-            success = this->ReadDir(parent, current);
-        }
-        else if (currentName == "dynam") {
-            success = this->ReadDynam(parent, current);
-        }
-        else if (currentName == "fermata") {
-            success = this->ReadFermata(parent, current);
-        }
-        else if (currentName == "fing") {
-            success = this->ReadFing(parent, current);
-        }
-        else if (currentName == "gliss") {
-            success = this->ReadGliss(parent, current);
-        }
-        else if (currentName == "hairpin") {
-            success = this->ReadHairpin(parent, current);
-        }
-        else if (currentName == "harm") {
-            success = this->ReadHarm(parent, current);
-        }
-        else if (currentName == "lv") {
-            success = this->ReadLv(parent, current);
-        }
-        else if (currentName == "mNum") {
-            success = this->ReadMNum(parent, current);
-        }
-        else if (currentName == "mordent") {
-            success = this->ReadMordent(parent, current);
-        }
-        else if (currentName == "octave") {
-            success = this->ReadOctave(parent, current);
-        }
-        else if (currentName == "ornam") {
-            success = this->ReadOrnam(parent, current);
-        }
-        else if (currentName == "pedal") {
-            success = this->ReadPedal(parent, current);
-        }
-        else if (currentName == "phrase") {
-            success = this->ReadPhrase(parent, current);
-        }
-        else if (currentName == "pitchInflection") {
-            success = this->ReadPitchInflection(parent, current);
-        }
-        else if (currentName == "reh") {
-            success = this->ReadReh(parent, current);
-        }
-        else if (currentName == "repeatMark") {
-            success = this->ReadRepeatMark(parent, current);
-        }
-        else if (currentName == "slur") {
-            success = this->ReadSlur(parent, current);
-        }
-        else if (currentName == "staff") {
-            success = this->ReadStaff(parent, current);
-        }
-        else if (currentName == "tempo") {
-            success = this->ReadTempo(parent, current);
-        }
-        else if (currentName == "tie") {
-            success = this->ReadTie(parent, current);
-        }
-        else if (currentName == "trill") {
-            success = this->ReadTrill(parent, current);
-        }
-        else if (currentName == "turn") {
-            success = this->ReadTurn(parent, current);
+        else if (auto reader = measureReaders.find(currentName); reader != measureReaders.end()) {
+            success = (this->*(reader->second))(parent, current);
         }
         else if (currentName == "tupletSpan") {
             if (!ReadTupletSpanAsTuplet(dynamic_cast<Measure *>(parent), current)) {
@@ -6131,6 +6252,53 @@ bool MEIInput::ReadLayer(Object *parent, pugi::xml_node layer)
 
 bool MEIInput::ReadLayerChildren(Object *parent, pugi::xml_node parentNode, Object *filter)
 {
+    // The reading method of each element within <layer> without specific handling
+    static const std::unordered_map<std::string, ElementReader> layerReaders = {
+        { "accid", &MEIInput::ReadAccid },
+        { "artic", &MEIInput::ReadArtic },
+        { "barLine", &MEIInput::ReadBarLine },
+        { "beam", &MEIInput::ReadBeam },
+        { "beatRpt", &MEIInput::ReadBeatRpt },
+        { "bTrem", &MEIInput::ReadBTrem },
+        { "chord", &MEIInput::ReadChord },
+        { "clef", &MEIInput::ReadClef },
+        { "custos", &MEIInput::ReadCustos },
+        { "divLine", &MEIInput::ReadDivLine },
+        { "dot", &MEIInput::ReadDot },
+        { "fTrem", &MEIInput::ReadFTrem },
+        { "graceGrp", &MEIInput::ReadGraceGrp },
+        { "halfmRpt", &MEIInput::ReadHalfmRpt },
+        { "keyAccid", &MEIInput::ReadKeyAccid },
+        { "keySig", &MEIInput::ReadKeySig },
+        { "label", &MEIInput::ReadLabel },
+        { "labelAbbr", &MEIInput::ReadLabelAbbr },
+        { "ligature", &MEIInput::ReadLigature },
+        { "liquescent", &MEIInput::ReadLiquescent },
+        { "mensur", &MEIInput::ReadMensur },
+        { "meterSig", &MEIInput::ReadMeterSig },
+        { "meterSigGrp", &MEIInput::ReadMeterSigGrp },
+        { "nc", &MEIInput::ReadNc },
+        { "neume", &MEIInput::ReadNeume },
+        { "note", &MEIInput::ReadNote },
+        { "rest", &MEIInput::ReadRest },
+        { "mRest", &MEIInput::ReadMRest },
+        { "mRpt", &MEIInput::ReadMRpt },
+        { "mRpt2", &MEIInput::ReadMRpt2 },
+        { "mSpace", &MEIInput::ReadMSpace },
+        { "multiRest", &MEIInput::ReadMultiRest },
+        { "multiRpt", &MEIInput::ReadMultiRpt },
+        { "plica", &MEIInput::ReadPlica },
+        { "proport", &MEIInput::ReadProport },
+        { "space", &MEIInput::ReadSpace },
+        { "stem", &MEIInput::ReadStem },
+        { "syl", &MEIInput::ReadSyl },
+        { "syllable", &MEIInput::ReadSyllable },
+        { "tabDurSym", &MEIInput::ReadTabDurSym },
+        { "tabGrp", &MEIInput::ReadTabGrp },
+        { "tuplet", &MEIInput::ReadTuplet },
+        { "verse", &MEIInput::ReadVerse },
+    };
+
     bool success = true;
     pugi::xml_node xmlElement;
     std::string elementName;
@@ -6148,138 +6316,12 @@ bool MEIInput::ReadLayerChildren(Object *parent, pugi::xml_node parentNode, Obje
             continue;
         }
         // editorial
-        else if (this->IsEditorialElementName(xmlElement.name())) {
+        else if (this->IsEditorialElementName(elementName)) {
             success = this->ReadEditorialElement(parent, xmlElement, EDITORIAL_LAYER, filter);
         }
         // content
-        else if (elementName == "accid") {
-            success = this->ReadAccid(parent, xmlElement);
-        }
-        else if (elementName == "artic") {
-            success = this->ReadArtic(parent, xmlElement);
-        }
-        else if (elementName == "barLine") {
-            success = this->ReadBarLine(parent, xmlElement);
-        }
-        else if (elementName == "beam") {
-            success = this->ReadBeam(parent, xmlElement);
-        }
-        else if (elementName == "beatRpt") {
-            success = this->ReadBeatRpt(parent, xmlElement);
-        }
-        else if (elementName == "bTrem") {
-            success = this->ReadBTrem(parent, xmlElement);
-        }
-        else if (elementName == "chord") {
-            success = this->ReadChord(parent, xmlElement);
-        }
-        else if (elementName == "clef") {
-            success = this->ReadClef(parent, xmlElement);
-        }
-        else if (elementName == "custos") {
-            success = this->ReadCustos(parent, xmlElement);
-        }
-        else if (elementName == "divLine") {
-            success = this->ReadDivLine(parent, xmlElement);
-        }
-        else if (elementName == "dot") {
-            success = this->ReadDot(parent, xmlElement);
-        }
-        else if (elementName == "fTrem") {
-            success = this->ReadFTrem(parent, xmlElement);
-        }
-        else if (elementName == "graceGrp") {
-            success = this->ReadGraceGrp(parent, xmlElement);
-        }
-        else if (elementName == "halfmRpt") {
-            success = this->ReadHalfmRpt(parent, xmlElement);
-        }
-        else if (elementName == "keyAccid") {
-            success = this->ReadKeyAccid(parent, xmlElement);
-        }
-        else if (elementName == "keySig") {
-            success = this->ReadKeySig(parent, xmlElement);
-        }
-        else if (elementName == "label") {
-            success = this->ReadLabel(parent, xmlElement);
-        }
-        else if (elementName == "labelAbbr") {
-            success = this->ReadLabelAbbr(parent, xmlElement);
-        }
-        else if (elementName == "ligature") {
-            success = this->ReadLigature(parent, xmlElement);
-        }
-        else if (elementName == "liquescent") {
-            success = this->ReadLiquescent(parent, xmlElement);
-        }
-        else if (elementName == "mensur") {
-            success = this->ReadMensur(parent, xmlElement);
-        }
-        else if (elementName == "meterSig") {
-            success = this->ReadMeterSig(parent, xmlElement);
-        }
-        else if (elementName == "meterSigGrp") {
-            success = this->ReadMeterSigGrp(parent, xmlElement);
-        }
-        else if (elementName == "nc") {
-            success = this->ReadNc(parent, xmlElement);
-        }
-        else if (elementName == "neume") {
-            success = this->ReadNeume(parent, xmlElement);
-        }
-        else if (elementName == "note") {
-            success = this->ReadNote(parent, xmlElement);
-        }
-        else if (elementName == "rest") {
-            success = this->ReadRest(parent, xmlElement);
-        }
-        else if (elementName == "mRest") {
-            success = this->ReadMRest(parent, xmlElement);
-        }
-        else if (elementName == "mRpt") {
-            success = this->ReadMRpt(parent, xmlElement);
-        }
-        else if (elementName == "mRpt2") {
-            success = this->ReadMRpt2(parent, xmlElement);
-        }
-        else if (elementName == "mSpace") {
-            success = this->ReadMSpace(parent, xmlElement);
-        }
-        else if (elementName == "multiRest") {
-            success = this->ReadMultiRest(parent, xmlElement);
-        }
-        else if (elementName == "multiRpt") {
-            success = this->ReadMultiRpt(parent, xmlElement);
-        }
-        else if (elementName == "plica") {
-            success = this->ReadPlica(parent, xmlElement);
-        }
-        else if (elementName == "proport") {
-            success = this->ReadProport(parent, xmlElement);
-        }
-        else if (elementName == "space") {
-            success = this->ReadSpace(parent, xmlElement);
-        }
-        else if (elementName == "stem") {
-            success = this->ReadStem(parent, xmlElement);
-        }
-        else if (elementName == "syl") {
-            success = this->ReadSyl(parent, xmlElement);
-        }
-        else if (elementName == "syllable") {
-            success = this->ReadSyllable(parent, xmlElement);
-        }
-        else if (elementName == "tabDurSym") {
-            success = this->ReadTabDurSym(parent, xmlElement);
-        }
-        else if (elementName == "tabGrp") {
-            success = this->ReadTabGrp(parent, xmlElement);
-        }
-        else if (elementName == "tuplet") {
-            success = this->ReadTuplet(parent, xmlElement);
-        }
-        else if (elementName == "verse") {
-            success = this->ReadVerse(parent, xmlElement);
+        else if (auto reader = layerReaders.find(elementName); reader != layerReaders.end()) {
+            success = (this->*(reader->second))(parent, xmlElement);
         }
         // xml comment
         else if (elementName == "") {
@@ -8092,6 +8134,7 @@ void MEIInput::SetMeiID(pugi::xml_node element, Object *object)
 
     object->SetID(element.attribute("xml:id").value());
     element.remove_attribute("xml:id");
+    if (m_objectsWithMeiID) m_objectsWithMeiID->insert(object);
 }
 
 DocType MEIInput::StrToDocType(std::string type)
@@ -8133,7 +8176,7 @@ bool MEIInput::ReadXMLComment(Object *object, pugi::xml_node element)
     return true;
 }
 
-bool MEIInput::IsEditorialElementName(std::string elementName)
+bool MEIInput::IsEditorialElementName(const std::string &elementName)
 {
     auto i = std::find(MEIInput::s_editorialElementNames.begin(), MEIInput::s_editorialElementNames.end(), elementName);
     if (i != MEIInput::s_editorialElementNames.end()) return true;
@@ -788,7 +788,7 @@ void MusicXmlInput::PrintMetronome(pugi::xml_node metronome, Tempo *tempo)
                 std::string matches("0123456789");
                 std::size_t offset = iter->second.find_first_of(matches);
                 if (offset < iter->second.length()) {
-                    const double mmval = std::stod(iter->second.substr(offset));
+                    const double mmval = StringToDouble(iter->second.substr(offset));
                     tempo->SetMm(mmval);
                 }
                 if (!iter->second.empty()) {
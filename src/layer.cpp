@@ -353,7 +353,7 @@ data_STEMDIRECTION Layer::GetDrawingStemDir(const ArrayOfBeamElementCoords *coor
     double duration = 0.0;
     // For the sake of counting number of layers consider only current measure. If first and last elements' layers are
     // different, take only time within current measure to run GetLayerCountInTimeSpan.
-    const Measure *lastMeasure = vrv_cast<const Measure *>(last->GetFirstAncestor(MEASURE));
+    const Measure *lastMeasure = last->GetAncestorMeasure();
     if (lastMeasure == measure) {
         duration = alignmentLast->GetTime() - time + last->GetAlignmentDuration();
     }
@@ -57,6 +57,7 @@
 #include "stem.h"
 #include "syl.h"
 #include "syllable.h"
+#include "system.h"
 #include "tabgrp.h"
 #include "tie.h"
 #include "timeinterface.h"
@@ -144,6 +145,12 @@ void LayerElement::Reset()
     m_crossLayer = NULL;
 
     m_isInBeamspan = false;
+
+    m_cachedLayer = NULL;
+    m_cachedStaff = NULL;
+    m_cachedMeasure = NULL;
+    m_cachedSystem = NULL;
+    m_cachedParent = NULL;
 }
 
 LayerElement::~LayerElement() {}
@@ -264,7 +271,7 @@ int LayerElement::GetOriginalLayerN() const
 {
     int layerN = this->GetAlignmentLayerN();
     if (layerN < 0) {
-        layerN = vrv_cast<const Layer *>(this->GetFirstAncestor(LAYER))->GetN();
+        layerN = this->GetAncestorLayer()->GetN();
     }
     return layerN;
 }
@@ -292,11 +299,81 @@ const Staff *LayerElement::GetAncestorStaff(const StaffSearch strategy, const bo
         const Layer *layer = NULL;
         staff = this->GetCrossStaff(layer);
     }
-    if (!staff) staff = vrv_cast<const Staff *>(this->GetFirstAncestor(STAFF));
+    if (!staff) {
+        staff = (this->HasCachedAncestors()) ? m_cachedStaff : vrv_cast<const Staff *>(this->GetFirstAncestor(STAFF));
+    }
     if (assertExistence) assert(staff);
     return staff;
 }
 
+Layer *LayerElement::GetAncestorLayer()
+{
+    return const_cast<Layer *>(std::as_const(*this).GetAncestorLayer());
+}
+
+const Layer *LayerElement::GetAncestorLayer() const
+{
+    if (this->HasCachedAncestors()) return m_cachedLayer;
+    return vrv_cast<const Layer *>(this->GetFirstAncestor(LAYER));
+}
+
+Measure *LayerElement::GetAncestorMeasure()
+{
+    return const_cast<Measure *>(std::as_const(*this).GetAncestorMeasure());
+}
+
+const Measure *LayerElement::GetAncestorMeasure() const
+{
+    if (this->HasCachedAncestors()) return m_cachedMeasure;
+    return vrv_cast<const Measure *>(this->GetFirstAncestor(MEASURE));
+}
+
+System *LayerElement::GetAncestorSystem()
+{
+    return const_cast<System *>(std::as_const(*this).GetAncestorSystem());
+}
+
+const System *LayerElement::GetAncestorSystem() const
+{
+    if (this->HasCachedAncestors()) return m_cachedSystem;
+    return vrv_cast<const System *>(this->GetFirstAncestor(SYSTEM));
+}
+
+void LayerElement::CacheAncestors()
+{
+    m_cachedLayer = NULL;
+    m_cachedStaff = NULL;
+    m_cachedMeasure = NULL;
+    m_cachedSystem = NULL;
+    // Same as GetFirstAncestor for each of them, but in a single walk
+    for (Object *ancestor = this->GetParent(); ancestor; ancestor = ancestor->GetParent()) {
+        switch (ancestor->GetClassId()) {
+            case LAYER:
+                if (!m_cachedLayer) m_cachedLayer = vrv_cast<Layer *>(ancestor);
+                break;
+            case STAFF:
+                if (!m_cachedStaff) m_cachedStaff = vrv_cast<Staff *>(ancestor);
+                break;
+            case MEASURE:
+                if (!m_cachedMeasure) m_cachedMeasure = vrv_cast<Measure *>(ancestor);
+                break;
+            case SYSTEM:
+                if (!m_cachedSystem) m_cachedSystem = vrv_cast<System *>(ancestor);
+                break;
+            default: break;
+        }
+        if (m_cachedSystem) break;
+    }
+    m_cachedParent = this->GetParent();
+}
+
+void LayerElement::ResetCachedAncestors()
+{
+    m_cachedParent = NULL;
+
+    Object::ResetCachedAncestors();
+}
+
 Staff *LayerElement::GetCrossStaff(Layer *&layer)
 {
     const Layer *layerRef = NULL;
@@ -413,7 +490,7 @@ int LayerElement::GetDrawingX() const
     if (!m_alignment) {
         // assert(this->Is({ BEAM, FTREM, TUPLET }));
         // Here we just get the measure position - no cast to Measure is necessary
-        const Object *measure = this->GetFirstAncestor(MEASURE);
+        const Object *measure = this->GetAncestorMeasure();
         assert(measure);
         m_cachedDrawingX = measure->GetDrawingX();
         return m_cachedDrawingX;
@@ -428,7 +505,7 @@ int LayerElement::GetDrawingX() const
     }
 
     // Otherwise get the measure - no cast to Measure is necessary
-    const Object *measure = this->GetFirstAncestor(MEASURE);
+    const Object *measure = this->GetAncestorMeasure();
     assert(measure);
 
     int graceNoteShift = 0;
@@ -461,9 +538,9 @@ int LayerElement::GetDrawingY() const
     // (e.g. artic, syl)
     if (!object && !this->IsRelativeToStaff()) object = this->GetFirstAncestorInRange(LAYER_ELEMENT, LAYER_ELEMENT_max);
     // Otherwise get the first staff
-    if (!object) object = this->GetFirstAncestor(STAFF);
+    if (!object) object = this->GetAncestorStaff(ANCESTOR_ONLY, false);
     // Otherwise the first measure (this is the case with barLineAttr)
-    if (!object) object = this->GetFirstAncestor(MEASURE);
+    if (!object) object = this->GetAncestorMeasure();
 
     assert(object);
 
@@ -536,7 +613,7 @@ void LayerElement::CenterDrawingX()
 
     this->SetDrawingXRel(0);
 
-    Measure *measure = vrv_cast<Measure *>(this->GetFirstAncestor(MEASURE));
+    Measure *measure = this->GetAncestorMeasure();
     assert(measure);
 
     this->SetDrawingXRel(measure->GetInnerCenterX() - this->GetDrawingX());
@@ -894,7 +971,7 @@ MapOfDotLocs LayerElement::CalcOptimalDotLocations()
         return {};
     }
 
-    Layer *layer = vrv_cast<Layer *>(this->GetFirstAncestor(LAYER));
+    Layer *layer = this->GetAncestorLayer();
     const int layerCount = layer->GetLayerCountForTimeSpanOf(this);
 
     // Calculate primary/secondary dot locations
@@ -970,7 +1047,7 @@ MapOfDotLocs LayerElement::CalcOptimalDotLocations()
 
 int LayerElement::CalcLayerOverlap(const Doc *doc, int direction, int y1, int y2)
 {
-    Layer *parentLayer = vrv_cast<Layer *>(this->GetFirstAncestor(LAYER));
+    Layer *parentLayer = this->GetAncestorLayer();
     if (!parentLayer) return 0;
     // Check whether there are elements on other layer in the duration of the current beam. If there are none - stop
     // here, there's nothing to be done
@@ -47,7 +47,7 @@ bool Lv::CalculatePosition(const Doc *doc, const Staff *staff, int x1, int x2, i
 
     LayerElement *start = this->GetStart();
     LayerElement *end = this->GetEnd();
-    if (start->GetFirstAncestor(MEASURE) != end->GetFirstAncestor(MEASURE)) {
+    if (start->GetAncestorMeasure() != end->GetAncestorMeasure()) {
         //  this makes no sense
         LogWarning("Lv across measures is not supported. Use <tie> instead.");
         return false;
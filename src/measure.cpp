@@ -697,9 +697,9 @@ std::vector<std::pair<LayerElement *, LayerElement *>> Measure::GetInternalTieEn
         Tie *tie = vrv_cast<Tie *>(object);
         // If both start and end points of the tie are not within current measure - skip it
         LayerElement *start = tie->GetStart();
-        if (!start || (start->GetFirstAncestor(MEASURE) != this)) continue;
+        if (!start || (start->GetAncestorMeasure() != this)) continue;
         LayerElement *end = tie->GetEnd();
-        if (!end || (end->GetFirstAncestor(MEASURE) != this)) continue;
+        if (!end || (end->GetAncestorMeasure() != this)) continue;
         endpoints.emplace_back(start, end);
     }
 
@@ -949,30 +949,14 @@ void GenerateTimemapFunctor::AddTimemapEntry(const Object *object)
 
         /*********** start values ***********/
 
-        TimemapEntry &startEntry = m_timemap->GetEntry(realTimeStart);
-
-        // Should check if value for realTimeStart already exists and if so, then
-        // ensure that it is equal to scoreTimeStart:
-        startEntry.qstamp = scoreTimeStart;
-
-        // Store the element ID in list to turn on at given time - note or rest
-        if (!isRest) startEntry.notesOn.push_back(object->GetID());
-        if (isRest) startEntry.restsOn.push_back(object->GetID());
-
-        // Also add the tempo
-        startEntry.tempo = m_currentTempo;
+        // Store the element to turn on at given time - note or rest - with the tempo
+        m_timemap->AddEvent(
+            realTimeStart, scoreTimeStart, isRest ? TIMEMAP_restOn : TIMEMAP_noteOn, object, m_currentTempo);
 
         /*********** end values ***********/
 
-        TimemapEntry &endEntry = m_timemap->GetEntry(realTimeEnd);
-
-        // Should check if value for realTimeEnd already exists and if so, then
-        // ensure that it is equal to scoreTimeEnd:
-        endEntry.qstamp = scoreTimeEnd;
-
-        // Store the element ID in list to turn off at given time - notes or rest
-        if (!isRest) endEntry.notesOff.push_back(object->GetID());
-        if (isRest) endEntry.restsOff.push_back(object->GetID());
+        // Store the element to turn off at given time - notes or rest
+        m_timemap->AddEvent(realTimeEnd, scoreTimeEnd, isRest ? TIMEMAP_restOff : TIMEMAP_noteOff, object);
     }
     else if (object->Is(MEASURE)) {
 
@@ -983,14 +967,8 @@ void GenerateTimemapFunctor::AddTimemapEntry(const Object *object)
         double scoreTimeStart = m_scoreTimeOffset;
         double realTimeStart = round(m_realTimeOffsetMilliseconds);
 
-        TimemapEntry &startEntry = m_timemap->GetEntry(realTimeStart);
-
-        // Should check if value for realTimeStart already exists and if so, then
-        // ensure that it is equal to scoreTimeStart:
-        startEntry.qstamp = scoreTimeStart;
-
         // Add the measureOn
-        startEntry.measureOn = measure->GetID();
+        m_timemap->AddEvent(realTimeStart, scoreTimeStart, TIMEMAP_measureOn, measure);
     }
 }
 
@@ -75,6 +75,19 @@ FunctorCode ApplyPPUFactorFunctor::VisitSystem(System *system)
     return FUNCTOR_CONTINUE;
 }
 
+//----------------------------------------------------------------------------
+// CacheAncestorsFunctor
+//----------------------------------------------------------------------------
+
+CacheAncestorsFunctor::CacheAncestorsFunctor() : Functor() {}
+
+FunctorCode CacheAncestorsFunctor::VisitLayerElement(LayerElement *layerElement)
+{
+    layerElement->CacheAncestors();
+
+    return FUNCTOR_CONTINUE;
+}
+
 //----------------------------------------------------------------------------
 // GetAlignmentLeftRightFunctor
 //----------------------------------------------------------------------------
@@ -117,7 +130,7 @@ FunctorCode InitProcessingListsFunctor::VisitLayer(const Layer *layer)
 FunctorCode InitProcessingListsFunctor::VisitVerse(const Verse *verse)
 {
     const Staff *staff = verse->GetAncestorStaff();
-    const Layer *layer = vrv_cast<const Layer *>(verse->GetFirstAncestor(LAYER));
+    const Layer *layer = verse->GetAncestorLayer();
     assert(layer);
 
     m_verseTree.child[staff->GetN()].child[layer->GetN()].child[verse->GetN()];
@@ -191,7 +191,7 @@ void Note::AddChild(Object *child)
     else {
         children.push_back(child);
     }
-    Modify();
+    this->ModifyFor(child);
 }
 
 void Note::AlignDotsShift(const Note *otherNote)
@@ -365,7 +365,7 @@ int Note::GetDiatonicPitch() const
         // WARNING: Getting the correct clef loc offset does not work at an early stage of the processing.
         // It requires that m_drawingStaffDef is set on staff and that m_crossStaff + m_crossLayer are calculated.
         // However, in many cases we are only interested in a relative pitch value. Then this is still fine.
-        const Layer *layer = vrv_cast<const Layer *>(this->GetFirstAncestor(LAYER));
+        const Layer *layer = this->GetAncestorLayer();
         const LayerElement *layerElementY = this;
         if (m_crossStaff && m_crossLayer) {
             layerElementY = m_crossLayer->GetAtPos(this->GetDrawingX());
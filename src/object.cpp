@@ -41,6 +41,7 @@
 #include "note.h"
 #include "page.h"
 #include "plistinterface.h"
+#include "profiler.h"
 #include "resetfunctor.h"
 #include "savefunctor.h"
 #include "score.h"
@@ -739,10 +740,10 @@ bool Object::DeleteChild(Object *child)
     auto it = std::find(m_children.begin(), m_children.end(), child);
     if (it != m_children.end()) {
         m_children.erase(it);
+        this->ModifyFor(child);
         if (!m_isReferenceObject) {
             delete child;
         }
-        this->Modify();
         return true;
     }
     else {
@@ -783,6 +784,23 @@ void Object::SetParent(Object *parent)
 {
     assert(!m_parent);
     m_parent = parent;
+    this->ResetCachedAncestors();
+}
+
+void Object::ResetParent()
+{
+    m_parent = NULL;
+    this->ResetCachedAncestors();
+}
+
+void Object::ResetCachedAncestors()
+{
+    // The children of a reference object have their own parent
+    if (m_isReferenceObject) return;
+
+    for (Object *child : m_children) {
+        child->ResetCachedAncestors();
+    }
 }
 
 bool Object::IsSupportedChild(Object *child)
@@ -820,7 +838,7 @@ void Object::AddChild(Object *child)
         i = std::min(i, (int)m_children.size());
         m_children.insert(m_children.begin() + i, child);
     }
-    Modify();
+    this->ModifyFor(child);
 }
 
 int Object::GetInsertOrderForIn(ClassId classId, const std::vector<ClassId> &order) const
@@ -894,6 +912,23 @@ void Object::Modify(bool modified) const
     m_isModified = modified;
 }
 
+void Object::ModifyFor(const Object *child) const
+{
+    assert(child);
+
+    if (!child->Is({ DOTS, FLAG, STEM, TUPLET_BRACKET, TUPLET_NUM })) {
+        this->Modify();
+        return;
+    }
+
+    // Skip the objects for which the drawing part does not change the flat list
+    for (const Object *object = this; object; object = object->m_parent) {
+        const ObjectListInterface *listInterface = dynamic_cast<const ObjectListInterface *>(object);
+        if (listInterface && !listInterface->IncludesDrawingParts()) continue;
+        object->m_isModified = true;
+    }
+}
+
 void Object::FillFlatList(ListOfConstObjects &flatList) const
 {
     AddToFlatListFunctor addToFlatList(&flatList);
@@ -1014,9 +1049,17 @@ bool Object::HasNonEditorialContent()
 
 void Object::Process(Functor &functor, int deepness, bool skipFirst)
 {
+    // Record the outermost call in the profiler
+    if (!functor.IsProcessing()) {
+        ProfilerFunctor profilerFunctor(functor);
+        this->Process(functor, deepness, skipFirst);
+        return;
+    }
+
     if (functor.GetCode() == FUNCTOR_STOP) {
         return;
     }
+    functor.IncrementVisitCount();
 
     if (!skipFirst) {
         FunctorCode code = this->Accept(functor);
@@ -1068,9 +1111,17 @@ void Object::Process(Functor &functor, int deepness, bool skipFirst)
 
 void Object::Process(ConstFunctor &functor, int deepness, bool skipFirst) const
 {
+    // Record the outermost call in the profiler
+    if (!functor.IsProcessing()) {
+        ProfilerFunctor profilerFunctor(functor);
+        this->Process(functor, deepness, skipFirst);
+        return;
+    }
+
     if (functor.GetCode() == FUNCTOR_STOP) {
         return;
     }
+    functor.IncrementVisitCount();
 
     if (!skipFirst) {
         FunctorCode code = this->Accept(functor);
@@ -1217,6 +1268,8 @@ void Object::SeedID(uint32_t seed)
         // Deterministic start ID
         s_xmlIDCounter = Hash(seed);
     }
+    // Do not seed the counter again when the first object of the thread is created
+    if (s_objectCounter == 0) s_objectCounter = 1;
 }
 
 std::string Object::GenerateHashID()
@@ -1226,6 +1279,21 @@ std::string Object::GenerateHashID()
     return BaseEncodeInt(nr, 36);
 }
 
+void Object::SetIDCounter(uint32_t counter)
+{
+    s_xmlIDCounter = counter;
+    // Do not seed the counter when the first object is created
+    if (s_objectCounter == 0) s_objectCounter = 1;
+}
+
+bool Object::GetHashIDCounter(const std::string &hashID, uint32_t &counter)
+{
+    uint32_t nr;
+    if (!BaseDecodeInt(hashID, 36, nr)) return false;
+    counter = Hash(nr, true);
+    return true;
+}
+
 uint32_t Object::Hash(uint32_t number, bool reverse)
 {
     const uint32_t magicNumber = reverse ? 0x119de1f3 : 0x45d9f3b;
@@ -1303,11 +1371,11 @@ bool Object::sortByUlx(Object *a, Object *b)
 bool Object::IsPreOrdered(const Object *left, const Object *right)
 {
     ListOfConstObjects ancestorsLeft = left->GetAncestors();
-    ancestorsLeft.push_front(left);
+    ancestorsLeft.insert(ancestorsLeft.begin(), left);
     // Check if right is an ancestor of left
     if (std::find(ancestorsLeft.begin(), ancestorsLeft.end(), right) != ancestorsLeft.end()) return false;
     ListOfConstObjects ancestorsRight = right->GetAncestors();
-    ancestorsRight.push_front(right);
+    ancestorsRight.insert(ancestorsRight.begin(), right);
     // Check if left is an ancestor of right
     if (std::find(ancestorsRight.begin(), ancestorsRight.end(), left) != ancestorsRight.end()) return true;
 
@@ -1363,6 +1431,7 @@ ListOfObjects ObjectListInterface::GetList()
 {
     this->ResetList();
     ListOfObjects result;
+    result.reserve(m_list.size());
     std::transform(m_list.begin(), m_list.end(), std::back_inserter(result),
         [](const Object *obj) { return const_cast<Object *>(obj); });
     return result;
@@ -329,7 +329,7 @@ bool OptionDbl::SetValue(const std::string &value)
         return false;
     }
     // Convert string to double
-    double number = std::strtod(value.c_str(), NULL);
+    double number = StringToDouble(value);
 
     // Check bounds and set the value
     return this->SetValue(number);
@@ -975,6 +975,41 @@ Options::Options()
     m_standardOutput.SetShortOption(' ', true);
     m_baseOptions.AddOption(&m_standardOutput);
 
+    m_server.SetInfo("Server mode",
+        "Process requests given as JSON objects on the standard input (one per line) and write one JSON response per "
+        "line on the standard output");
+    m_server.Init(false);
+    m_server.SetKey("server");
+    m_server.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_server);
+
+    m_serverSocket.SetInfo("Server socket", "Path to a Unix socket on which the server mode listens for requests");
+    m_serverSocket.Init("");
+    m_serverSocket.SetKey("serverSocket");
+    m_serverSocket.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_serverSocket);
+
+    m_profile.SetInfo("Profile", "Write the time spent in each stage and functor as JSON on the standard error");
+    m_profile.Init(false);
+    m_profile.SetKey("profile");
+    m_profile.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_profile);
+
+    m_batch.SetInfo("Batch mode",
+        "Convert the files of a directory, of a pattern (e.g., \"scores/*.mei\") or listed in a manifest file to the "
+        "formats given with -t (e.g., \"svg,midi,timemap\") in the directory given with -o and write a summary as JSON "
+        "on the standard output");
+    m_batch.Init("");
+    m_batch.SetKey("batch");
+    m_batch.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_batch);
+
+    m_jobs.SetInfo("Jobs", "Number of files converted concurrently in batch mode (the number of cores by default)");
+    m_jobs.Init(0, 0, 1024);
+    m_jobs.SetKey("jobs");
+    m_jobs.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_jobs);
+
     m_help.SetInfo("Help", "Display this message");
     m_help.Init("");
     m_help.SetKey("help");
@@ -1026,8 +1061,8 @@ Options::Options()
 
     m_outputTo.SetInfo("Output to",
         "Select output format to: \"mei\", \"mei-pb\", \"mei-facs\", \"mei-basic\", \"svg\", \"midi\", \"timemap\", "
-        "\"expansionmap\", \"humdrum\" or "
-        "\"pae\"");
+        "\"expansionmap\", \"humdrum\", "
+        "\"pae\" or \"png\"");
     m_outputTo.Init("svg");
     m_outputTo.SetKey("outputTo");
     m_outputTo.SetShortOption('t', true);
@@ -1053,11 +1088,11 @@ Options::Options()
 
     m_adjustPageHeight.SetInfo("Adjust page height", "Adjust the page height to the height of the content");
     m_adjustPageHeight.Init(false);
-    this->Register(&m_adjustPageHeight, "adjustPageHeight", &m_general);
+    this->Register(&m_adjustPageHeight, "adjustPageHeight", &m_general, LAYOUT_STAGE_PAGES);
 
     m_adjustPageWidth.SetInfo("Adjust page width", "Adjust the page width to the width of the content");
     m_adjustPageWidth.Init(false);
-    this->Register(&m_adjustPageWidth, "adjustPageWidth", &m_general);
+    this->Register(&m_adjustPageWidth, "adjustPageWidth", &m_general, LAYOUT_STAGE_PAGES);
 
     m_breaks.SetInfo("Breaks", "Define page and system breaks layout");
     m_breaks.Init(BREAKS_auto, &Option::s_breaks);
@@ -1106,26 +1141,31 @@ Options::Options()
     m_humType.Init(false);
     this->Register(&m_humType, "humType", &m_general);
 
+    m_importThreads.SetInfo(
+        "Import threads", "The number of threads for reading MEI measures concurrently (0 for one per core)");
+    m_importThreads.Init(0, 0, 256);
+    this->Register(&m_importThreads, "importThreads", &m_general, LAYOUT_STAGE_NONE);
+
     m_incip.SetInfo("Incip", "Read <incip> elements as data input");
     m_incip.Init(false);
     this->Register(&m_incip, "incip", &m_general);
 
     m_justifyVertically.SetInfo("Justify vertically", "Justify spacing vertically to fill the page");
     m_justifyVertically.Init(false);
-    this->Register(&m_justifyVertically, "justifyVertically", &m_general);
+    this->Register(&m_justifyVertically, "justifyVertically", &m_general, LAYOUT_STAGE_PAGES);
 
     m_landscape.SetInfo("Landscape orientation", "Swap the values for page height and page width");
     m_landscape.Init(false);
-    this->Register(&m_landscape, "landscape", &m_general);
+    this->Register(&m_landscape, "landscape", &m_general, LAYOUT_STAGE_SYSTEMS);
 
     m_minLastJustification.SetInfo("Minimum last-system-justification width",
         "The last system is only justified if the unjustified width is greater than this percent");
     m_minLastJustification.Init(0.8, 0.0, 1.0);
-    this->Register(&m_minLastJustification, "minLastJustification", &m_general);
+    this->Register(&m_minLastJustification, "minLastJustification", &m_general, LAYOUT_STAGE_PAGES);
 
     m_mmOutput.SetInfo("MM output", "Specify that the output in the SVG is given in mm (default is px)");
     m_mmOutput.Init(false);
-    this->Register(&m_mmOutput, "mmOutput", &m_general);
+    this->Register(&m_mmOutput, "mmOutput", &m_general, LAYOUT_STAGE_NONE);
 
     m_moveScoreDefinitionToStaff.SetInfo("Move score definition to staff",
         "Move score definition (clef, keySig, meterSig, etc.) from scoreDef to staffDef");
@@ -1138,7 +1178,7 @@ Options::Options()
 
     m_noJustification.SetInfo("No justification", "Do not justify the system");
     m_noJustification.Init(false);
-    this->Register(&m_noJustification, "noJustification", &m_general);
+    this->Register(&m_noJustification, "noJustification", &m_general, LAYOUT_STAGE_PAGES);
 
     m_openControlEvents.SetInfo("Open control event", "Render open control events");
     m_openControlEvents.Init(false);
@@ -1146,45 +1186,45 @@ Options::Options()
 
     m_outputIndent.SetInfo("Output indentation", "Output indentation value for MEI and SVG");
     m_outputIndent.Init(3, 1, 10);
-    this->Register(&m_outputIndent, "outputIndent", &m_general);
+    this->Register(&m_outputIndent, "outputIndent", &m_general, LAYOUT_STAGE_NONE);
 
     m_outputFormatRaw.SetInfo(
         "Raw formatting for MEI output", "Writes MEI out with no line indenting or non-content newlines.");
     m_outputFormatRaw.Init(false);
-    this->Register(&m_outputFormatRaw, "outputFormatRaw", &m_general);
+    this->Register(&m_outputFormatRaw, "outputFormatRaw", &m_general, LAYOUT_STAGE_NONE);
 
     m_outputIndentTab.SetInfo("Output indentation with tab", "Output indentation with tabulation for MEI and SVG");
     m_outputIndentTab.Init(false);
-    this->Register(&m_outputIndentTab, "outputIndentTab", &m_general);
+    this->Register(&m_outputIndentTab, "outputIndentTab", &m_general, LAYOUT_STAGE_NONE);
 
     m_outputSmuflXmlEntities.SetInfo(
         "Output SMuFL XML entities", "Output SMuFL characters as XML entities instead of hex byte codes ");
     m_outputSmuflXmlEntities.Init(false);
-    this->Register(&m_outputSmuflXmlEntities, "outputSmuflXmlEntities", &m_general);
+    this->Register(&m_outputSmuflXmlEntities, "outputSmuflXmlEntities", &m_general, LAYOUT_STAGE_NONE);
 
     m_pageHeight.SetInfo("Page height", "The page height");
     m_pageHeight.Init(2970, 100, 60000, true);
-    this->Register(&m_pageHeight, "pageHeight", &m_general);
+    this->Register(&m_pageHeight, "pageHeight", &m_general, LAYOUT_STAGE_PAGES);
 
     m_pageMarginBottom.SetInfo("Page bottom margin", "The page bottom margin");
     m_pageMarginBottom.Init(50, 0, 500, true);
-    this->Register(&m_pageMarginBottom, "pageMarginBottom", &m_general);
+    this->Register(&m_pageMarginBottom, "pageMarginBottom", &m_general, LAYOUT_STAGE_PAGES);
 
     m_pageMarginLeft.SetInfo("Page left margin", "The page left margin");
     m_pageMarginLeft.Init(50, 0, 500, true);
-    this->Register(&m_pageMarginLeft, "pageMarginLeft", &m_general);
+    this->Register(&m_pageMarginLeft, "pageMarginLeft", &m_general, LAYOUT_STAGE_SYSTEMS);
 
     m_pageMarginRight.SetInfo("Page right margin", "The page right margin");
     m_pageMarginRight.Init(50, 0, 500, true);
-    this->Register(&m_pageMarginRight, "pageMarginRight", &m_general);
+    this->Register(&m_pageMarginRight, "pageMarginRight", &m_general, LAYOUT_STAGE_SYSTEMS);
 
     m_pageMarginTop.SetInfo("Page top margin", "The page top margin");
     m_pageMarginTop.Init(50, 0, 500, true);
-    this->Register(&m_pageMarginTop, "pageMarginTop", &m_general);
+    this->Register(&m_pageMarginTop, "pageMarginTop", &m_general, LAYOUT_STAGE_PAGES);
 
     m_pageWidth.SetInfo("Page width", "The page width");
     m_pageWidth.Init(2100, 100, 100000, true);
-    this->Register(&m_pageWidth, "pageWidth", &m_general);
+    this->Register(&m_pageWidth, "pageWidth", &m_general, LAYOUT_STAGE_SYSTEMS);
 
     m_pedalStyle.SetInfo("Pedal style", "The global pedal style");
     m_pedalStyle.Init(PEDALSTYLE_NONE, &Option::s_pedalStyle);
@@ -1194,22 +1234,28 @@ Options::Options()
     m_preserveAnalyticalMarkup.Init(false);
     this->Register(&m_preserveAnalyticalMarkup, "preserveAnalyticalMarkup", &m_general);
 
+    m_progressiveLayout.SetInfo("Progressive layout",
+        "Lay out the pages only as far as needed for the pages being rendered (the page count is then not final)");
+    m_progressiveLayout.Init(false);
+    this->Register(&m_progressiveLayout, "progressiveLayout", &m_general);
+
     m_removeIds.SetInfo("Remove IDs in MEI", "Remove XML IDs in the MEI output that are not referenced");
     m_removeIds.Init(false);
-    this->Register(&m_removeIds, "removeIds", &m_general);
+    this->Register(&m_removeIds, "removeIds", &m_general, LAYOUT_STAGE_NONE);
 
     m_scaleToPageSize.SetInfo(
         "Scale to fit the page size", "Scale the content within the page instead of scaling the page itself");
     m_scaleToPageSize.Init(false);
-    this->Register(&m_scaleToPageSize, "scaleToPageSize", &m_general);
+    this->Register(&m_scaleToPageSize, "scaleToPageSize", &m_general, LAYOUT_STAGE_SYSTEMS);
 
-    m_setLocale.SetInfo("Set the global locale", "Changes the global locale to C (this is not thread-safe)");
+    m_setLocale.SetInfo("Set the global locale",
+        "Deprecated - numbers are always formatted and parsed with the C locale without changing the global locale");
     m_setLocale.Init(false);
-    this->Register(&m_setLocale, "setLocale", &m_general);
+    this->Register(&m_setLocale, "setLocale", &m_general, LAYOUT_STAGE_NONE);
 
     m_showRuntime.SetInfo("Show runtime on CLI", "Display the total runtime on command-line");
     m_showRuntime.Init(false);
-    this->Register(&m_showRuntime, "showRuntime", &m_general);
+    this->Register(&m_showRuntime, "showRuntime", &m_general, LAYOUT_STAGE_NONE);
 
     m_shrinkToFit.SetInfo("Shrink content to fit page", "Scale down page content to fit the page height if needed");
     m_shrinkToFit.Init(false);
@@ -1226,36 +1272,42 @@ Options::Options()
 
     m_svgBoundingBoxes.SetInfo("Svg bounding boxes viewbox on svg root", "Include bounding boxes in SVG output");
     m_svgBoundingBoxes.Init(false);
-    this->Register(&m_svgBoundingBoxes, "svgBoundingBoxes", &m_general);
+    this->Register(&m_svgBoundingBoxes, "svgBoundingBoxes", &m_general, LAYOUT_STAGE_PAGES);
 
     m_svgCss.SetInfo("SVG additional CSS", "CSS (as a string) to be added to the SVG output");
     m_svgCss.Init("");
-    this->Register(&m_svgCss, "svgCss", &m_general);
+    this->Register(&m_svgCss, "svgCss", &m_general, LAYOUT_STAGE_NONE);
 
     m_svgViewBox.SetInfo("Use viewbox on svg root", "Use viewBox on svg root element for easy scaling of document");
     m_svgViewBox.Init(false);
-    this->Register(&m_svgViewBox, "svgViewBox", &m_general);
+    this->Register(&m_svgViewBox, "svgViewBox", &m_general, LAYOUT_STAGE_NONE);
 
     m_svgHtml5.SetInfo("Output SVG for HTML5 embedding",
         "Write data-id and data-class attributes for JS usage and id clash avoidance");
     m_svgHtml5.Init(false);
-    this->Register(&m_svgHtml5, "svgHtml5", &m_general);
+    this->Register(&m_svgHtml5, "svgHtml5", &m_general, LAYOUT_STAGE_NONE);
 
     m_svgFormatRaw.SetInfo(
         "Raw formatting for SVG output", "Writes SVG out with no line indenting or non-content newlines");
     m_svgFormatRaw.Init(false);
-    this->Register(&m_svgFormatRaw, "svgFormatRaw", &m_general);
+    this->Register(&m_svgFormatRaw, "svgFormatRaw", &m_general, LAYOUT_STAGE_NONE);
 
     m_svgRemoveXlink.SetInfo("Remove xlink: from href attributes",
         "Removes the xlink: prefix on href attributes for compatibility with some newer browsers");
     m_svgRemoveXlink.Init(false);
-    this->Register(&m_svgRemoveXlink, "svgRemoveXlink", &m_general);
+    this->Register(&m_svgRemoveXlink, "svgRemoveXlink", &m_general, LAYOUT_STAGE_NONE);
+
+    m_svgCompact.SetInfo("Compact SVG output",
+        "Writes a smaller SVG with shared stroke styles in CSS classes, short number formatting, no anonymous empty "
+        "groups and raw formatting");
+    m_svgCompact.Init(false);
+    this->Register(&m_svgCompact, "svgCompact", &m_general, LAYOUT_STAGE_NONE);
 
     m_svgAdditionalAttribute.SetInfo("Add additional attribute in SVG",
         "Add additional attribute for graphical elements in SVG as \"data-*\", for "
         "example, \"note@pname\" would add a \"data-pname\" to all note elements");
     m_svgAdditionalAttribute.Init();
-    this->Register(&m_svgAdditionalAttribute, "svgAdditionalAttribute", &m_general);
+    this->Register(&m_svgAdditionalAttribute, "svgAdditionalAttribute", &m_general, LAYOUT_STAGE_NONE);
 
     m_unit.SetInfo("Unit", "The MEI unit (1⁄2 of the distance between the staff lines)");
     m_unit.Init(9.0, 4.5, 12.0, true);
@@ -1272,16 +1324,16 @@ Options::Options()
 
     m_usePgFooterForAll.SetInfo("Use PgFooter for all", "Use the pgFooter for all pages");
     m_usePgFooterForAll.Init(false);
-    this->Register(&m_usePgFooterForAll, "usePgFooterForAll", &m_general);
+    this->Register(&m_usePgFooterForAll, "usePgFooterForAll", &m_general, LAYOUT_STAGE_PAGES);
 
     m_usePgHeaderForAll.SetInfo("Use PgHeader for all", "Use the pgHeader for all pages");
     m_usePgHeaderForAll.Init(false);
-    this->Register(&m_usePgHeaderForAll, "usePgHeaderForAll", &m_general);
+    this->Register(&m_usePgHeaderForAll, "usePgHeaderForAll", &m_general, LAYOUT_STAGE_PAGES);
 
     m_xmlIdChecksum.SetInfo(
         "XML IDs based on checksum", "Seed the generator for XML IDs using the checksum of the input data");
     m_xmlIdChecksum.Init(false);
-    this->Register(&m_xmlIdChecksum, "xmlIdChecksum", &m_general);
+    this->Register(&m_xmlIdChecksum, "xmlIdChecksum", &m_general, LAYOUT_STAGE_DATA);
 
     /********* General layout *********/
 
@@ -1323,7 +1375,7 @@ Options::Options()
     m_breaksNoWidow.SetInfo(
         "Breaks no widow", "Prevent single measures on the last page by fitting it into previous system");
     m_breaksNoWidow.Init(false);
-    this->Register(&m_breaksNoWidow, "breaksNoWidow", &m_generalLayout);
+    this->Register(&m_breaksNoWidow, "breaksNoWidow", &m_generalLayout, LAYOUT_STAGE_SYSTEMS);
 
     // Optimized for five line staves
     constexpr double dashedBarLineLengthDefault = 8.0 / 7.0;
@@ -1337,7 +1389,7 @@ Options::Options()
 
     m_dynamDist.SetInfo("Dynam dist", "The default distance from the staff for dynamic marks");
     m_dynamDist.Init(1.0, 0.5, 16.0);
-    this->Register(&m_dynamDist, "dynamDist", &m_generalLayout);
+    this->Register(&m_dynamDist, "dynamDist", &m_generalLayout, LAYOUT_STAGE_VERTICAL);
 
     m_dynamSingleGlyphs.SetInfo("Dynam single glyphs", "Don't use SMuFL's predefined dynamics glyph combinations");
     m_dynamSingleGlyphs.Init(false);
@@ -1404,30 +1456,30 @@ Options::Options()
 
     m_harmDist.SetInfo("Harm dist", "The default distance from the staff of harmonic indications");
     m_harmDist.Init(1.0, 0.5, 16.0);
-    this->Register(&m_harmDist, "harmDist", &m_generalLayout);
+    this->Register(&m_harmDist, "harmDist", &m_generalLayout, LAYOUT_STAGE_VERTICAL);
 
     m_justificationStaff.SetInfo("Spacing staff justification", "The staff justification");
     m_justificationStaff.Init(1., 0., 10.);
-    this->Register(&m_justificationStaff, "justificationStaff", &m_generalLayout);
+    this->Register(&m_justificationStaff, "justificationStaff", &m_generalLayout, LAYOUT_STAGE_PAGES);
 
     m_justificationSystem.SetInfo("Spacing system justification", "The system spacing justification");
     m_justificationSystem.Init(1., 0., 10.);
-    this->Register(&m_justificationSystem, "justificationSystem", &m_generalLayout);
+    this->Register(&m_justificationSystem, "justificationSystem", &m_generalLayout, LAYOUT_STAGE_PAGES);
 
     m_justificationBracketGroup.SetInfo(
         "Spacing bracket group justification", "Space between staves inside a bracketed group justification");
     m_justificationBracketGroup.Init(1., 0., 10.);
-    this->Register(&m_justificationBracketGroup, "justificationBracketGroup", &m_generalLayout);
+    this->Register(&m_justificationBracketGroup, "justificationBracketGroup", &m_generalLayout, LAYOUT_STAGE_PAGES);
 
     m_justificationBraceGroup.SetInfo(
         "Spacing brace group justification", "Space between staves inside a braced group justification");
     m_justificationBraceGroup.Init(1., 0., 10.);
-    this->Register(&m_justificationBraceGroup, "justificationBraceGroup", &m_generalLayout);
+    this->Register(&m_justificationBraceGroup, "justificationBraceGroup", &m_generalLayout, LAYOUT_STAGE_PAGES);
 
     m_justificationMaxVertical.SetInfo("Maximum ratio of justifiable height for page",
         "Maximum ratio of justifiable height to page height that can be used for the vertical justification");
     m_justificationMaxVertical.Init(0.3, 0.0, 1.0);
-    this->Register(&m_justificationMaxVertical, "justificationMaxVertical", &m_generalLayout);
+    this->Register(&m_justificationMaxVertical, "justificationMaxVertical", &m_generalLayout, LAYOUT_STAGE_PAGES);
 
     m_ledgerLineThickness.SetInfo("Ledger line thickness", "The thickness of the ledger lines");
     m_ledgerLineThickness.Init(0.25, 0.10, 0.50);
@@ -1456,7 +1508,7 @@ Options::Options()
 
     m_lyricTopMinMargin.SetInfo("Lyric top min margin", "The minmal margin above the lyrics in MEI units");
     m_lyricTopMinMargin.Init(2.0, 0.0, 8.0);
-    this->Register(&m_lyricTopMinMargin, "lyricTopMinMargin", &m_generalLayout);
+    this->Register(&m_lyricTopMinMargin, "lyricTopMinMargin", &m_generalLayout, LAYOUT_STAGE_VERTICAL);
 
     m_lyricWordSpace.SetInfo("Lyric word space", "The lyric word space length");
     m_lyricWordSpace.Init(1.20, 0.00, 10.00);
@@ -1540,12 +1592,12 @@ Options::Options()
     m_spacingBraceGroup.SetInfo(
         "Spacing brace group", "Minimum space between staves inside a braced group in MEI units");
     m_spacingBraceGroup.Init(12, 0, 48);
-    this->Register(&m_spacingBraceGroup, "spacingBraceGroup", &m_generalLayout);
+    this->Register(&m_spacingBraceGroup, "spacingBraceGroup", &m_generalLayout, LAYOUT_STAGE_VERTICAL);
 
     m_spacingBracketGroup.SetInfo(
         "Spacing bracket group", "Minimum space between staves inside a bracketed group in MEI units");
     m_spacingBracketGroup.Init(12, 0, 48);
-    this->Register(&m_spacingBracketGroup, "spacingBracketGroup", &m_generalLayout);
+    this->Register(&m_spacingBracketGroup, "spacingBracketGroup", &m_generalLayout, LAYOUT_STAGE_VERTICAL);
 
     m_spacingDurDetection.SetInfo("Spacing dur detection", "Detect long duration for adjusting spacing");
     m_spacingDurDetection.Init(false);
@@ -1561,11 +1613,11 @@ Options::Options()
 
     m_spacingStaff.SetInfo("Spacing staff", "The staff minimal spacing in MEI units");
     m_spacingStaff.Init(12, 0, 48);
-    this->Register(&m_spacingStaff, "spacingStaff", &m_generalLayout);
+    this->Register(&m_spacingStaff, "spacingStaff", &m_generalLayout, LAYOUT_STAGE_VERTICAL);
 
     m_spacingSystem.SetInfo("Spacing system", "The system minimal spacing in MEI units");
     m_spacingSystem.Init(4, 0, 48);
-    this->Register(&m_spacingSystem, "spacingSystem", &m_generalLayout);
+    this->Register(&m_spacingSystem, "spacingSystem", &m_generalLayout, LAYOUT_STAGE_VERTICAL);
 
     m_staffLineWidth.SetInfo("Staff line width", "The staff line width in MEI units");
     m_staffLineWidth.Init(0.15, 0.10, 0.30);
@@ -1585,7 +1637,7 @@ Options::Options()
 
     m_systemMaxPerPage.SetInfo("Max. System per Page", "Maximum number of systems per page");
     m_systemMaxPerPage.Init(0, 0, 24);
-    this->Register(&m_systemMaxPerPage, "systemMaxPerPage", &m_generalLayout);
+    this->Register(&m_systemMaxPerPage, "systemMaxPerPage", &m_generalLayout, LAYOUT_STAGE_PAGES);
 
     m_textEnclosureThickness.SetInfo("Text box line thickness", "The thickness of the line text enclosing box");
     m_textEnclosureThickness.Init(0.2, 0.10, 0.80);
@@ -1630,52 +1682,52 @@ Options::Options()
         "\"./rdg[contains(@source, 'source-id')]\"; by default the <lem> or the "
         "first <rdg> is selected");
     m_appXPathQuery.Init();
-    this->Register(&m_appXPathQuery, "appXPathQuery", &m_selectors);
+    this->Register(&m_appXPathQuery, "appXPathQuery", &m_selectors, LAYOUT_STAGE_DATA);
 
     m_choiceXPathQuery.SetInfo("Choice xPath query",
         "Set the xPath query for selecting <choice> child elements, for "
         "example: \"./orig\"; by default the first child is selected");
     m_choiceXPathQuery.Init();
-    this->Register(&m_choiceXPathQuery, "choiceXPathQuery", &m_selectors);
+    this->Register(&m_choiceXPathQuery, "choiceXPathQuery", &m_selectors, LAYOUT_STAGE_DATA);
 
     m_loadSelectedMdivOnly.SetInfo(
         "Load selected Mdiv only", "Load only the selected mdiv; the content of the other is skipped");
     m_loadSelectedMdivOnly.Init(false);
-    this->Register(&m_loadSelectedMdivOnly, "loadSelectedMdivOnly", &m_selectors);
+    this->Register(&m_loadSelectedMdivOnly, "loadSelectedMdivOnly", &m_selectors, LAYOUT_STAGE_DATA);
 
     m_mdivAll.SetInfo("Mdiv all", "Load and render all <mdiv> elements in the MEI files");
     m_mdivAll.Init(false);
-    this->Register(&m_mdivAll, "mdivAll", &m_selectors);
+    this->Register(&m_mdivAll, "mdivAll", &m_selectors, LAYOUT_STAGE_DATA);
 
     m_mdivXPathQuery.SetInfo("Mdiv xPath query",
         "Set the xPath query for selecting the <mdiv> to be rendered; only one <mdiv> can be rendered");
     m_mdivXPathQuery.Init("");
-    this->Register(&m_mdivXPathQuery, "mdivXPathQuery", &m_selectors);
+    this->Register(&m_mdivXPathQuery, "mdivXPathQuery", &m_selectors, LAYOUT_STAGE_DATA);
 
     m_substXPathQuery.SetInfo("Subst xPath query",
         "Set the xPath query for selecting <subst> child elements, for "
         "example: \"./del\"; by default the first child is selected");
     m_substXPathQuery.Init();
-    this->Register(&m_substXPathQuery, "substXPathQuery", &m_selectors);
+    this->Register(&m_substXPathQuery, "substXPathQuery", &m_selectors, LAYOUT_STAGE_DATA);
 
     m_transpose.SetInfo("Transpose the content", "Transpose the entire content");
     m_transpose.Init("");
-    this->Register(&m_transpose, "transpose", &m_selectors);
+    this->Register(&m_transpose, "transpose", &m_selectors, LAYOUT_STAGE_DATA);
 
     m_transposeMdiv.SetInfo(
         "Transpose individual mdivs", "Json mapping the mdiv ids to the corresponding transposition");
     m_transposeMdiv.Init(JsonSource::String, "{}");
-    this->Register(&m_transposeMdiv, "transposeMdiv", &m_selectors);
+    this->Register(&m_transposeMdiv, "transposeMdiv", &m_selectors, LAYOUT_STAGE_DATA);
 
     m_transposeSelectedOnly.SetInfo(
         "Transpose selected only", "Transpose only the selected content and ignore unselected editorial content");
     m_transposeSelectedOnly.Init(false);
-    this->Register(&m_transposeSelectedOnly, "transposeSelectedOnly", &m_selectors);
+    this->Register(&m_transposeSelectedOnly, "transposeSelectedOnly", &m_selectors, LAYOUT_STAGE_DATA);
 
     m_transposeToSoundingPitch.SetInfo(
         "Transpose to sounding pitch", "Transpose to sounding pitch by evaluating @trans.semi");
     m_transposeToSoundingPitch.Init(false);
-    this->Register(&m_transposeToSoundingPitch, "transposeToSoundingPitch", &m_selectors);
+    this->Register(&m_transposeToSoundingPitch, "transposeToSoundingPitch", &m_selectors, LAYOUT_STAGE_DATA);
 
     /********* The layout margins by element *********/
 
@@ -1707,15 +1759,15 @@ Options::Options()
 
     m_bottomMarginHarm.SetInfo("Bottom margin harm", "The margin for harm in MEI units");
     m_bottomMarginHarm.Init(1.0, 0.0, 10.0);
-    this->Register(&m_bottomMarginHarm, "bottomMarginHarm", &m_elementMargins);
+    this->Register(&m_bottomMarginHarm, "bottomMarginHarm", &m_elementMargins, LAYOUT_STAGE_VERTICAL);
 
     m_bottomMarginOctave.SetInfo("Bottom margin octave", "The margin for octave in MEI units");
     m_bottomMarginOctave.Init(1.0, 0.0, 10.0);
-    this->Register(&m_bottomMarginOctave, "bottomMarginOctave", &m_elementMargins);
+    this->Register(&m_bottomMarginOctave, "bottomMarginOctave", &m_elementMargins, LAYOUT_STAGE_VERTICAL);
 
     m_bottomMarginPgHead.SetInfo("Bottom margin header", "The margin for header in MEI units");
     m_bottomMarginPgHead.Init(2.0, 0.0, 24.0);
-    this->Register(&m_bottomMarginPgHead, "bottomMarginHeader", &m_elementMargins);
+    this->Register(&m_bottomMarginPgHead, "bottomMarginHeader", &m_elementMargins, LAYOUT_STAGE_VERTICAL);
 
     /// custom left
 
@@ -1865,11 +1917,11 @@ Options::Options()
 
     m_topMarginHarm.SetInfo("Top margin harm", "The margin for harm in MEI units");
     m_topMarginHarm.Init(1.0, 0.0, 10.0);
-    this->Register(&m_topMarginHarm, "topMarginHarm", &m_elementMargins);
+    this->Register(&m_topMarginHarm, "topMarginHarm", &m_elementMargins, LAYOUT_STAGE_VERTICAL);
 
     m_topMarginPgFooter.SetInfo("Top margin footer", "The margin for footer in MEI units");
     m_topMarginPgFooter.Init(2.0, 0.0, 24.0);
-    this->Register(&m_topMarginPgFooter, "topMarginPgFooter", &m_elementMargins);
+    this->Register(&m_topMarginPgFooter, "topMarginPgFooter", &m_elementMargins, LAYOUT_STAGE_VERTICAL);
 
     /********* midi *********/
 
@@ -1879,11 +1931,11 @@ Options::Options()
 
     m_midiNoCue.SetInfo("MIDI playback of cue notes", "Skip cue notes in MIDI output");
     m_midiNoCue.Init(false);
-    this->Register(&m_midiNoCue, "midiNoCue", &m_midi);
+    this->Register(&m_midiNoCue, "midiNoCue", &m_midi, LAYOUT_STAGE_NONE);
 
     m_midiTempoAdjustment.SetInfo("MIDI tempo adjustment", "The MIDI tempo adjustment factor");
     m_midiTempoAdjustment.Init(1.0, 0.2, 4.0);
-    this->Register(&m_midiTempoAdjustment, "midiTempoAdjustment", &m_midi);
+    this->Register(&m_midiTempoAdjustment, "midiTempoAdjustment", &m_midi, LAYOUT_STAGE_NONE);
 
     /********* General *********/
 
@@ -2018,13 +2070,14 @@ void Options::Sync()
         [](const std::string &key) { LogError("Unsupported engraving default '%s'", key.c_str()); });
 }
 
-void Options::Register(Option *option, const std::string &key, OptionGrp *grp)
+void Options::Register(Option *option, const std::string &key, OptionGrp *grp, int layoutStages)
 {
     assert(option);
     assert(grp);
 
     m_items[key] = option;
     option->SetKey(key);
+    option->SetLayoutStages(layoutStages);
     grp->AddOption(option);
 }
 
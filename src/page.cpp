@@ -57,6 +57,7 @@
 #include "pages.h"
 #include "pgfoot.h"
 #include "pghead.h"
+#include "profiler.h"
 #include "resetfunctor.h"
 #include "score.h"
 #include "staff.h"
@@ -195,10 +196,16 @@ void Page::LayOut(bool force)
         return;
     }
 
-    this->LayOutHorizontally();
-    this->JustifyHorizontally();
-    this->LayOutVertically();
-    this->JustifyVertically();
+    {
+        ProfilerStage profilerStage("layOutHorizontally");
+        this->LayOutHorizontally();
+        this->JustifyHorizontally();
+    }
+    {
+        ProfilerStage profilerStage("layOutVertically");
+        this->LayOutVertically();
+        this->JustifyVertically();
+    }
 
     Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
     assert(doc);
@@ -227,6 +234,10 @@ void Page::LayOutTranscription(bool force)
     // Make sure we have the correct page
     assert(this == doc->GetDrawingPage());
 
+    // Cache the ancestors of the layer elements for the page content as it is now
+    CacheAncestorsFunctor cacheAncestors;
+    this->Process(cacheAncestors);
+
     // Reset the horizontal alignment
     ResetHorizontalAlignmentFunctor resetHorizontalAlignment;
     this->Process(resetHorizontalAlignment);
@@ -286,6 +297,10 @@ void Page::ResetAligners()
     // Make sure we have the correct page
     assert(this == doc->GetDrawingPage());
 
+    // Cache the ancestors of the layer elements for the page content as it is now
+    CacheAncestorsFunctor cacheAncestors;
+    this->Process(cacheAncestors);
+
     // Reset the horizontal alignment
     ResetHorizontalAlignmentFunctor resetHorizontalAlignment;
     this->Process(resetHorizontalAlignment);
@@ -477,6 +492,10 @@ void Page::LayOutVertically()
     // Make sure we have the correct page
     assert(this == doc->GetDrawingPage());
 
+    // Cache the ancestors of the layer elements for the page content as it is now
+    CacheAncestorsFunctor cacheAncestors;
+    this->Process(cacheAncestors);
+
     // Reset the vertical alignment
     ResetVerticalAlignmentFunctor resetVerticalAlignment;
     this->Process(resetVerticalAlignment);
@@ -739,30 +758,12 @@ int Page::GetContentWidth() const
 
 void Page::AdjustSylSpacingByVerse(const IntTree &verseTree, Doc *doc)
 {
-    IntTree_t::const_iterator staves;
-    IntTree_t::const_iterator layers;
-    IntTree_t::const_iterator verses;
-
     if (verseTree.child.empty()) return;
 
-    Filters filters;
-
     // Same for the lyrics, but Verse by Verse since Syl are TimeSpanningInterface elements for handling connectors
-    for (staves = verseTree.child.begin(); staves != verseTree.child.end(); ++staves) {
-        for (layers = staves->second.child.begin(); layers != staves->second.child.end(); ++layers) {
-            for (verses = layers->second.child.begin(); verses != layers->second.child.end(); ++verses) {
-                // Create ad comparison object for each type / @n
-                AttNIntegerComparison matchStaff(STAFF, staves->first);
-                AttNIntegerComparison matchLayer(LAYER, layers->first);
-                AttNIntegerComparison matchVerse(VERSE, verses->first);
-                filters = { &matchStaff, &matchLayer, &matchVerse };
-
-                AdjustSylSpacingFunctor adjustSylSpacing(doc);
-                adjustSylSpacing.SetFilters(&filters);
-                this->Process(adjustSylSpacing);
-            }
-        }
-    }
+    // The functor processes all the verses with a single traversal of the page
+    AdjustSylSpacingFunctor adjustSylSpacing(doc);
+    this->Process(adjustSylSpacing);
 }
 
 //----------------------------------------------------------------------------
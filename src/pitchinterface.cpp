@@ -159,7 +159,7 @@ int PitchInterface::CalcLoc(
         }
         else if (note->HasPname() && (note->HasOct() || note->HasOctDefault())) {
             int offset = layer->GetClefLocOffset(crossStaffElement);
-            const Layer *parentLayer = vrv_cast<const Layer *>(layerElement->GetFirstAncestor(LAYER));
+            const Layer *parentLayer = layerElement->GetAncestorLayer();
             if (parentLayer != layer) {
                 offset = parentLayer->GetCrossStaffClefLocOffset(layerElement, offset);
             }
@@ -70,7 +70,8 @@ FunctorCode PrepareDataInitializationFunctor::VisitDiv(Div *div)
 
 FunctorCode PrepareDataInitializationFunctor::VisitChord(Chord *chord)
 {
-    if (chord->HasEmptyList()) {
+    // Do not build the list here since the chord is marked as modified below anyway
+    if (!chord->FindDescendantByType(NOTE)) {
         LogWarning("Chord '%s' has no child note - a default note is added", chord->GetID().c_str());
         Note *rescueNote = new Note();
         chord->AddChild(rescueNote);
@@ -147,7 +148,7 @@ FunctorCode PrepareCueSizeFunctor::VisitLayerElement(LayerElement *layerElement)
 {
     if (layerElement->IsScoreDefElement()) return FUNCTOR_SIBLINGS;
 
-    Layer *currentLayer = vrv_cast<Layer *>(layerElement->GetFirstAncestor(LAYER));
+    Layer *currentLayer = layerElement->GetAncestorLayer();
     assert(currentLayer);
     if (currentLayer->GetCue() == BOOLEAN_true) {
         layerElement->SetDrawingCueSize(true);
@@ -252,7 +253,7 @@ FunctorCode PrepareCrossStaffFunctor::VisitLayerElement(LayerElement *layerEleme
         return FUNCTOR_CONTINUE;
     }
 
-    Layer *parentLayer = vrv_cast<Layer *>(layerElement->GetFirstAncestor(LAYER));
+    Layer *parentLayer = layerElement->GetAncestorLayer();
     assert(parentLayer);
     // Now try to get the corresponding layer - for now look for the same layer @n
     int layerN = parentLayer->GetN();
@@ -495,7 +496,7 @@ PreparePlistFunctor::PreparePlistFunctor() : Functor(), CollectAndProcess() {}
 
 void PreparePlistFunctor::InsertInterfaceIDPair(const std::string &elementID, PlistInterface *interface)
 {
-    m_interfaceIDPairs.push_back(std::make_pair(interface, elementID));
+    m_interfaceIDPairs.insert({ elementID, interface });
 }
 
 FunctorCode PreparePlistFunctor::VisitObject(Object *object)
@@ -510,14 +511,12 @@ FunctorCode PreparePlistFunctor::VisitObject(Object *object)
     else {
         if (!object->IsLayerElement()) return FUNCTOR_CONTINUE;
 
-        const std::string &id = object->GetID();
-        auto iter = std::find_if(m_interfaceIDPairs.begin(), m_interfaceIDPairs.end(),
-            [&id](const std::pair<PlistInterface *, std::string> &pair) { return (pair.second == id); });
-        if (iter != m_interfaceIDPairs.end()) {
-            // Set reference for matched pair and erase it from the list
-            iter->first->SetRef(object);
-            m_interfaceIDPairs.erase(iter);
+        // Set reference for matched pairs and erase them from the map
+        auto range = m_interfaceIDPairs.equal_range(object->GetID());
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            iter->second->SetRef(object);
         }
+        m_interfaceIDPairs.erase(range.first, range.second);
     }
 
     return FUNCTOR_CONTINUE;
@@ -1694,7 +1693,7 @@ FunctorCode PrepareFloatingGrpsFunctor::VisitMeasureEnd(Measure *measure)
     std::vector<Hairpin *>::iterator iter = m_hairpins.begin();
     while (iter != m_hairpins.end()) {
         assert((*iter)->GetEnd());
-        Measure *measureEnd = vrv_cast<Measure *>((*iter)->GetEnd()->GetFirstAncestor(MEASURE));
+        Measure *measureEnd = (*iter)->GetEnd()->GetAncestorMeasure();
         if (measureEnd == measure) {
             iter = m_hairpins.erase(iter);
         }
@@ -1776,7 +1775,7 @@ FunctorCode PrepareStaffCurrentTimeSpanningFunctor::VisitMeasureEnd(Measure *mea
             TimeSpanningInterface *interface = (*iter)->GetTimeSpanningInterface();
             assert(interface);
             if (interface->GetEnd()) {
-                endParent = vrv_cast<Measure *>(interface->GetEnd()->GetFirstAncestor(MEASURE));
+                endParent = interface->GetEnd()->GetAncestorMeasure();
             }
         }
         if (!endParent && (*iter)->HasInterface(INTERFACE_LINKING)) {
@@ -1786,7 +1785,7 @@ FunctorCode PrepareStaffCurrentTimeSpanningFunctor::VisitMeasureEnd(Measure *mea
                 // We should have one because we allow only control events (dir and dynam) to be linked as target
                 TimePointInterface *nextInterface = interface->GetNextLink()->GetTimePointInterface();
                 assert(nextInterface);
-                endParent = vrv_cast<Measure *>(nextInterface->GetStart()->GetFirstAncestor(MEASURE));
+                endParent = nextInterface->GetStart()->GetAncestorMeasure();
             }
         }
         assert(endParent);
@@ -1858,7 +1857,7 @@ FunctorCode PrepareBeamSpanElementsFunctor::VisitBeamSpan(BeamSpan *beamSpan)
 {
     if (!beamSpan->GetBeamedElements().empty() || !beamSpan->GetStart() || !beamSpan->GetEnd()) return FUNCTOR_CONTINUE;
 
-    Layer *layer = vrv_cast<Layer *>(beamSpan->GetStart()->GetFirstAncestor(LAYER));
+    Layer *layer = beamSpan->GetStart()->GetAncestorLayer();
     Staff *staff = vrv_cast<Staff *>(beamSpan->GetStart()->GetFirstAncestor(STAFF));
     if (!layer || !staff) return FUNCTOR_SIBLINGS;
 
@@ -1874,14 +1873,14 @@ FunctorCode PrepareBeamSpanElementsFunctor::VisitBeamSpan(BeamSpan *beamSpan)
         LayerElement *layerElem = vrv_cast<LayerElement *>(element);
         if (!layerElem) continue;
 
-        Measure *measure = vrv_cast<Measure *>(layerElem->GetFirstAncestor(MEASURE));
+        Measure *measure = layerElem->GetAncestorMeasure();
         if (!measure) continue;
         layerElem->SetIsInBeamSpan(true);
 
         Staff *elementStaff = vrv_cast<Staff *>(layerElem->GetFirstAncestor(STAFF));
         if (!elementStaff) continue;
         if (elementStaff->GetN() != staff->GetN()) {
-            Layer *elementLayer = vrv_cast<Layer *>(layerElem->GetFirstAncestor(LAYER));
+            Layer *elementLayer = layerElem->GetAncestorLayer();
             if (!elementStaff || !elementLayer) continue;
             layerElem->m_crossStaff = elementStaff;
             layerElem->m_crossLayer = elementLayer;
@@ -1910,8 +1909,8 @@ ArrayOfObjects PrepareBeamSpanElementsFunctor::GetBeamSpanElementList(
     ArrayOfObjects beamSpanElements(objects.begin(), objects.end());
     // If last element is not equal to the end, there is high chance that this beamSpan is cross-measure.
     // Look for the same N-staff N-layer in next measure and try finding end there
-    Measure *startMeasure = vrv_cast<Measure *>(beamSpan->GetStart()->GetFirstAncestor(MEASURE));
-    Measure *endMeasure = vrv_cast<Measure *>(beamSpan->GetEnd()->GetFirstAncestor(MEASURE));
+    Measure *startMeasure = beamSpan->GetStart()->GetAncestorMeasure();
+    Measure *endMeasure = beamSpan->GetEnd()->GetAncestorMeasure();
     Measure *nextMeasure = NULL;
     while ((beamSpanElements.back() != beamSpan->GetEnd()) && (startMeasure != endMeasure)) {
         Object *parent = startMeasure->GetParent();
@@ -0,0 +1,186 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        profiler.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "profiler.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <typeindex>
+#include <vector>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+//----------------------------------------------------------------------------
+
+#include "functor.h"
+#include "jsonxx.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace {
+
+    struct ProfilerRecord {
+        std::string m_name;
+        int m_calls = 0;
+        double m_milliseconds = 0.0;
+        long m_visits = 0;
+    };
+
+    struct ProfilerRecords {
+        // The stages in the order they were first recorded
+        std::vector<ProfilerRecord> m_stages;
+        // The functors by type
+        std::map<std::type_index, ProfilerRecord> m_functors;
+        // The objects visited by all the functors
+        long m_visits = 0;
+        // The functor type recorded last and its record, since the same functor is often processed repeatedly
+        const std::type_info *m_lastFunctorType = NULL;
+        ProfilerRecord *m_lastFunctorRecord = NULL;
+    };
+
+    thread_local ProfilerRecords profilerRecords;
+
+    double GetMilliseconds(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Return the class name of a functor type without the namespace
+    std::string GetFunctorName(const char *typeName)
+    {
+        std::string name = typeName;
+#ifdef __GNUG__
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(typeName, NULL, NULL, &status);
+        if (demangled && (status == 0)) name = demangled;
+        free(demangled);
+#else
+        // MSVC names are "class vrv::..."
+        if (name.starts_with("class ")) name.erase(0, 6);
+#endif
+        if (name.starts_with("vrv::")) name.erase(0, 5);
+        return name;
+    }
+
+    jsonxx::Object RecordToJson(const ProfilerRecord &record)
+    {
+        jsonxx::Object json;
+        json << "name" << record.m_name;
+        json << "calls" << record.m_calls;
+        json << "time" << record.m_milliseconds;
+        json << "visits" << record.m_visits;
+        return json;
+    }
+
+} // namespace
+
+//----------------------------------------------------------------------------
+// Profiler
+//----------------------------------------------------------------------------
+
+void Profiler::Reset()
+{
+    profilerRecords = ProfilerRecords();
+}
+
+void Profiler::AddFunctor(const std::type_info &functorType, double milliseconds, long visits)
+{
+    if (profilerRecords.m_lastFunctorType != &functorType) {
+        profilerRecords.m_lastFunctorType = &functorType;
+        profilerRecords.m_lastFunctorRecord = &profilerRecords.m_functors[std::type_index(functorType)];
+    }
+    ProfilerRecord *record = profilerRecords.m_lastFunctorRecord;
+    ++record->m_calls;
+    record->m_milliseconds += milliseconds;
+    record->m_visits += visits;
+    profilerRecords.m_visits += visits;
+}
+
+void Profiler::AddStage(const std::string &name, double milliseconds, long visits)
+{
+    std::vector<ProfilerRecord> &stages = profilerRecords.m_stages;
+    auto iter = std::find_if(
+        stages.begin(), stages.end(), [&name](const ProfilerRecord &record) { return (record.m_name == name); });
+    if (iter == stages.end()) {
+        stages.push_back({ name });
+        iter = stages.end() - 1;
+    }
+    ++iter->m_calls;
+    iter->m_milliseconds += milliseconds;
+    iter->m_visits += visits;
+}
+
+long Profiler::GetVisitCount()
+{
+    return profilerRecords.m_visits;
+}
+
+std::string Profiler::GetJson()
+{
+    jsonxx::Array stages;
+    for (const ProfilerRecord &record : profilerRecords.m_stages) {
+        stages << RecordToJson(record);
+    }
+
+    std::vector<ProfilerRecord> functorRecords;
+    for (const auto &[functorType, record] : profilerRecords.m_functors) {
+        functorRecords.push_back(record);
+        functorRecords.back().m_name = GetFunctorName(functorType.name());
+    }
+    std::stable_sort(functorRecords.begin(), functorRecords.end(),
+        [](const ProfilerRecord &a, const ProfilerRecord &b) { return (a.m_milliseconds > b.m_milliseconds); });
+    jsonxx::Array functors;
+    for (const ProfilerRecord &record : functorRecords) {
+        functors << RecordToJson(record);
+    }
+
+    jsonxx::Object json;
+    json << "stages" << stages;
+    json << "functors" << functors;
+    return json.json();
+}
+
+//----------------------------------------------------------------------------
+// ProfilerStage
+//----------------------------------------------------------------------------
+
+ProfilerStage::ProfilerStage(const std::string &name) : m_name(name)
+{
+    m_start = std::chrono::steady_clock::now();
+    m_startVisits = Profiler::GetVisitCount();
+}
+
+ProfilerStage::~ProfilerStage()
+{
+    Profiler::AddStage(m_name, GetMilliseconds(m_start), Profiler::GetVisitCount() - m_startVisits);
+}
+
+//----------------------------------------------------------------------------
+// ProfilerFunctor
+//----------------------------------------------------------------------------
+
+ProfilerFunctor::ProfilerFunctor(FunctorBase &functor) : m_functor(functor)
+{
+    m_functor.SetProcessing(true);
+    m_functor.ResetVisitCount();
+    m_start = std::chrono::steady_clock::now();
+}
+
+ProfilerFunctor::~ProfilerFunctor()
+{
+    m_functor.SetProcessing(false);
+    Profiler::AddFunctor(typeid(m_functor), GetMilliseconds(m_start), m_functor.GetVisitCount());
+}
+
+} // namespace vrv
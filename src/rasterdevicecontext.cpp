@@ -0,0 +1,1220 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        rasterdevicecontext.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "rasterdevicecontext.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+//----------------------------------------------------------------------------
+
+#include "atts_shared.h"
+#include "filereader.h"
+#include "glyph.h"
+#include "object.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// Stroke font for the text
+//----------------------------------------------------------------------------
+
+/**
+ * The strokes of the printable ASCII characters (from 0x21), drawn on a grid 4 units wide with the baseline at 2,
+ * the x-height at 6 and the cap height at 8. Each stroke is a polyline of "xy" points separated by spaces, and the
+ * strokes are separated by ';'. Characters without strokes are drawn as boxes.
+ */
+static const char *strokeFont[] = {
+    "28 24;22 23", // !
+    "18 16;38 36", // "
+    "15 45;13 43;17 11;37 31", // #
+    "47 38 18 07 06 15 35 44 43 32 12 03;29 21", // $
+    "02 48;07 17 18 08 07;33 43 42 32 33", // %
+    "", // &
+    "28 26", // '
+    "38 27 23 32", // (
+    "18 27 23 12", // )
+    "16 34;14 36", // *
+    "05 45;27 23", // +
+    "23 22 11", // ,
+    "05 35", // -
+    "22 23", // .
+    "02 48", // /
+    "12 03 07 18 38 47 43 32 12", // 0
+    "16 28 22;12 32", // 1
+    "07 18 38 47 46 02 42", // 2
+    "07 18 38 47 46 35 15;35 44 43 32 12 03", // 3
+    "32 38 04 44", // 4
+    "48 08 05 35 44 43 32 12 03", // 5
+    "47 38 18 07 03 12 32 43 44 35 15 04", // 6
+    "08 48 22", // 7
+    "15 06 07 18 38 47 46 35 15 04 03 12 32 43 44 35", // 8
+    "46 35 15 06 07 18 38 47 43 32 12", // 9
+    "22 23;25 26", // :
+    "25 26;23 22 11", // ;
+    "47 05 43", // <
+    "04 44;06 46", // =
+    "07 45 03", // >
+    "07 18 38 47 46 35 25 24;22 23", // ?
+    "", // @
+    "02 28 42;15 35", // A
+    "02 08 38 47 46 35 05;35 44 43 32 02", // B
+    "47 38 18 07 03 12 32 43", // C
+    "02 08 28 46 44 22 02", // D
+    "42 02 08 48;05 35", // E
+    "02 08 48;05 35", // F
+    "47 38 18 07 03 12 32 43 45 25", // G
+    "02 08;42 48;05 45", // H
+    "12 32;22 28;18 38", // I
+    "38 33 22 12 03", // J
+    "02 08;48 05;24 42", // K
+    "08 02 42", // L
+    "02 08 25 48 42", // M
+    "02 08 42 48", // N
+    "12 03 07 18 38 47 43 32 12", // O
+    "02 08 38 47 46 35 05", // P
+    "12 03 07 18 38 47 43 32 12;24 42", // Q
+    "02 08 38 47 46 35 05;25 42", // R
+    "47 38 18 07 06 15 35 44 43 32 12 03", // S
+    "08 48;28 22", // T
+    "08 03 12 32 43 48", // U
+    "08 22 48", // V
+    "08 12 25 32 48", // W
+    "02 48;08 42", // X
+    "08 25 48;25 22", // Y
+    "08 48 02 42", // Z
+    "38 18 12 32", // [
+    "08 42", // backslash
+    "18 38 32 12", // ]
+    "16 28 36", // ^
+    "01 41", // _
+    "28 37", // `
+    "16 36 45 42;44 14 03 12 32 43", // a
+    "08 02;05 16 36 45 43 32 12 03", // b
+    "45 36 16 05 03 12 32 43", // c
+    "48 42;45 36 16 05 03 12 32 43", // d
+    "04 44 45 36 16 05 03 12 32 43", // e
+    "38 28 17 12;06 36", // f
+    "44 33 13 04 05 16 36 45;46 41 30 10 01", // g
+    "08 02;05 16 36 45 42", // h
+    "26 22;28 29", // i
+    "26 21 10 00;28 29", // j
+    "08 02;03 36;14 42", // k
+    "28 23 32", // l
+    "06 02;05 16 25 22;25 36 45 42", // m
+    "06 02;05 16 36 45 42", // n
+    "12 03 05 16 36 45 43 32 12", // o
+    "06 00;05 16 36 45 43 32 12 03", // p
+    "46 40;45 36 16 05 03 12 32 43", // q
+    "06 02;04 16 36 45", // r
+    "45 36 16 05 14 34 43 32 12 03", // s
+    "28 23 32 42;16 36", // t
+    "06 03 12 32 43;46 42", // u
+    "06 22 46", // v
+    "06 12 24 32 46", // w
+    "06 42;02 46", // x
+    "06 24;46 10", // y
+    "06 46 02 42", // z
+    "38 27 26 15 24 23 32", // {
+    "29 21", // |
+    "18 27 26 35 24 23 12", // }
+    "05 16 34 45", // ~
+};
+
+//----------------------------------------------------------------------------
+// Static helpers for parsing the SVG path data of the glyphs
+//----------------------------------------------------------------------------
+
+static bool ReadPathNumber(const char *&data, double &value)
+{
+    while (*data && (isspace(*data) || (*data == ','))) ++data;
+    if (!*data || (isalpha(*data) && (*data != 'e') && (*data != 'E'))) return false;
+    char *end = NULL;
+    value = StringToDouble(data, &end);
+    if (end == data) return false;
+    data = end;
+    return true;
+}
+
+static void ParsePathData(const char *data, double units, bool flip, std::vector<RasterPathCommand> &commands)
+{
+    // Commands are stored in em units with the y-axis up
+    auto toEm = [units, flip](double x, double y) { return RasterPoint{ x / units, (flip ? y : -y) / units }; };
+
+    RasterPoint current = { 0.0, 0.0 };
+    RasterPoint start = { 0.0, 0.0 };
+    RasterPoint control = { 0.0, 0.0 };
+    char command = 0;
+    char previous = 0;
+
+    while (*data) {
+        while (*data && (isspace(*data) || (*data == ','))) ++data;
+        if (!*data) break;
+        if (isalpha(*data)) {
+            command = *data;
+            ++data;
+        }
+        else if (!command) {
+            // Invalid path data
+            return;
+        }
+        else if ((command == 'M') || (command == 'm')) {
+            // Implicit line-to after a move-to
+            command = (command == 'M') ? 'L' : 'l';
+        }
+
+        const bool relative = islower(command);
+        const double dx = relative ? current.x : 0.0;
+        const double dy = relative ? current.y : 0.0;
+        double v[7];
+        RasterPathCommand pathCommand;
+
+        switch (toupper(command)) {
+            case 'M':
+                if (!ReadPathNumber(data, v[0]) || !ReadPathNumber(data, v[1])) return;
+                current = start = { v[0] + dx, v[1] + dy };
+                pathCommand.m_type = 'M';
+                pathCommand.m_points[0] = toEm(current.x, current.y);
+                break;
+            case 'L':
+            case 'H':
+            case 'V':
+                if (toupper(command) == 'H') {
+                    if (!ReadPathNumber(data, v[0])) return;
+                    current.x = v[0] + dx;
+                }
+                else if (toupper(command) == 'V') {
+                    if (!ReadPathNumber(data, v[0])) return;
+                    current.y = v[0] + dy;
+                }
+                else {
+                    if (!ReadPathNumber(data, v[0]) || !ReadPathNumber(data, v[1])) return;
+                    current = { v[0] + dx, v[1] + dy };
+                }
+                pathCommand.m_type = 'L';
+                pathCommand.m_points[0] = toEm(current.x, current.y);
+                break;
+            case 'C':
+            case 'S': {
+                RasterPoint p1;
+                if (toupper(command) == 'C') {
+                    if (!ReadPathNumber(data, v[0]) || !ReadPathNumber(data, v[1])) return;
+                    p1 = { v[0] + dx, v[1] + dy };
+                }
+                else {
+                    // Reflection of the previous control point
+                    const bool isCubic = (toupper(previous) == 'C') || (toupper(previous) == 'S');
+                    p1 = isCubic ? RasterPoint{ 2 * current.x - control.x, 2 * current.y - control.y } : current;
+                }
+                for (int i = 2; i < 6; ++i) {
+                    if (!ReadPathNumber(data, v[i])) return;
+                }
+                control = { v[2] + dx, v[3] + dy };
+                current = { v[4] + dx, v[5] + dy };
+                pathCommand.m_type = 'C';
+                pathCommand.m_points[0] = toEm(p1.x, p1.y);
+                pathCommand.m_points[1] = toEm(control.x, control.y);
+                pathCommand.m_points[2] = toEm(current.x, current.y);
+                break;
+            }
+            case 'Q':
+            case 'T': {
+                if (toupper(command) == 'Q') {
+                    if (!ReadPathNumber(data, v[0]) || !ReadPathNumber(data, v[1])) return;
+                    control = { v[0] + dx, v[1] + dy };
+                }
+                else {
+                    const bool isQuad = (toupper(previous) == 'Q') || (toupper(previous) == 'T');
+                    control = isQuad ? RasterPoint{ 2 * current.x - control.x, 2 * current.y - control.y } : current;
+                }
+                if (!ReadPathNumber(data, v[2]) || !ReadPathNumber(data, v[3])) return;
+                current = { v[2] + dx, v[3] + dy };
+                pathCommand.m_type = 'Q';
+                pathCommand.m_points[0] = toEm(control.x, control.y);
+                pathCommand.m_points[1] = toEm(current.x, current.y);
+                break;
+            }
+            case 'A':
+                // Elliptical arcs are not used in the SMuFL fonts - approximate them with a line
+                for (int i = 0; i < 7; ++i) {
+                    if (!ReadPathNumber(data, v[i])) return;
+                }
+                current = { v[5] + dx, v[6] + dy };
+                pathCommand.m_type = 'L';
+                pathCommand.m_points[0] = toEm(current.x, current.y);
+                break;
+            case 'Z':
+                current = start;
+                pathCommand.m_type = 'Z';
+                break;
+            default: LogDebug("Unsupported path command '%c' in glyph", command); return;
+        }
+        commands.push_back(pathCommand);
+        previous = command;
+        // A close-path command is not repeated implicitly
+        if (toupper(command) == 'Z') command = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+// RasterDeviceContext
+//----------------------------------------------------------------------------
+
+RasterDeviceContext::RasterDeviceContext() : DeviceContext(RASTER_DEVICE_CONTEXT)
+{
+    m_originX = 0;
+    m_originY = 0;
+
+    m_pixelWidth = 0;
+    m_pixelHeight = 0;
+    m_pixelScale = 1.0;
+    m_pixelOffsetX = 0.0;
+    m_pixelOffsetY = 0.0;
+
+    m_backgroundColor = AxNONE;
+    m_facsimile = false;
+
+    m_textX = 0;
+    m_textY = 0;
+    m_textAlignment = HORIZONTALALIGNMENT_left;
+
+    // The root graphic - black as in the SVG definition-scale
+    m_graphicStack.push_back({ AxBLACK, true, 0.0, Point(0, 0) });
+
+    this->SetBrush(AxNONE, AxSOLID);
+    this->SetPen(AxNONE, 1, AxSOLID);
+}
+
+RasterDeviceContext::~RasterDeviceContext() {}
+
+int RasterDeviceContext::ParseColor(const std::string &color)
+{
+    std::string value;
+    for (char c : color) {
+        if (!isspace(c)) value.push_back(tolower(c));
+    }
+
+    if ((value.size() > 1) && (value[0] == '#')) {
+        const std::string hex = value.substr(1);
+        if (hex.find_first_not_of("0123456789abcdef") != std::string::npos) return AxNONE;
+        // #rgb and #rgba
+        if ((hex.size() == 3) || (hex.size() == 4)) {
+            const int rgb = (int)std::strtol(hex.substr(0, 3).c_str(), NULL, 16);
+            const int red = (rgb >> 8) & 0xF;
+            const int green = (rgb >> 4) & 0xF;
+            const int blue = rgb & 0xF;
+            return (red * 17) << 16 | (green * 17) << 8 | (blue * 17);
+        }
+        // #rrggbb and #rrggbbaa
+        if ((hex.size() == 6) || (hex.size() == 8)) {
+            return (int)std::strtol(hex.substr(0, 6).c_str(), NULL, 16);
+        }
+        return AxNONE;
+    }
+
+    int red, green, blue;
+    if ((sscanf(value.c_str(), "rgb(%d,%d,%d", &red, &green, &blue) == 3)
+        || (sscanf(value.c_str(), "rgba(%d,%d,%d", &red, &green, &blue) == 3)) {
+        red = std::clamp(red, 0, 255);
+        green = std::clamp(green, 0, 255);
+        blue = std::clamp(blue, 0, 255);
+        return red << 16 | green << 8 | blue;
+    }
+
+    static const std::map<std::string, int> namedColors = { { "black", 0x000000 }, { "silver", 0xC0C0C0 },
+        { "gray", 0x808080 }, { "grey", 0x808080 }, { "white", 0xFFFFFF }, { "maroon", 0x800000 }, { "red", 0xFF0000 },
+        { "purple", 0x800080 }, { "fuchsia", 0xFF00FF }, { "magenta", 0xFF00FF }, { "green", 0x008000 },
+        { "lime", 0x00FF00 }, { "olive", 0x808000 }, { "yellow", 0xFFFF00 }, { "navy", 0x000080 },
+        { "blue", 0x0000FF }, { "teal", 0x008080 }, { "aqua", 0x00FFFF }, { "cyan", 0x00FFFF },
+        { "orange", 0xFFA500 }, { "brown", 0xA52A2A }, { "pink", 0xFFC0CB }, { "darkgray", 0xA9A9A9 },
+        { "darkgrey", 0xA9A9A9 }, { "lightgray", 0xD3D3D3 }, { "lightgrey", 0xD3D3D3 } };
+    auto iter = namedColors.find(value);
+    return (iter != namedColors.end()) ? iter->second : AxNONE;
+}
+
+std::vector<uint8_t> RasterDeviceContext::GetRGBA() const
+{
+    // Convert back from pre-multiplied alpha
+    std::vector<uint8_t> rgba(m_pixels.size());
+    for (size_t i = 0; i + 3 < m_pixels.size(); i += 4) {
+        const int alpha = m_pixels[i + 3];
+        rgba[i + 3] = alpha;
+        if (alpha == 0) continue;
+        for (int c = 0; c < 3; ++c) {
+            rgba[i + c] = std::min(255, (m_pixels[i + c] * 255 + alpha / 2) / alpha);
+        }
+    }
+    return rgba;
+}
+
+std::vector<uint8_t> RasterDeviceContext::GetPNG() const
+{
+    if ((m_pixelWidth <= 0) || (m_pixelHeight <= 0)) return {};
+
+    const std::vector<uint8_t> rgba = this->GetRGBA();
+    return ZipFileWriter::EncodePNG(rgba.data(), m_pixelWidth, m_pixelHeight);
+}
+
+void RasterDeviceContext::SetBackground(int color, int style)
+{
+    m_backgroundColor = color;
+}
+
+void RasterDeviceContext::SetTextForeground(int color)
+{
+    m_brushStack.top().SetColor(color); // we use the brush color for text
+}
+
+void RasterDeviceContext::SetLogicalOrigin(int x, int y)
+{
+    m_originX = -x;
+    m_originY = -y;
+}
+
+Point RasterDeviceContext::GetLogicalOrigin()
+{
+    return Point(m_originX, m_originY);
+}
+
+RasterPoint RasterDeviceContext::ToPixel(double x, double y) const
+{
+    const RasterGraphic &graphic = m_graphicStack.back();
+    if (graphic.m_angle != 0.0) {
+        // Clockwise rotation with the y-axis down, as the SVG rotate transformation
+        const double angle = DegToRad(graphic.m_angle);
+        const double rx = x - graphic.m_rotationOrigin.x;
+        const double ry = y - graphic.m_rotationOrigin.y;
+        x = graphic.m_rotationOrigin.x + rx * cos(angle) - ry * sin(angle);
+        y = graphic.m_rotationOrigin.y + rx * sin(angle) + ry * cos(angle);
+    }
+    return { (x + m_originX) * m_pixelScale + m_pixelOffsetX, (y + m_originY) * m_pixelScale + m_pixelOffsetY };
+}
+
+double RasterDeviceContext::GetPenPixelWidth(int minWidth) const
+{
+    assert(!m_penStack.empty());
+
+    return std::max(m_penStack.top().GetWidth(), minWidth) * m_pixelScale;
+}
+
+int RasterDeviceContext::ResolveColor(int color) const
+{
+    return (color == AxNONE) ? m_graphicStack.back().m_color : color;
+}
+
+void RasterDeviceContext::PushGraphic()
+{
+    m_graphicStack.push_back(m_graphicStack.back());
+}
+
+void RasterDeviceContext::StartPage()
+{
+    // Same size as the SVG output
+    double width = (double)this->GetWidth() * this->GetUserScaleX();
+    double height = (double)this->GetHeight() * this->GetUserScaleY();
+    const auto [baseWidth, baseHeight] = this->GetBaseSize();
+    if (baseWidth && baseHeight) {
+        width = baseWidth;
+        height = baseHeight;
+    }
+    if ((width <= 0.0) || (height <= 0.0) || (width * height > RASTER_MAX_PIXELS)) {
+        LogError("The page of %gx%g pixels cannot be rasterized", width, height);
+        m_pixelWidth = 0;
+        m_pixelHeight = 0;
+        m_pixels.clear();
+        return;
+    }
+    m_pixelWidth = std::max(1, (int)std::ceil(width));
+    m_pixelHeight = std::max(1, (int)std::ceil(height));
+
+    // The definition-scale viewBox is fitted (and centered) into the image as with preserveAspectRatio
+    const double factor = (m_facsimile) ? 1.0 : DEFINITION_FACTOR;
+    const double viewWidth = std::max(1.0, this->GetWidth() * factor);
+    const double viewHeight = std::max(1.0, ((m_facsimile) ? this->GetHeight() : this->GetContentHeight()) * factor);
+    m_pixelScale = std::min(m_pixelWidth / viewWidth, m_pixelHeight / viewHeight);
+    m_pixelOffsetX = (m_pixelWidth - viewWidth * m_pixelScale) / 2.0;
+    m_pixelOffsetY = (m_pixelHeight - viewHeight * m_pixelScale) / 2.0;
+
+    m_pixels.assign((size_t)m_pixelWidth * m_pixelHeight * 4, 0);
+    if (m_backgroundColor != AxNONE) {
+        for (size_t i = 0; i < m_pixels.size(); i += 4) {
+            m_pixels[i] = (m_backgroundColor >> 16) & 255;
+            m_pixels[i + 1] = (m_backgroundColor >> 8) & 255;
+            m_pixels[i + 2] = m_backgroundColor & 255;
+            m_pixels[i + 3] = 255;
+        }
+    }
+}
+
+void RasterDeviceContext::EndPage() {}
+
+void RasterDeviceContext::StartGraphic(
+    Object *object, const std::string &gClass, const std::string &gId, GraphicID graphicID, bool prepend)
+{
+    this->PushGraphic();
+    RasterGraphic &graphic = m_graphicStack.back();
+    bool isResumable = false;
+
+    if (object->HasAttClass(ATT_COLOR)) {
+        AttColor *att = dynamic_cast<AttColor *>(object);
+        assert(att);
+        if (att->HasColor()) {
+            const int color = ParseColor(att->GetColor());
+            if (color != AxNONE) {
+                graphic.m_color = color;
+                isResumable = true;
+            }
+        }
+    }
+
+    if (object->HasAttClass(ATT_VISIBILITY)) {
+        AttVisibility *att = dynamic_cast<AttVisibility *>(object);
+        assert(att);
+        if (att->HasVisible()) {
+            graphic.m_visible = (att->GetVisible() != BOOLEAN_false);
+            isResumable = true;
+        }
+    }
+
+    if (isResumable && !gId.empty()) m_resumableGraphics[gId] = graphic;
+}
+
+void RasterDeviceContext::EndGraphic(Object *object, View *view)
+{
+    if (m_graphicStack.size() > 1) m_graphicStack.pop_back();
+}
+
+void RasterDeviceContext::StartCustomGraphic(const std::string &name, std::string gClass, std::string gId)
+{
+    this->PushGraphic();
+}
+
+void RasterDeviceContext::EndCustomGraphic()
+{
+    if (m_graphicStack.size() > 1) m_graphicStack.pop_back();
+}
+
+void RasterDeviceContext::SetCustomGraphicColor(const std::string &color)
+{
+    const int rgb = ParseColor(color);
+    if (rgb != AxNONE) m_graphicStack.back().m_color = rgb;
+}
+
+void RasterDeviceContext::ResumeGraphic(Object *object, std::string gId)
+{
+    auto iter = m_resumableGraphics.find(gId);
+    if (iter != m_resumableGraphics.end()) {
+        m_graphicStack.push_back(iter->second);
+    }
+    else {
+        this->PushGraphic();
+    }
+}
+
+void RasterDeviceContext::EndResumedGraphic(Object *object, View *view)
+{
+    if (m_graphicStack.size() > 1) m_graphicStack.pop_back();
+}
+
+void RasterDeviceContext::RotateGraphic(Point const &orig, double angle)
+{
+    RasterGraphic &graphic = m_graphicStack.back();
+    // As in the SVG output, only one rotation per graphic
+    if (graphic.m_angle != 0.0) return;
+
+    graphic.m_angle = angle;
+    graphic.m_rotationOrigin = orig;
+}
+
+void RasterDeviceContext::BlendPixel(int x, int y, int color, float alpha)
+{
+    uint8_t *pixel = &m_pixels[((size_t)y * m_pixelWidth + x) * 4];
+    const float inverse = 1.0f - alpha;
+    pixel[0] = (uint8_t)std::lround(((color >> 16) & 255) * alpha + pixel[0] * inverse);
+    pixel[1] = (uint8_t)std::lround(((color >> 8) & 255) * alpha + pixel[1] * inverse);
+    pixel[2] = (uint8_t)std::lround((color & 255) * alpha + pixel[2] * inverse);
+    pixel[3] = (uint8_t)std::lround(255.0f * alpha + pixel[3] * inverse);
+}
+
+void RasterDeviceContext::FillContours(const std::vector<RasterContour> &contours, int color, float opacity)
+{
+    if (m_pixels.empty() || (opacity <= 0.0f)) return;
+
+    struct Edge {
+        double x0, y0, x1, y1;
+        int direction;
+    };
+    std::vector<Edge> edges;
+
+    double minX = m_pixelWidth, minY = m_pixelHeight, maxX = 0.0, maxY = 0.0;
+    for (const RasterContour &contour : contours) {
+        const size_t size = contour.size();
+        if (size < 3) continue;
+        for (size_t i = 0; i < size; ++i) {
+            const RasterPoint &p = contour.at(i);
+            const RasterPoint &q = contour.at((i + 1) % size);
+            minX = std::min(minX, p.x);
+            maxX = std::max(maxX, p.x);
+            minY = std::min(minY, p.y);
+            maxY = std::max(maxY, p.y);
+            if (p.y == q.y) continue;
+            if (p.y < q.y) {
+                edges.push_back({ p.x, p.y, q.x, q.y, 1 });
+            }
+            else {
+                edges.push_back({ q.x, q.y, p.x, p.y, -1 });
+            }
+        }
+    }
+    if (edges.empty()) return;
+
+    const int rowStart = std::max(0, (int)std::floor(minY));
+    const int rowEnd = std::min(m_pixelHeight - 1, (int)std::floor(maxY));
+    const int colStart = std::max(0, (int)std::floor(minX));
+    const int colEnd = std::min(m_pixelWidth - 1, (int)std::floor(maxX));
+    if ((rowStart > rowEnd) || (colStart > colEnd)) return;
+
+    // Edges sorted by their top for skipping the ones below the current row
+    std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) { return a.y0 < b.y0; });
+
+    std::vector<float> coverage(colEnd - colStart + 2, 0.0f);
+    std::vector<std::pair<double, int>> crossings;
+    const float sampleWeight = 1.0f / RASTER_SUBSAMPLES;
+
+    auto addSpan = [&](double xa, double xb) {
+        xa = std::max(xa, (double)colStart);
+        xb = std::min(xb, (double)colEnd + 1.0);
+        if (xb <= xa) return;
+        const int ia = (int)xa;
+        const int ib = (int)xb;
+        if (ia == ib) {
+            coverage[ia - colStart] += (float)(xb - xa) * sampleWeight;
+            return;
+        }
+        coverage[ia - colStart] += (float)(ia + 1 - xa) * sampleWeight;
+        for (int i = ia + 1; i < ib; ++i) coverage[i - colStart] += sampleWeight;
+        if (ib <= colEnd) coverage[ib - colStart] += (float)(xb - ib) * sampleWeight;
+    };
+
+    for (int row = rowStart; row <= rowEnd; ++row) {
+        std::fill(coverage.begin(), coverage.end(), 0.0f);
+        bool hasCoverage = false;
+        for (int sample = 0; sample < RASTER_SUBSAMPLES; ++sample) {
+            const double y = row + (sample + 0.5) / RASTER_SUBSAMPLES;
+            crossings.clear();
+            for (const Edge &edge : edges) {
+                if (edge.y0 > y) break;
+                if (edge.y1 <= y) continue;
+                const double x = edge.x0 + (y - edge.y0) * (edge.x1 - edge.x0) / (edge.y1 - edge.y0);
+                crossings.push_back({ x, edge.direction });
+            }
+            if (crossings.size() < 2) continue;
+            std::sort(crossings.begin(), crossings.end());
+            int winding = 0;
+            double spanStart = 0.0;
+            for (const auto &[x, direction] : crossings) {
+                const int previous = winding;
+                winding += direction;
+                if ((previous == 0) && (winding != 0)) {
+                    spanStart = x;
+                }
+                else if ((previous != 0) && (winding == 0)) {
+                    addSpan(spanStart, x);
+                    hasCoverage = true;
+                }
+            }
+        }
+        if (!hasCoverage) continue;
+        for (int col = colStart; col <= colEnd; ++col) {
+            const float value = coverage[col - colStart];
+            if (value <= 0.0f) continue;
+            this->BlendPixel(col, row, color, std::min(value, 1.0f) * opacity);
+        }
+    }
+}
+
+void RasterDeviceContext::FlattenQuad(RasterContour &contour, const RasterPoint &p1, const RasterPoint &p2) const
+{
+    assert(!contour.empty());
+
+    const RasterPoint p0 = contour.back();
+    const double length = std::hypot(p1.x - p0.x, p1.y - p0.y) + std::hypot(p2.x - p1.x, p2.y - p1.y);
+    const int steps = std::clamp((int)std::ceil(length / 3.0), 1, 256);
+    for (int i = 1; i <= steps; ++i) {
+        const double t = (double)i / steps;
+        const double u = 1.0 - t;
+        contour.push_back({ u * u * p0.x + 2 * u * t * p1.x + t * t * p2.x, //
+            u * u * p0.y + 2 * u * t * p1.y + t * t * p2.y });
+    }
+}
+
+void RasterDeviceContext::FlattenCubic(
+    RasterContour &contour, const RasterPoint &p1, const RasterPoint &p2, const RasterPoint &p3) const
+{
+    assert(!contour.empty());
+
+    const RasterPoint p0 = contour.back();
+    const double length = std::hypot(p1.x - p0.x, p1.y - p0.y) + std::hypot(p2.x - p1.x, p2.y - p1.y)
+        + std::hypot(p3.x - p2.x, p3.y - p2.y);
+    const int steps = std::clamp((int)std::ceil(length / 3.0), 1, 256);
+    for (int i = 1; i <= steps; ++i) {
+        const double t = (double)i / steps;
+        const double u = 1.0 - t;
+        const double a = u * u * u;
+        const double b = 3 * u * u * t;
+        const double c = 3 * u * t * t;
+        const double d = t * t * t;
+        contour.push_back(
+            { a * p0.x + b * p1.x + c * p2.x + d * p3.x, a * p0.y + b * p1.y + c * p2.y + d * p3.y });
+    }
+}
+
+void RasterDeviceContext::AddDisc(std::vector<RasterContour> &contours, const RasterPoint &center, double radius) const
+{
+    if (radius <= 0.0) return;
+
+    const int steps = std::clamp((int)std::ceil(2 * M_PI * radius / 2.0), 8, 128);
+    RasterContour disc;
+    // Counter-clockwise (with the y-axis down) as the stroke segments in StrokeContour
+    for (int i = 0; i < steps; ++i) {
+        const double angle = -2 * M_PI * i / steps;
+        disc.push_back({ center.x + radius * cos(angle), center.y + radius * sin(angle) });
+    }
+    contours.push_back(disc);
+}
+
+void RasterDeviceContext::StrokeContour(const RasterContour &points, bool closed, double width, int lineCap,
+    int lineJoin, int dashLength, int gapLength, int color, float opacity)
+{
+    if ((width <= 0.0) || (points.size() < 2)) return;
+
+    RasterContour path = points;
+    if (closed) path.push_back(points.front());
+
+    // Split the path into dashes
+    std::vector<RasterContour> parts;
+    if (dashLength > 0) {
+        const double dash = dashLength * m_pixelScale;
+        const double gap = ((gapLength > 0) ? gapLength : dashLength) * m_pixelScale;
+        bool inDash = true;
+        double remaining = dash;
+        RasterContour part = { path.front() };
+        for (size_t i = 1; i < path.size(); ++i) {
+            RasterPoint p = path.at(i - 1);
+            const RasterPoint &q = path.at(i);
+            double length = std::hypot(q.x - p.x, q.y - p.y);
+            while (length > remaining) {
+                const double t = remaining / length;
+                p = { p.x + (q.x - p.x) * t, p.y + (q.y - p.y) * t };
+                length -= remaining;
+                if (inDash) {
+                    part.push_back(p);
+                    parts.push_back(part);
+                }
+                part = { p };
+                inDash = !inDash;
+                remaining = (inDash) ? dash : gap;
+            }
+            remaining -= length;
+            if (inDash) part.push_back(q);
+        }
+        if (inDash && (part.size() > 1)) parts.push_back(part);
+        closed = false;
+    }
+    else {
+        parts.push_back(path);
+    }
+
+    const double halfWidth = width / 2.0;
+    std::vector<RasterContour> contours;
+    for (const RasterContour &part : parts) {
+        const size_t count = part.size();
+        for (size_t i = 1; i < count; ++i) {
+            RasterPoint p = part.at(i - 1);
+            RasterPoint q = part.at(i);
+            const double length = std::hypot(q.x - p.x, q.y - p.y);
+            if (length < 1e-9) continue;
+            const double ux = (q.x - p.x) / length;
+            const double uy = (q.y - p.y) / length;
+            if ((lineCap == AxCAP_SQUARE) && !closed) {
+                if (i == 1) p = { p.x - ux * halfWidth, p.y - uy * halfWidth };
+                if (i == count - 1) q = { q.x + ux * halfWidth, q.y + uy * halfWidth };
+            }
+            // The normal is (-uy, ux) so that all the segments have the same orientation
+            const double nx = -uy * halfWidth;
+            const double ny = ux * halfWidth;
+            contours.push_back({ { p.x + nx, p.y + ny }, { q.x + nx, q.y + ny }, { q.x - nx, q.y - ny },
+                { p.x - nx, p.y - ny } });
+        }
+        // Joins are rounded (miter joins being approximated), except for thin lines
+        if ((lineJoin != AxJOIN_BEVEL) && (halfWidth > 0.5)) {
+            for (size_t i = 1; i + 1 < count; ++i) this->AddDisc(contours, part.at(i), halfWidth);
+            if (closed) this->AddDisc(contours, part.front(), halfWidth);
+        }
+        if ((lineCap == AxCAP_ROUND) && !closed) {
+            this->AddDisc(contours, part.front(), halfWidth);
+            this->AddDisc(contours, part.back(), halfWidth);
+        }
+    }
+
+    this->FillContours(contours, color, opacity);
+}
+
+void RasterDeviceContext::FillRectangle(int x, int y, int width, int height, int color, float opacity)
+{
+    const RasterContour rectangle = { this->ToPixel(x, y), this->ToPixel(x + width, y),
+        this->ToPixel(x + width, y + height), this->ToPixel(x, y + height) };
+    this->FillContours({ rectangle }, color, opacity);
+}
+
+const std::vector<RasterPathCommand> &RasterDeviceContext::GetGlyphOutline(const Glyph *glyph)
+{
+    assert(glyph);
+
+    auto iter = m_glyphOutlines.find(glyph);
+    if (iter != m_glyphOutlines.end()) return iter->second;
+
+    std::vector<RasterPathCommand> &outline = m_glyphOutlines[glyph];
+
+    double units = glyph->GetUnitsPerEm() / 10.0;
+    pugi::xml_document glyphDoc;
+    glyphDoc.load_string(glyph->GetXML().c_str());
+    pugi::xml_node symbol = glyphDoc.first_child();
+    if (symbol.attribute("viewBox")) {
+        std::istringstream viewBox(symbol.attribute("viewBox").value());
+        double minX, minY;
+        viewBox >> minX >> minY >> units;
+    }
+    if (units <= 0.0) units = 1000.0;
+
+    for (pugi::xml_node path : symbol.children("path")) {
+        // The glyph paths are flipped to the y-axis down of SVG with a scale(1,-1) transformation
+        const std::string transform = path.attribute("transform").value();
+        const bool flip = (transform.find("scale(1,-1)") != std::string::npos);
+        ParsePathData(path.attribute("d").value(), units, flip, outline);
+    }
+
+    return outline;
+}
+
+void RasterDeviceContext::FillGlyph(
+    const Glyph *glyph, int x, int y, int pointSize, double ratio, int color, float opacity)
+{
+    const std::vector<RasterPathCommand> &outline = this->GetGlyphOutline(glyph);
+    if (outline.empty() || (pointSize <= 0)) return;
+
+    const double scaleX = pointSize * ratio;
+    const double scaleY = pointSize;
+    auto toPixel = [&](const RasterPoint &point) { return this->ToPixel(x + point.x * scaleX, y - point.y * scaleY); };
+
+    std::vector<RasterContour> contours;
+    for (const RasterPathCommand &command : outline) {
+        switch (command.m_type) {
+            case 'M': contours.push_back({ toPixel(command.m_points[0]) }); break;
+            case 'L':
+                if (contours.empty()) contours.push_back({ toPixel(command.m_points[0]) });
+                contours.back().push_back(toPixel(command.m_points[0]));
+                break;
+            case 'Q':
+                if (contours.empty()) contours.push_back({ toPixel(command.m_points[0]) });
+                this->FlattenQuad(contours.back(), toPixel(command.m_points[0]), toPixel(command.m_points[1]));
+                break;
+            case 'C':
+                if (contours.empty()) contours.push_back({ toPixel(command.m_points[0]) });
+                this->FlattenCubic(contours.back(), toPixel(command.m_points[0]), toPixel(command.m_points[1]),
+                    toPixel(command.m_points[2]));
+                break;
+            default:
+                // Contours are closed implicitly
+                break;
+        }
+    }
+
+    this->FillContours(contours, color, opacity);
+}
+
+void RasterDeviceContext::DrawQuadBezierPath(Point bezier[3])
+{
+    if (!this->IsVisible()) return;
+
+    const Pen &pen = m_penStack.top();
+    RasterContour contour = { this->ToPixel(bezier[0].x, bezier[0].y) };
+    this->FlattenQuad(contour, this->ToPixel(bezier[1].x, bezier[1].y), this->ToPixel(bezier[2].x, bezier[2].y));
+    this->StrokeContour(contour, false, this->GetPenPixelWidth(0), AxCAP_ROUND, AxJOIN_ROUND, pen.GetDashLength(),
+        pen.GetGapLength(), this->ResolveColor(pen.GetColor()), pen.GetOpacity());
+}
+
+void RasterDeviceContext::DrawCubicBezierPath(Point bezier[4])
+{
+    if (!this->IsVisible()) return;
+
+    const Pen &pen = m_penStack.top();
+    RasterContour contour = { this->ToPixel(bezier[0].x, bezier[0].y) };
+    this->FlattenCubic(contour, this->ToPixel(bezier[1].x, bezier[1].y), this->ToPixel(bezier[2].x, bezier[2].y),
+        this->ToPixel(bezier[3].x, bezier[3].y));
+    this->StrokeContour(contour, false, this->GetPenPixelWidth(0), AxCAP_ROUND, AxJOIN_ROUND, pen.GetDashLength(),
+        pen.GetGapLength(), this->ResolveColor(pen.GetColor()), pen.GetOpacity());
+}
+
+void RasterDeviceContext::DrawCubicBezierPathFilled(Point bezier1[4], Point bezier2[4])
+{
+    if (!this->IsVisible()) return;
+
+    RasterContour contour = { this->ToPixel(bezier1[0].x, bezier1[0].y) };
+    this->FlattenCubic(contour, this->ToPixel(bezier1[1].x, bezier1[1].y), this->ToPixel(bezier1[2].x, bezier1[2].y),
+        this->ToPixel(bezier1[3].x, bezier1[3].y));
+    this->FlattenCubic(contour, this->ToPixel(bezier2[2].x, bezier2[2].y), this->ToPixel(bezier2[1].x, bezier2[1].y),
+        this->ToPixel(bezier2[0].x, bezier2[0].y));
+
+    // Filled with the color of the graphic and stroked with the pen, as in the SVG output
+    this->FillContours({ contour }, this->ResolveColor(AxNONE), 1.0f);
+    const Pen &pen = m_penStack.top();
+    this->StrokeContour(contour, true, this->GetPenPixelWidth(0), AxCAP_ROUND, AxJOIN_ROUND, 0, 0,
+        this->ResolveColor(pen.GetColor()), pen.GetOpacity());
+}
+
+void RasterDeviceContext::DrawCircle(int x, int y, int radius)
+{
+    this->DrawEllipse(x - radius, y - radius, 2 * radius, 2 * radius);
+}
+
+void RasterDeviceContext::DrawEllipse(int x, int y, int width, int height)
+{
+    this->DrawEllipticArc(x, y, width, height, 0.0, 360.0);
+}
+
+void RasterDeviceContext::DrawEllipticArc(int x, int y, int width, int height, double start, double end)
+{
+    if (!this->IsVisible()) return;
+
+    const double rx = width / 2.0;
+    const double ry = height / 2.0;
+    const double xc = x + rx;
+    const double yc = y + ry;
+    if (end <= start) end += 360.0;
+
+    // One point every 5 degrees at most, depending on the size in pixels
+    const double radius = std::max(std::abs(rx), std::abs(ry)) * m_pixelScale;
+    const double arc = end - start;
+    const int steps = std::clamp((int)std::ceil(DegToRad(arc) * radius / 2.0), 4, std::max(4, (int)(arc / 5.0)));
+    RasterContour contour;
+    for (int i = 0; i <= steps; ++i) {
+        const double angle = DegToRad(start + arc * i / steps);
+        contour.push_back(this->ToPixel(xc + rx * cos(angle), yc - ry * sin(angle)));
+    }
+
+    const bool isFull = (arc >= 360.0);
+    if (isFull) contour.pop_back();
+
+    const Pen &pen = m_penStack.top();
+    const Brush &brush = m_brushStack.top();
+    this->FillContours({ contour }, this->ResolveColor(AxNONE), brush.GetOpacity());
+    if (pen.GetWidth() > 0) {
+        this->StrokeContour(contour, isFull, this->GetPenPixelWidth(0), pen.GetLineCap(), pen.GetLineJoin(),
+            pen.GetDashLength(), pen.GetGapLength(), this->ResolveColor(pen.GetColor()), pen.GetOpacity());
+    }
+}
+
+void RasterDeviceContext::DrawLine(int x1, int y1, int x2, int y2)
+{
+    if (!this->IsVisible()) return;
+
+    const Pen &pen = m_penStack.top();
+    const RasterContour contour = { this->ToPixel(x1, y1), this->ToPixel(x2, y2) };
+    this->StrokeContour(contour, false, this->GetPenPixelWidth(1), pen.GetLineCap(), pen.GetLineJoin(),
+        pen.GetDashLength(), pen.GetGapLength(), this->ResolveColor(pen.GetColor()), pen.GetOpacity());
+}
+
+void RasterDeviceContext::DrawPolyline(int n, Point points[], int xOffset, int yOffset)
+{
+    if (!this->IsVisible()) return;
+
+    const Pen &pen = m_penStack.top();
+    if (pen.GetWidth() <= 0) return;
+
+    RasterContour contour;
+    for (int i = 0; i < n; ++i) {
+        contour.push_back(this->ToPixel(points[i].x + xOffset, points[i].y + yOffset));
+    }
+    this->StrokeContour(contour, false, this->GetPenPixelWidth(1), pen.GetLineCap(), pen.GetLineJoin(),
+        pen.GetDashLength(), pen.GetGapLength(), this->ResolveColor(pen.GetColor()), pen.GetOpacity());
+}
+
+void RasterDeviceContext::DrawPolygon(int n, Point points[], int xOffset, int yOffset)
+{
+    if (!this->IsVisible()) return;
+
+    RasterContour contour;
+    for (int i = 0; i < n; ++i) {
+        contour.push_back(this->ToPixel(points[i].x + xOffset, points[i].y + yOffset));
+    }
+
+    const Pen &pen = m_penStack.top();
+    const Brush &brush = m_brushStack.top();
+    this->FillContours({ contour }, this->ResolveColor(brush.GetColor()), brush.GetOpacity());
+    if (pen.GetWidth() > 0) {
+        this->StrokeContour(contour, true, this->GetPenPixelWidth(1), pen.GetLineCap(), pen.GetLineJoin(),
+            pen.GetDashLength(), pen.GetGapLength(), this->ResolveColor(pen.GetColor()), pen.GetOpacity());
+    }
+}
+
+void RasterDeviceContext::DrawRectangle(int x, int y, int width, int height)
+{
+    this->DrawRoundedRectangle(x, y, width, height, 0);
+}
+
+void RasterDeviceContext::DrawRoundedRectangle(int x, int y, int width, int height, int radius)
+{
+    if (!this->IsVisible()) return;
+
+    // negative heights or widths are normalized as in the SVG output
+    if (height < 0) {
+        height = -height;
+        y -= height;
+    }
+    if (width < 0) {
+        width = -width;
+        x -= width;
+    }
+
+    RasterContour contour;
+    const double r = std::min({ (double)radius, width / 2.0, height / 2.0 });
+    if (r > 0.0) {
+        // Quarter circles at the corners, clockwise from the top-right corner
+        const double centers[4][2] = { { x + width - r, y + r }, { x + width - r, y + height - r },
+            { x + r, y + height - r }, { x + r, y + r } };
+        for (int corner = 0; corner < 4; ++corner) {
+            for (int i = 0; i <= 6; ++i) {
+                const double angle = DegToRad(-90.0 + 90.0 * corner + 15.0 * i);
+                contour.push_back(
+                    this->ToPixel(centers[corner][0] + r * cos(angle), centers[corner][1] + r * sin(angle)));
+            }
+        }
+    }
+    else {
+        contour = { this->ToPixel(x, y), this->ToPixel(x + width, y), this->ToPixel(x + width, y + height),
+            this->ToPixel(x, y + height) };
+    }
+
+    const Pen &pen = m_penStack.top();
+    const Brush &brush = m_brushStack.top();
+    this->FillContours({ contour }, this->ResolveColor(brush.GetColor()), brush.GetOpacity());
+    if (pen.GetWidth() > 0) {
+        this->StrokeContour(contour, true, this->GetPenPixelWidth(1), pen.GetLineCap(), pen.GetLineJoin(),
+            pen.GetDashLength(), pen.GetGapLength(), this->ResolveColor(pen.GetColor()), pen.GetOpacity());
+    }
+}
+
+void RasterDeviceContext::StartText(int x, int y, data_HORIZONTALALIGNMENT alignment)
+{
+    m_textX = x;
+    m_textY = y;
+    m_textAlignment = alignment;
+    m_textRuns.clear();
+}
+
+void RasterDeviceContext::MoveTextTo(int x, int y, data_HORIZONTALALIGNMENT alignment)
+{
+    this->FlushTextLine();
+
+    m_textX = x;
+    m_textY = y;
+    if (alignment != HORIZONTALALIGNMENT_NONE) {
+        m_textAlignment = alignment;
+    }
+}
+
+void RasterDeviceContext::MoveTextVerticallyTo(int y)
+{
+    // Only the runs that follow are moved
+    m_textY = y;
+}
+
+void RasterDeviceContext::EndText()
+{
+    this->FlushTextLine();
+}
+
+void RasterDeviceContext::DrawText(
+    const std::string &text, const std::u32string &wtext, int x, int y, int width, int height)
+{
+    assert(m_fontStack.top());
+
+    const Resources *resources = this->GetResources();
+    assert(resources);
+
+    // An explicit position (without a bounding box) starts a new chunk of text, as with a <tspan> in SVG
+    const bool hasBox = (width != 0) && (height != 0) && (width != VRV_UNSET) && (height != VRV_UNSET);
+    if ((x != 0) && (y != 0) && (x != VRV_UNSET) && (y != VRV_UNSET) && !hasBox) {
+        this->FlushTextLine();
+        m_textX = x;
+        m_textY = y;
+    }
+
+    const FontInfo *font = m_fontStack.top();
+    if (font->GetPointSize() <= 0) return;
+
+    RasterTextRun run;
+    run.m_y = m_textY;
+    run.m_pointSize = font->GetPointSize();
+    run.m_color = this->ResolveColor(AxNONE);
+    run.m_opacity = (this->IsVisible()) ? 1.0f : 0.0f;
+    run.m_bold = (font->GetWeight() == FONTWEIGHT_bold);
+    run.m_italic = (font->GetStyle() == FONTSTYLE_italic) || (font->GetStyle() == FONTSTYLE_oblique);
+
+    const std::u32string str = (wtext.empty()) ? UTF8to32(text) : wtext;
+    const bool isSmufl = (font->GetSmuflFont() != SMUFL_NONE);
+    int advance = 0;
+    for (char32_t c : str) {
+        const Glyph *glyph = NULL;
+        bool outline = true;
+        bool draw = true;
+        if (isSmufl) {
+            glyph = resources->GetGlyph(c);
+            if (!glyph) continue;
+        }
+        else {
+            glyph = resources->GetTextGlyph(c);
+            outline = false;
+            if (!glyph) {
+                // Same fallbacks as in DeviceContext::GetTextExtent
+                glyph = resources->GetGlyph(c);
+                outline = (glyph != NULL);
+            }
+            if (!glyph) {
+                draw = ((c != U' ') && (c != U' '));
+                glyph = resources->GetTextGlyph((draw) ? U'o' : U'.');
+                if (!glyph) continue;
+            }
+        }
+
+        if ((font->GetLetterSpacing() != 0) && (advance > 0)) advance += font->GetLetterSpacing();
+        if (draw) run.m_glyphs.push_back({ glyph, advance, outline, c });
+
+        int gx, gy, w, h;
+        glyph->GetBoundingBox(gx, gy, w, h);
+        const int advX = (glyph->GetHorizAdvX() > 0) ? glyph->GetHorizAdvX() : w;
+        advance += (int)std::ceil((double)advX * run.m_pointSize / glyph->GetUnitsPerEm());
+    }
+    run.m_width = advance;
+
+    m_textRuns.push_back(run);
+}
+
+void RasterDeviceContext::StrokeTextGlyph(const RasterTextGlyph &textGlyph, const RasterTextRun &run, int x)
+{
+    int gx, gy, w, h;
+    textGlyph.m_glyph->GetBoundingBox(gx, gy, w, h);
+    const double scale = (double)run.m_pointSize / textGlyph.m_glyph->GetUnitsPerEm();
+    x += textGlyph.m_x;
+
+    // Text fonts have no outlines - draw a box for the characters without strokes
+    const char *strokes
+        = ((textGlyph.m_code > U' ') && (textGlyph.m_code < 0x7F)) ? strokeFont[textGlyph.m_code - 0x21] : "";
+    if (!*strokes) {
+        const int inset = (int)(w * scale / 8);
+        this->FillRectangle(x + (int)(gx * scale) + inset, run.m_y - (int)((gy + h) * scale),
+            std::max(1, (int)(w * scale) - 2 * inset), (int)(h * scale), run.m_color, 0.5f * run.m_opacity);
+        return;
+    }
+
+    // The grid is fitted into 3/4 of the width of the glyph box for some spacing, with the cap height of 2/3 of the
+    // font size
+    const double unitX = std::max(w, 1) * scale * 0.75 / 4.0;
+    const double unitY = run.m_pointSize / 9.0;
+    const double slant = (run.m_italic) ? 0.2 : 0.0;
+    const double left = x + (gx + w * 0.125) * scale;
+    const double width = run.m_pointSize * ((run.m_bold) ? 0.12 : 0.07) * m_pixelScale;
+
+    RasterContour contour;
+    for (const char *c = strokes;; c += 3) {
+        const double px = (c[0] - '0') * unitX;
+        const double py = (c[1] - '2') * unitY;
+        contour.push_back(this->ToPixel(left + px + py * slant, run.m_y - py));
+        if (c[2] == ' ') continue;
+        this->StrokeContour(
+            contour, false, width, AxCAP_ROUND, AxJOIN_ROUND, 0, 0, run.m_color, run.m_opacity);
+        contour.clear();
+        if (c[2] != ';') break;
+    }
+}
+
+void RasterDeviceContext::FlushTextLine()
+{
+    if (m_textRuns.empty()) return;
+
+    int width = 0;
+    for (const RasterTextRun &run : m_textRuns) width += run.m_width;
+
+    int x = m_textX;
+    if (m_textAlignment == HORIZONTALALIGNMENT_center) {
+        x -= width / 2;
+    }
+    else if (m_textAlignment == HORIZONTALALIGNMENT_right) {
+        x -= width;
+    }
+
+    for (const RasterTextRun &run : m_textRuns) {
+        if (run.m_opacity > 0.0f) {
+            for (const RasterTextGlyph &textGlyph : run.m_glyphs) {
+                if (textGlyph.m_outline) {
+                    this->FillGlyph(
+                        textGlyph.m_glyph, x + textGlyph.m_x, run.m_y, run.m_pointSize, 1.0, run.m_color, run.m_opacity);
+                    continue;
+                }
+                this->StrokeTextGlyph(textGlyph, run, x);
+            }
+        }
+        x += run.m_width;
+    }
+
+    m_textX = x;
+    m_textRuns.clear();
+}
+
+void RasterDeviceContext::DrawMusicText(const std::u32string &text, int x, int y, bool setSmuflGlyph)
+{
+    assert(m_fontStack.top());
+
+    const Resources *resources = this->GetResources();
+    assert(resources);
+
+    const FontInfo *font = m_fontStack.top();
+    int w, h, gx, gy;
+
+    for (char32_t c : text) {
+        const Glyph *glyph = resources->GetGlyph(c);
+        if (!glyph) {
+            continue;
+        }
+
+        if (this->IsVisible()) {
+            this->FillGlyph(glyph, x, y, font->GetPointSize(), font->GetWidthToHeightRatio(),
+                this->ResolveColor(AxNONE), 1.0f);
+        }
+
+        // Same advance as in the SVG output
+        if (glyph->GetHorizAdvX() > 0)
+            x += glyph->GetHorizAdvX() * font->GetPointSize() / glyph->GetUnitsPerEm();
+        else {
+            glyph->GetBoundingBox(gx, gy, w, h);
+            x += w * font->GetPointSize() / glyph->GetUnitsPerEm();
+        }
+    }
+}
+
+} // namespace vrv
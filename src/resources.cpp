@@ -57,6 +57,8 @@ Resources::Resources()
 {
     m_path = s_defaultPath;
     m_currentStyle = k_defaultStyle;
+    m_revision = 0;
+    m_smuflGlyphsRevision = -1;
 }
 
 Resources::~Resources() = default;
@@ -64,6 +66,7 @@ Resources::~Resources() = default;
 bool Resources::InitFonts()
 {
     m_loadedFonts.clear();
+    ++m_revision;
 
     // Font Bravura first. As it is expected to have always all symbols we build the code -> name table from it
     if (!LoadFont(BRAVURA)) LogError("Bravura font could not be loaded.");
@@ -109,6 +112,7 @@ bool Resources::SetFont(const std::string &fontName)
 
     m_defaultFontName = IsFontLoaded(fontName) ? fontName : LEIPZIG;
     m_currentFontName = m_defaultFontName;
+    ++m_revision;
 
     return true;
 }
@@ -153,17 +157,20 @@ bool Resources::LoadAll()
 bool Resources::SetFallback(const std::string &fontName)
 {
     m_fallbackFontName = fontName;
+    ++m_revision;
     return true;
 }
 
 bool Resources::SetCurrentFont(const std::string &fontName, bool allowLoading)
 {
     if (IsFontLoaded(fontName)) {
+        if (m_currentFontName != fontName) ++m_revision;
         m_currentFontName = fontName;
         return true;
     }
     else if (allowLoading && LoadFont(fontName)) {
         m_currentFontName = fontName;
+        ++m_revision;
         return true;
     }
     else {
@@ -209,6 +216,11 @@ pugi::xml_parse_result Resources::LoadFooter(pugi::xml_document &footerDoc) cons
 
 const Glyph *Resources::GetGlyph(char32_t smuflCode) const
 {
+    if ((smuflCode >= SMUFL_CODE_FIRST) && (smuflCode <= SMUFL_CODE_LAST)) {
+        if (m_smuflGlyphsRevision != m_revision) this->BuildSmuflGlyphTable();
+        return m_smuflGlyphs.at(smuflCode - SMUFL_CODE_FIRST);
+    }
+
     if (GetCurrentGlyphTable().contains(smuflCode)) {
         return &GetCurrentGlyphTable().at(smuflCode);
     }
@@ -231,6 +243,28 @@ char32_t Resources::GetGlyphCode(const std::string &smuflName) const
     return m_glyphNameTable.contains(smuflName) ? m_glyphNameTable.at(smuflName) : 0;
 }
 
+void Resources::BuildSmuflGlyphTable() const
+{
+    m_smuflGlyphs.assign(SMUFL_CODE_LAST - SMUFL_CODE_FIRST + 1, NULL);
+
+    const auto fillTable = [this](const GlyphTable &glyphTable) {
+        for (const auto &[code, glyph] : glyphTable) {
+            if ((code < SMUFL_CODE_FIRST) || (code > SMUFL_CODE_LAST)) continue;
+            m_smuflGlyphs.at(code - SMUFL_CODE_FIRST) = &glyph;
+        }
+    };
+
+    // Glyphs from the fallback font are overwritten by the ones of the current font
+    if (!this->IsCurrentFontFallback() && this->IsFontLoaded(m_fallbackFontName)) {
+        fillTable(this->GetFallbackGlyphTable());
+    }
+    if (this->IsFontLoaded(m_currentFontName)) {
+        fillTable(this->GetCurrentGlyphTable());
+    }
+
+    m_smuflGlyphsRevision = m_revision;
+}
+
 bool Resources::IsSmuflFallbackNeeded(const std::u32string &text) const
 {
     if (m_loadedFonts.at(m_currentFontName).isFallback()) {
@@ -386,6 +420,7 @@ bool Resources::LoadFont(const std::string &fontName, ZipFileReader *zipFile)
     bool isFallback = ((fontName == BRAVURA) || (fontName == LEIPZIG)) ? true : false;
 
     m_loadedFonts.insert(std::pair<std::string, LoadedFont>(fontName, Resources::LoadedFont(fontName, isFallback)));
+    ++m_revision;
     LoadedFont &font = m_loadedFonts.at(fontName);
 
     // For zip archive custom font also store the CSS
@@ -405,6 +440,7 @@ bool Resources::LoadFont(const std::string &fontName, ZipFileReader *zipFile)
         Glyph glyph;
         glyph.SetUnitsPerEm(unitsPerEm * 10);
         glyph.SetCodeStr(c_attribute.value());
+        glyph.SetFontName(fontName);
         float x = 0.0, y = 0.0, width = 0.0, height = 0.0;
         if (current.attribute("x")) x = current.attribute("x").as_float();
         if (current.attribute("y")) y = current.attribute("y").as_float();
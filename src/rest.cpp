@@ -218,7 +218,7 @@ void Rest::AddChild(Object *child)
     else {
         children.push_back(child);
     }
-    Modify();
+    this->ModifyFor(child);
 }
 
 char32_t Rest::GetRestGlyph() const
@@ -451,10 +451,10 @@ int Rest::GetFirstRelativeElementLocation(
     const Staff *currentStaff, const Layer *currentLayer, bool isPrevious, bool isTopLayer) const
 {
     // current system
-    const System *system = vrv_cast<const System *>(this->GetFirstAncestor(SYSTEM));
+    const System *system = this->GetAncestorSystem();
     assert(system);
     // current measure
-    const Measure *measure = vrv_cast<const Measure *>(this->GetFirstAncestor(MEASURE));
+    const Measure *measure = this->GetAncestorMeasure();
     assert(measure);
 
     const int index = system->GetChildIndex(measure);
@@ -164,13 +164,13 @@ std::pair<const Layer *, const LayerElement *> Slur::GetBoundaryLayer() const
     const Layer *layer = NULL;
     const LayerElement *layerElement = NULL;
     if (!start->Is(TIMESTAMP_ATTR)) {
-        layer = vrv_cast<const Layer *>(start->GetFirstAncestor(LAYER));
+        layer = start->GetAncestorLayer();
         layerElement = start;
     }
     if (!end->Is(TIMESTAMP_ATTR)) {
         // Prefer non grace notes if possible
         if (!layerElement || layerElement->IsGraceNote()) {
-            layer = vrv_cast<const Layer *>(end->GetFirstAncestor(LAYER));
+            layer = end->GetAncestorLayer();
             layerElement = end;
         }
     }
@@ -1006,8 +1006,8 @@ std::pair<Point, Point> Slur::CalcEndPoints(const Doc *doc, const Staff *staff,
 
 bool Slur::ConsiderMelodicDirection() const
 {
-    const Measure *startMeasure = vrv_cast<const Measure *>(this->GetStart()->GetFirstAncestor(MEASURE));
-    const Measure *endMeasure = vrv_cast<const Measure *>(this->GetEnd()->GetFirstAncestor(MEASURE));
+    const Measure *startMeasure = this->GetStart()->GetAncestorMeasure();
+    const Measure *endMeasure = this->GetEnd()->GetAncestorMeasure();
 
     // Return true if the slur starts in the last measure and ends in the first measure of the next system
     if (startMeasure && endMeasure) {
@@ -9,7 +9,11 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <map>
+#include <sstream>
 
 //----------------------------------------------------------------------------
 
@@ -53,6 +57,7 @@ SvgDeviceContext::SvgDeviceContext() : DeviceContext(SVG_DEVICE_CONTEXT)
     m_html5 = false;
     m_formatRaw = false;
     m_removeXlink = false;
+    m_compact = false;
     m_facsimile = false;
     m_indent = 2;
 
@@ -197,14 +202,20 @@ void SvgDeviceContext::Commit(bool xml_declaration)
         pugi::xml_node defs = m_svgNode.prepend_child("defs");
         pugi::xml_document sourceDoc;
 
+        // sort the glyphs by id since the glyph addresses differ from one resource instance to another
+        std::vector<const GlyphRef *> glyphRefs;
+        for (const auto &entry : m_smuflGlyphs) glyphRefs.push_back(&entry.second);
+        std::sort(glyphRefs.begin(), glyphRefs.end(),
+            [](const GlyphRef *ref1, const GlyphRef *ref2) { return (ref1->GetRefId() < ref2->GetRefId()); });
+
         // for each needed glyph
-        for (const std::pair<const Glyph *, const SvgDeviceContext::GlyphRef &> entry : m_smuflGlyphs) {
+        for (const GlyphRef *glyphRef : glyphRefs) {
             // load the XML as a pugi::xml_document
-            sourceDoc.load_string(entry.first->GetXML().c_str());
+            sourceDoc.load_string(glyphRef->GetGlyph()->GetXML().c_str());
 
             // copy all the nodes inside into the master document
             for (pugi::xml_node child = sourceDoc.first_child(); child; child = child.next_sibling()) {
-                child.attribute("id").set_value(entry.second.GetRefId().c_str());
+                child.attribute("id").set_value(glyphRef->GetRefId().c_str());
                 defs.append_copy(child);
             }
         }
@@ -220,10 +231,14 @@ void SvgDeviceContext::Commit(bool xml_declaration)
         decl.append_attribute("standalone") = "no";
     }
 
-    if (m_formatRaw) {
+    if (m_formatRaw || this->IsCompact()) {
         output_flags |= pugi::format_raw;
     }
 
+    if (this->IsCompact()) {
+        this->RemoveEmptyGroups(m_svgNode);
+    }
+
     // add description statement
     pugi::xml_node desc = m_svgNode.prepend_child("desc");
     desc.text().set(StringFormat("Engraved by Verovio %s", GetVersion().c_str()).c_str());
@@ -457,7 +472,7 @@ void SvgDeviceContext::RotateGraphic(Point const &orig, double angle)
         return;
     }
 
-    m_currentNode.append_attribute("transform") = StringFormat("rotate(%f %d,%d)", angle, orig.x, orig.y).c_str();
+    m_currentNode.append_attribute("transform") = StringFormat("rotate(%s %d,%d)", this->FormatDouble(angle).c_str(), orig.x, orig.y).c_str();
 }
 
 void SvgDeviceContext::StartPage()
@@ -476,6 +491,13 @@ void SvgDeviceContext::StartPage()
                                  //"g.content-bounding-box{stroke:blue; stroke-width:10} "
                                  "g.ending, g.fing, g.reh, g.tempo{font-weight:bold;} g.dir, g.dynam, "
                                  "g.mNum{font-style:italic;} g.label{font-weight:normal;}");
+        // classes replacing the stroke attributes shared by most paths in compact mode
+        if (this->IsCompact()) {
+            m_currentNode.text().set((std::string(m_currentNode.text().get())
+                + " .vrv-s{stroke:currentColor;} .vrv-r{stroke-linecap:round;stroke-linejoin:round;} "
+                  ".vrv-n{fill:none;}")
+                                         .c_str());
+        }
         m_currentNode = m_svgNodeStack.back();
     }
 
@@ -611,6 +633,54 @@ void SvgDeviceContext::AppendStrokeDashArray(pugi::xml_node node, const Pen &pen
     }
 }
 
+void SvgDeviceContext::AppendStroke(pugi::xml_node node, const Pen &pen, bool roundStroke, bool noFill)
+{
+    if (this->IsCompact()) {
+        std::string classes;
+        if (pen.GetColor() == AxNONE) classes = "vrv-s";
+        if (roundStroke) classes += (classes.empty()) ? "vrv-r" : " vrv-r";
+        if (noFill) classes += (classes.empty()) ? "vrv-n" : " vrv-n";
+        if (!classes.empty()) node.append_attribute("class") = classes.c_str();
+        if (pen.GetColor() != AxNONE) node.append_attribute("stroke") = this->GetColor(pen.GetColor()).c_str();
+        return;
+    }
+
+    if (noFill) node.append_attribute("fill") = "none";
+    node.append_attribute("stroke") = this->GetColor(pen.GetColor()).c_str();
+    if (roundStroke) {
+        node.append_attribute("stroke-linecap") = "round";
+        node.append_attribute("stroke-linejoin") = "round";
+    }
+}
+
+std::string SvgDeviceContext::FormatDouble(double value)
+{
+    std::string str = StringFormat("%f", value);
+    if (!this->IsCompact()) return str;
+
+    // Same precision as %f, without the trailing zeros
+    str.erase(str.find_last_not_of('0') + 1);
+    if (str.back() == '.') str.pop_back();
+    return (str == "-0") ? "0" : str;
+}
+
+void SvgDeviceContext::RemoveEmptyGroups(pugi::xml_node node)
+{
+    pugi::xml_node child = node.first_child();
+    while (child) {
+        pugi::xml_node next = child.next_sibling();
+        if (child.type() == pugi::node_element) {
+            this->RemoveEmptyGroups(child);
+            // Groups with an id or a class can be referred to and are kept
+            if (!strcmp(child.name(), "g") && !child.first_child() && !child.attribute("id")
+                && !child.attribute("class")) {
+                node.remove_child(child);
+            }
+        }
+        child = next;
+    }
+}
+
 // Drawing methods
 void SvgDeviceContext::DrawQuadBezierPath(Point bezier[3])
 {
@@ -619,10 +689,7 @@ void SvgDeviceContext::DrawQuadBezierPath(Point bezier[3])
         bezier[0].x, bezier[0].y, // M Command
         bezier[1].x, bezier[1].y, bezier[2].x, bezier[2].y)
                                           .c_str();
-    pathChild.append_attribute("fill") = "none";
-    pathChild.append_attribute("stroke") = this->GetColor(m_penStack.top().GetColor()).c_str();
-    pathChild.append_attribute("stroke-linecap") = "round";
-    pathChild.append_attribute("stroke-linejoin") = "round";
+    this->AppendStroke(pathChild, m_penStack.top(), true, true);
     pathChild.append_attribute("stroke-width") = m_penStack.top().GetWidth();
     this->AppendStrokeDashArray(pathChild, m_penStack.top());
 }
@@ -635,10 +702,7 @@ void SvgDeviceContext::DrawCubicBezierPath(Point bezier[4])
         bezier[1].x, bezier[1].y, bezier[2].x, bezier[2].y, bezier[3].x, bezier[3].y // Remaining bezier points.
         )
                                           .c_str();
-    pathChild.append_attribute("fill") = "none";
-    pathChild.append_attribute("stroke") = this->GetColor(m_penStack.top().GetColor()).c_str();
-    pathChild.append_attribute("stroke-linecap") = "round";
-    pathChild.append_attribute("stroke-linejoin") = "round";
+    this->AppendStroke(pathChild, m_penStack.top(), true, true);
     pathChild.append_attribute("stroke-width") = m_penStack.top().GetWidth();
     this->AppendStrokeDashArray(pathChild, m_penStack.top());
 }
@@ -654,9 +718,7 @@ void SvgDeviceContext::DrawCubicBezierPathFilled(Point bezier1[4], Point bezier2
               .c_str();
     // pathChild.append_attribute("fill") = "currentColor";
     // pathChild.append_attribute("fill-opacity") = "1";
-    pathChild.append_attribute("stroke") = this->GetColor(m_penStack.top().GetColor()).c_str();
-    pathChild.append_attribute("stroke-linecap") = "round";
-    pathChild.append_attribute("stroke-linejoin") = "round";
+    this->AppendStroke(pathChild, m_penStack.top(), true);
     // pathChild.append_attribute("stroke-opacity") = "1";
     pathChild.append_attribute("stroke-width") = m_penStack.top().GetWidth();
 }
@@ -686,7 +748,7 @@ void SvgDeviceContext::DrawEllipse(int x, int y, int width, int height)
     if (currentPen.GetOpacity() != 1.0) ellipseChild.append_attribute("stroke-opacity") = currentPen.GetOpacity();
     if (currentPen.GetWidth() > 0) {
         ellipseChild.append_attribute("stroke-width") = currentPen.GetWidth();
-        ellipseChild.append_attribute("stroke") = this->GetColor(m_penStack.top().GetColor()).c_str();
+        this->AppendStroke(ellipseChild, m_penStack.top());
     }
 }
 
@@ -749,15 +811,24 @@ void SvgDeviceContext::DrawEllipticArc(int x, int y, int width, int height, doub
     if (currentPen.GetOpacity() != 1.0) pathChild.append_attribute("stroke-opacity") = currentPen.GetOpacity();
     if (currentPen.GetWidth() > 0) {
         pathChild.append_attribute("stroke-width") = currentPen.GetWidth();
-        pathChild.append_attribute("stroke") = this->GetColor(m_penStack.top().GetColor()).c_str();
+        this->AppendStroke(pathChild, m_penStack.top());
     }
 }
 
 void SvgDeviceContext::DrawLine(int x1, int y1, int x2, int y2)
 {
     pugi::xml_node pathChild = AddChild("path");
-    pathChild.append_attribute("d") = StringFormat("M%d %d L%d %d", x1, y1, x2, y2).c_str();
-    pathChild.append_attribute("stroke") = this->GetColor(m_penStack.top().GetColor()).c_str();
+    // horizontal and vertical lines (e.g., staff lines and stems) are shorter with H and V in compact mode
+    if (this->IsCompact() && (y1 == y2)) {
+        pathChild.append_attribute("d") = StringFormat("M%d %dH%d", x1, y1, x2).c_str();
+    }
+    else if (this->IsCompact() && (x1 == x2)) {
+        pathChild.append_attribute("d") = StringFormat("M%d %dV%d", x1, y1, y2).c_str();
+    }
+    else {
+        pathChild.append_attribute("d") = StringFormat("M%d %d L%d %d", x1, y1, x2, y2).c_str();
+    }
+    this->AppendStroke(pathChild, m_penStack.top());
     if (m_penStack.top().GetWidth() > 1) pathChild.append_attribute("stroke-width") = m_penStack.top().GetWidth();
     this->AppendStrokeLineCap(pathChild, m_penStack.top());
     this->AppendStrokeDashArray(pathChild, m_penStack.top());
@@ -771,13 +842,13 @@ void SvgDeviceContext::DrawPolyline(int n, Point points[], int xOffset, int yOff
     pugi::xml_node polylineChild = AddChild("polyline");
 
     if (currentPen.GetWidth() > 0) {
-        polylineChild.append_attribute("stroke") = this->GetColor(currentPen.GetColor()).c_str();
+        this->AppendStroke(polylineChild, currentPen);
     }
     if (currentPen.GetWidth() > 1) {
         polylineChild.append_attribute("stroke-width") = StringFormat("%d", currentPen.GetWidth()).c_str();
     }
     if (currentPen.GetOpacity() != 1.0) {
-        polylineChild.append_attribute("stroke-opacity") = StringFormat("%f", currentPen.GetOpacity()).c_str();
+        polylineChild.append_attribute("stroke-opacity") = this->FormatDouble(currentPen.GetOpacity()).c_str();
     }
 
     this->AppendStrokeLineCap(polylineChild, currentPen);
@@ -804,13 +875,13 @@ void SvgDeviceContext::DrawPolygon(int n, Point points[], int xOffset, int yOffs
     pugi::xml_node polygonChild = AddChild("polygon");
 
     if (currentPen.GetWidth() > 0) {
-        polygonChild.append_attribute("stroke") = this->GetColor(currentPen.GetColor()).c_str();
+        this->AppendStroke(polygonChild, currentPen);
     }
     if (currentPen.GetWidth() > 1) {
         polygonChild.append_attribute("stroke-width") = StringFormat("%d", currentPen.GetWidth()).c_str();
     }
     if (currentPen.GetOpacity() != 1.0) {
-        polygonChild.append_attribute("stroke-opacity") = StringFormat("%f", currentPen.GetOpacity()).c_str();
+        polygonChild.append_attribute("stroke-opacity") = this->FormatDouble(currentPen.GetOpacity()).c_str();
     }
 
     this->AppendStrokeLineJoin(polygonChild, currentPen);
@@ -819,7 +890,7 @@ void SvgDeviceContext::DrawPolygon(int n, Point points[], int xOffset, int yOffs
     if (currentBrush.GetColor() != AxNONE)
         polygonChild.append_attribute("fill") = this->GetColor(currentBrush.GetColor()).c_str();
     if (currentBrush.GetOpacity() != 1.0)
-        polygonChild.append_attribute("fill-opacity") = StringFormat("%f", currentBrush.GetOpacity()).c_str();
+        polygonChild.append_attribute("fill-opacity") = this->FormatDouble(currentBrush.GetOpacity()).c_str();
 
     std::string pointsString = StringFormat("%d,%d", points[0].x + xOffset, points[0].y + yOffset);
     for (int i = 1; i < n; ++i) {
@@ -840,11 +911,11 @@ void SvgDeviceContext::DrawRoundedRectangle(int x, int y, int width, int height,
     if (m_penStack.size()) {
         Pen currentPen = m_penStack.top();
         if (currentPen.GetWidth() > 0)
-            rectChild.append_attribute("stroke") = this->GetColor(currentPen.GetColor()).c_str();
+            this->AppendStroke(rectChild, currentPen);
         if (currentPen.GetWidth() > 1)
             rectChild.append_attribute("stroke-width") = StringFormat("%d", currentPen.GetWidth()).c_str();
         if (currentPen.GetOpacity() != 1.0)
-            rectChild.append_attribute("stroke-opacity") = StringFormat("%f", currentPen.GetOpacity()).c_str();
+            rectChild.append_attribute("stroke-opacity") = this->FormatDouble(currentPen.GetOpacity()).c_str();
     }
 
     if (m_brushStack.size()) {
@@ -852,7 +923,7 @@ void SvgDeviceContext::DrawRoundedRectangle(int x, int y, int width, int height,
         if (currentBrush.GetColor() != AxNONE)
             rectChild.append_attribute("fill") = this->GetColor(currentBrush.GetColor()).c_str();
         if (currentBrush.GetOpacity() != 1.0)
-            rectChild.append_attribute("fill-opacity") = StringFormat("%f", currentBrush.GetOpacity()).c_str();
+            rectChild.append_attribute("fill-opacity") = this->FormatDouble(currentBrush.GetOpacity()).c_str();
     }
 
     // negative heights or widths are not allowed in SVG
@@ -1052,11 +1123,14 @@ void SvgDeviceContext::DrawMusicText(const std::u32string &text, int x, int y, b
         useChild.append_attribute(hrefAttrib.c_str()) = StringFormat("#%s", id.c_str()).c_str();
         useChild.append_attribute("x") = x;
         useChild.append_attribute("y") = y;
-        useChild.append_attribute("height") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
-        useChild.append_attribute("width") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
+        // the unit is implicit in compact mode
+        const std::string size = StringFormat((this->IsCompact()) ? "%d" : "%dpx", m_fontStack.top()->GetPointSize());
+        useChild.append_attribute("height") = size.c_str();
+        useChild.append_attribute("width") = size.c_str();
         if (m_fontStack.top()->GetWidthToHeightRatio() != 1.0f) {
-            useChild.append_attribute("transform") = StringFormat("matrix(%f,0,0,1,%f,0)",
-                m_fontStack.top()->GetWidthToHeightRatio(), x * (1. - m_fontStack.top()->GetWidthToHeightRatio()))
+            const double ratio = m_fontStack.top()->GetWidthToHeightRatio();
+            useChild.append_attribute("transform") = StringFormat("matrix(%s,0,0,1,%s,0)",
+                this->FormatDouble(ratio).c_str(), this->FormatDouble(x * (1. - ratio)).c_str())
                                                          .c_str();
         }
 
@@ -1085,7 +1159,8 @@ void SvgDeviceContext::DrawGraphicUri(int x, int y, int width, int height, const
 void SvgDeviceContext::DrawSvgShape(int x, int y, int width, int height, double scale, pugi::xml_node svg)
 {
     m_currentNode.append_attribute("transform")
-        = StringFormat("translate(%d, %d) scale(%f, %f)", x, y, scale * DEFINITION_FACTOR, scale * DEFINITION_FACTOR)
+        = StringFormat("translate(%d, %d) scale(%s, %s)", x, y, this->FormatDouble(scale * DEFINITION_FACTOR).c_str(),
+            this->FormatDouble(scale * DEFINITION_FACTOR).c_str())
               .c_str();
 
     // Remove the ID in the SVG because it might be duplicated and that will not be valid
@@ -1181,6 +1256,131 @@ std::string SvgDeviceContext::GetStringSVG(bool xml_declaration)
     return m_outdata.str();
 }
 
+std::string SvgDeviceContext::CreateSpriteSheet(
+    const std::vector<std::string> &svgs, const std::string &idPrefix, bool xml_declaration, int indent, bool formatRaw)
+{
+    pugi::xml_document sheetDoc;
+    pugi::xml_node sheet = sheetDoc.append_child("svg");
+    sheet.append_attribute("version") = "1.1";
+    sheet.append_attribute("xmlns") = "http://www.w3.org/2000/svg";
+    sheet.append_attribute("xmlns:xlink") = "http://www.w3.org/1999/xlink";
+    sheet.append_attribute("xmlns:mei") = "http://www.music-encoding.org/ns/mei";
+    sheet.append_attribute("overflow") = "visible";
+    pugi::xml_node desc = sheet.append_child("desc");
+    desc.text().set(StringFormat("Engraved by Verovio %s", GetVersion().c_str()).c_str());
+    pugi::xml_node defs = sheet.append_child("defs");
+    // The styles are added after the defs
+    pugi::xml_node styleAnchor = defs;
+
+    // The ID of each symbol in the sheet by content (without the ID), and the IDs already used
+    std::map<std::string, std::string> symbolIds;
+    std::set<std::string> usedIds;
+    std::set<std::string> styles;
+
+    // The SVGs are stacked with the unit of their size (px or mm), or in user units with a view box
+    double sheetWidth = 0.0;
+    double sheetHeight = 0.0;
+    std::string unit;
+
+    for (int i = 0; i < (int)svgs.size(); ++i) {
+        const std::string id = StringFormat("%s%d", idPrefix.c_str(), i);
+        pugi::xml_document svgDoc;
+        pugi::xml_node svg;
+        if (!svgs.at(i).empty() && svgDoc.load_string(svgs.at(i).c_str())) svg = svgDoc.child("svg");
+        if (!svg) {
+            // An empty SVG keeps the IDs in the order of the input
+            sheet.append_child("svg").append_attribute("id") = id.c_str();
+            continue;
+        }
+
+        // Share the symbols with the same content
+        std::map<std::string, std::string> idMap;
+        for (pugi::xml_node symbol : svg.child("defs").children("symbol")) {
+            const std::string symbolId = symbol.attribute("id").value();
+            symbol.remove_attribute("id");
+            std::ostringstream content;
+            symbol.print(content, "", pugi::format_raw);
+            auto [iter, inserted] = symbolIds.try_emplace(content.str(), symbolId);
+            if (inserted) {
+                // The same ID can be used for another glyph (e.g., with another font)
+                for (int suffix = 1; !usedIds.insert(iter->second).second; ++suffix) {
+                    iter->second = StringFormat("%s-%d", symbolId.c_str(), suffix);
+                }
+                symbol.prepend_attribute("id") = iter->second.c_str();
+                defs.append_copy(symbol);
+            }
+            idMap[symbolId] = iter->second;
+        }
+        svg.remove_child("defs");
+        svg.remove_child("desc");
+
+        std::vector<pugi::xml_node> styleNodes;
+        for (pugi::xml_node style : svg.children("style")) styleNodes.push_back(style);
+        for (pugi::xml_node style : styleNodes) {
+            if (styles.insert(style.text().get()).second) styleAnchor = sheet.insert_copy_after(style, styleAnchor);
+            svg.remove_child(style);
+        }
+
+        // Point the references to the symbols of the sheet
+        for (const pugi::xpath_node &use : svg.select_nodes(".//use")) {
+            for (const char *name : { "xlink:href", "href" }) {
+                pugi::xml_attribute href = use.node().attribute(name);
+                if (!href || (href.value()[0] != '#')) continue;
+                auto iter = idMap.find(href.value() + 1);
+                if (iter != idMap.end()) href.set_value(("#" + iter->second).c_str());
+            }
+        }
+
+        // The size is given by the width and the height, or by the view box
+        double width = 0.0;
+        double height = 0.0;
+        if (svg.attribute("width") && svg.attribute("height")) {
+            char *end = NULL;
+            width = strtod(svg.attribute("width").value(), &end);
+            unit = end;
+            height = atof(svg.attribute("height").value());
+        }
+        else if (svg.attribute("viewBox")) {
+            double x, y;
+            sscanf(svg.attribute("viewBox").value(), "%lf %lf %lf %lf", &x, &y, &width, &height);
+            svg.append_attribute("width") = StringFormat("%g", width).c_str();
+            svg.append_attribute("height") = StringFormat("%g", height).c_str();
+            unit = "";
+        }
+
+        for (const char *name : { "version", "xmlns", "xmlns:xlink", "xmlns:mei" }) svg.remove_attribute(name);
+        svg.prepend_attribute("id") = id.c_str();
+        svg.append_attribute("y") = StringFormat("%g%s", sheetHeight, unit.c_str()).c_str();
+        sheet.append_copy(svg);
+
+        sheetWidth = std::max(sheetWidth, width);
+        sheetHeight += height;
+    }
+
+    if (unit.empty()) {
+        sheet.prepend_attribute("viewBox") = StringFormat("0 0 %g %g", sheetWidth, sheetHeight).c_str();
+    }
+    else {
+        sheet.prepend_attribute("height") = StringFormat("%g%s", sheetHeight, unit.c_str()).c_str();
+        sheet.prepend_attribute("width") = StringFormat("%g%s", sheetWidth, unit.c_str()).c_str();
+    }
+
+    unsigned int output_flags = pugi::format_default | pugi::format_no_declaration;
+    if (xml_declaration) {
+        output_flags = pugi::format_default;
+        pugi::xml_node decl = sheetDoc.prepend_child(pugi::node_declaration);
+        decl.append_attribute("version") = "1.0";
+        decl.append_attribute("encoding") = "UTF-8";
+        decl.append_attribute("standalone") = "no";
+    }
+    if (formatRaw) output_flags |= pugi::format_raw;
+
+    std::ostringstream output;
+    const std::string indentStr = (indent == -1) ? "\t" : std::string(indent, ' ');
+    sheetDoc.save(output, indentStr.c_str(), output_flags);
+    return output.str();
+}
+
 void SvgDeviceContext::DrawSvgBoundingBoxRectangle(int x, int y, int width, int height)
 {
     std::string s;
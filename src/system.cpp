@@ -82,6 +82,8 @@ void System::Reset()
     m_drawingJustifiableWidth = 0;
     m_castOffTotalWidth = 0;
     m_castOffJustifiableWidth = 0;
+    m_castOffYRel = 0;
+    m_castOffHeight = 0;
     m_drawingAbbrLabelsWidth = 0;
     m_drawingIsOptimized = false;
 }
@@ -222,9 +224,9 @@ bool System::HasMixedDrawingStemDir(const LayerElement *start, const LayerElemen
 
     // It is too inefficient to look for chord and notes over the entire system
     // We need first to get a list of measures
-    const Object *measureStart = start->GetFirstAncestor(MEASURE);
+    const Object *measureStart = start->GetAncestorMeasure();
     assert(measureStart);
-    const Object *measureEnd = end->GetFirstAncestor(MEASURE);
+    const Object *measureEnd = end->GetAncestorMeasure();
     assert(measureEnd);
     ListOfConstObjects measures;
 
@@ -248,7 +250,7 @@ bool System::HasMixedDrawingStemDir(const LayerElement *start, const LayerElemen
         measure->FindAllDescendantsBetween(&children, &matchType, curStart, curEnd, false);
     }
 
-    const Layer *layerStart = vrv_cast<const Layer *>(start->GetFirstAncestor(LAYER));
+    const Layer *layerStart = start->GetAncestorLayer();
     assert(layerStart);
     const Staff *staffStart = vrv_cast<const Staff *>(layerStart->GetFirstAncestor(STAFF));
     assert(staffStart);
@@ -291,14 +293,14 @@ curvature_CURVEDIR System::GetPreferredCurveDirection(
     findSpannedLayerElements.SetMinMaxPos(start->GetDrawingX(), end->GetDrawingX());
     findSpannedLayerElements.SetClassIds({ CHORD, NOTE });
 
-    const Layer *layerStart = vrv_cast<const Layer *>(start->GetFirstAncestor(LAYER));
+    const Layer *layerStart = start->GetAncestorLayer();
     assert(layerStart);
 
     this->Process(findSpannedLayerElements);
 
     curvature_CURVEDIR preferredDirection = curvature_CURVEDIR_NONE;
     for (auto element : findSpannedLayerElements.GetElements()) {
-        const Layer *layer = vrv_cast<const Layer *>((element)->GetFirstAncestor(LAYER));
+        const Layer *layer = (element)->GetAncestorLayer();
         assert(layer);
         if (layer == layerStart) continue;
 
@@ -77,7 +77,7 @@ void TabDurSym::AddChild(Object *child)
     else {
         children.push_back(child);
     }
-    Modify();
+    this->ModifyFor(child);
 }
 
 void TabDurSym::AdjustDrawingYRel(const Staff *staff, const Doc *doc)
@@ -72,7 +72,7 @@ void TabGrp::FilterList(ListOfConstObjects &childList) const
         }
     }
 
-    childList.sort(TabCourseSort());
+    std::stable_sort(childList.begin(), childList.end(), TabCourseSort());
 }
 
 int TabGrp::GetYTop() const
@@ -89,7 +89,7 @@ Measure *TimePointInterface::GetStartMeasure()
 const Measure *TimePointInterface::GetStartMeasure() const
 {
     if (!m_start) return NULL;
-    return vrv_cast<const Measure *>(m_start->GetFirstAncestor(MEASURE));
+    return m_start->GetAncestorMeasure();
 }
 
 bool TimePointInterface::IsOnStaff(int n) const
@@ -234,7 +234,7 @@ Measure *TimeSpanningInterface::GetEndMeasure()
 const Measure *TimeSpanningInterface::GetEndMeasure() const
 {
     if (!m_end) return NULL;
-    return vrv_cast<const Measure *>(m_end->GetFirstAncestor(MEASURE));
+    return m_end->GetAncestorMeasure();
 }
 
 bool TimeSpanningInterface::IsSpanningMeasures() const
@@ -251,8 +251,8 @@ bool TimeSpanningInterface::IsOrdered() const
 bool TimeSpanningInterface::IsOrdered(const LayerElement *start, const LayerElement *end) const
 {
     if (!start || !end) return true;
-    const Measure *startMeasure = vrv_cast<const Measure *>(start->GetFirstAncestor(MEASURE));
-    const Measure *endMeasure = vrv_cast<const Measure *>(end->GetFirstAncestor(MEASURE));
+    const Measure *startMeasure = start->GetAncestorMeasure();
+    const Measure *endMeasure = end->GetAncestorMeasure();
 
     if (startMeasure == endMeasure) {
         if (!start->GetAlignment() || !end->GetAlignment()) return true;
@@ -9,7 +9,11 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <cstring>
+#include <unordered_map>
 
 //----------------------------------------------------------------------------
 
@@ -21,6 +25,55 @@
 
 namespace vrv {
 
+namespace {
+
+    // The names of the index arrays in the columnar JSON, in the order of the event types
+    const char *columnNames[] = { "on", "off", "restsOn", "restsOff" };
+
+    void AppendNumber(std::string &output, double value)
+    {
+        char buffer[32];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        output.append(buffer, result.ptr);
+    }
+
+    void AppendString(std::string &output, const std::string &value)
+    {
+        output += '"';
+        for (char c : value) {
+            if ((c == '"') || (c == '\\')) output += '\\';
+            output += c;
+        }
+        output += '"';
+    }
+
+    template <typename T> void AppendArray(std::string &output, const char *name, const std::vector<T> &values)
+    {
+        output += '"';
+        output += name;
+        output += "\":[";
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) output += ',';
+            AppendNumber(output, values.at(i));
+        }
+        output += ']';
+    }
+
+    void AppendUint32(std::vector<uint8_t> &output, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) output.push_back((value >> (8 * i)) & 0xFF);
+    }
+
+    void AppendDouble(std::vector<uint8_t> &output, double value)
+    {
+        uint64_t bits;
+        static_assert(sizeof(bits) == sizeof(value));
+        memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 8; ++i) output.push_back((bits >> (8 * i)) & 0xFF);
+    }
+
+} // namespace
+
 //----------------------------------------------------------------------------
 // Timemap
 //----------------------------------------------------------------------------
@@ -34,64 +87,190 @@ Timemap::~Timemap() {}
 
 void Timemap::Reset()
 {
-    m_map.clear();
+    m_events.clear();
+}
+
+void Timemap::SortEvents()
+{
+    std::stable_sort(m_events.begin(), m_events.end(),
+        [](const TimemapEvent &event1, const TimemapEvent &event2) { return (event1.time < event2.time); });
 }
 
 void Timemap::ToJson(std::string &output, bool includeRests, bool includeMeasures)
 {
+    this->SortEvents();
+
     double currentTempo = -1000.0;
-    double newTempo;
 
     jsonxx::Array timemap;
 
-    for (auto &[tstamp, entry] : m_map) {
+    auto groupStart = m_events.begin();
+    while (groupStart != m_events.end()) {
+        auto groupEnd = std::find_if(groupStart, m_events.end(),
+            [groupStart](const TimemapEvent &event) { return (event.time != groupStart->time); });
+
+        // The last event at the time sets the qstamp, the tempo and the measure
+        double qstamp = 0.0;
+        double tempo = -1000.0;
+        const Object *measureOn = NULL;
+        jsonxx::Array lists[4];
+        for (auto iter = groupStart; iter != groupEnd; ++iter) {
+            qstamp = iter->qstamp;
+            if (iter->tempo != -1000.0) tempo = iter->tempo;
+            if (iter->type == TIMEMAP_measureOn) {
+                measureOn = iter->object;
+            }
+            else {
+                lists[iter->type] << iter->object->GetID();
+            }
+        }
+
         jsonxx::Object o;
-        o << "tstamp" << tstamp;
-        o << "qstamp" << entry.qstamp;
+        o << "tstamp" << groupStart->time;
+        o << "qstamp" << qstamp;
 
         // on / off
-        if (!entry.notesOn.empty()) {
-            jsonxx::Array notesOn;
-            for (auto note : entry.notesOn) notesOn << note;
-            o << "on" << notesOn;
-        }
-        if (!entry.notesOff.empty()) {
-            jsonxx::Array notesOff;
-            for (auto note : entry.notesOff) notesOff << note;
-            o << "off" << notesOff;
-        }
+        if (lists[TIMEMAP_noteOn].size() > 0) o << "on" << lists[TIMEMAP_noteOn];
+        if (lists[TIMEMAP_noteOff].size() > 0) o << "off" << lists[TIMEMAP_noteOff];
 
         // restsOn / restsOff
         if (includeRests) {
-            if (!entry.restsOn.empty()) {
-                jsonxx::Array restsOn;
-                for (auto rest : entry.restsOn) restsOn << rest;
-                o << "restsOn" << restsOn;
-            }
-            if (!entry.restsOff.empty()) {
-                jsonxx::Array restsOff;
-                for (auto rest : entry.restsOff) restsOff << rest;
-                o << "restsOff" << restsOff;
-            }
+            if (lists[TIMEMAP_restOn].size() > 0) o << "restsOn" << lists[TIMEMAP_restOn];
+            if (lists[TIMEMAP_restOff].size() > 0) o << "restsOff" << lists[TIMEMAP_restOff];
         }
 
         // tempo
-        if (entry.tempo != -1000.0) {
-            newTempo = entry.tempo;
-            if (newTempo != currentTempo) {
-                currentTempo = newTempo;
-                o << "tempo" << std::to_string(currentTempo);
-            }
+        if ((tempo != -1000.0) && (tempo != currentTempo)) {
+            currentTempo = tempo;
+            o << "tempo" << std::to_string(currentTempo);
         }
 
         // measureOn
-        if (includeMeasures && !entry.measureOn.empty()) {
-            o << "measureOn" << entry.measureOn;
+        if (includeMeasures && measureOn) {
+            o << "measureOn" << measureOn->GetID();
         }
 
         timemap << o;
+        groupStart = groupEnd;
     }
     output = timemap.json();
 }
 
+void Timemap::GetColumns(Columns &columns, bool includeRests, bool includeMeasures)
+{
+    this->SortEvents();
+
+    const int listCount = (includeRests) ? 4 : 2;
+    std::unordered_map<const Object *, uint32_t> idIndexes;
+    auto getIdIndex = [&columns, &idIndexes](const Object *object) {
+        auto [iter, inserted] = idIndexes.try_emplace(object, (uint32_t)columns.ids.size());
+        if (inserted) columns.ids.push_back(object);
+        return iter->second;
+    };
+
+    double currentTempo = -1000.0;
+    auto groupStart = m_events.begin();
+    while (groupStart != m_events.end()) {
+        auto groupEnd = std::find_if(groupStart, m_events.end(),
+            [groupStart](const TimemapEvent &event) { return (event.time != groupStart->time); });
+        const uint32_t timeIndex = (uint32_t)columns.tstamps.size();
+
+        double qstamp = 0.0;
+        double tempo = -1000.0;
+        const Object *measureOn = NULL;
+        for (int i = 0; i < listCount; ++i) columns.offsets[i].push_back((uint32_t)columns.indexes[i].size());
+        for (auto iter = groupStart; iter != groupEnd; ++iter) {
+            qstamp = iter->qstamp;
+            if (iter->tempo != -1000.0) tempo = iter->tempo;
+            if (iter->type == TIMEMAP_measureOn) {
+                measureOn = iter->object;
+            }
+            else if (iter->type < listCount) {
+                columns.indexes[iter->type].push_back(getIdIndex(iter->object));
+            }
+        }
+
+        columns.tstamps.push_back(groupStart->time);
+        columns.qstamps.push_back(qstamp);
+        if ((tempo != -1000.0) && (tempo != currentTempo)) {
+            currentTempo = tempo;
+            columns.tempoTimes.push_back(timeIndex);
+            columns.tempos.push_back(tempo);
+        }
+        if (includeMeasures && measureOn) {
+            columns.measureTimes.push_back(timeIndex);
+            columns.measureIds.push_back(getIdIndex(measureOn));
+        }
+        groupStart = groupEnd;
+    }
+    for (int i = 0; i < listCount; ++i) columns.offsets[i].push_back((uint32_t)columns.indexes[i].size());
+}
+
+void Timemap::ToColumnarJson(std::string &output, bool includeRests, bool includeMeasures)
+{
+    Columns columns;
+    this->GetColumns(columns, includeRests, includeMeasures);
+
+    output = "{";
+    AppendArray(output, "tstamp", columns.tstamps);
+    output += ',';
+    AppendArray(output, "qstamp", columns.qstamps);
+    output += ",\"ids\":[";
+    for (size_t i = 0; i < columns.ids.size(); ++i) {
+        if (i > 0) output += ',';
+        AppendString(output, columns.ids.at(i)->GetID());
+    }
+    output += ']';
+    const int listCount = (includeRests) ? 4 : 2;
+    for (int i = 0; i < listCount; ++i) {
+        output += ',';
+        AppendArray(output, columnNames[i], columns.indexes[i]);
+        output += ',';
+        AppendArray(output, (std::string(columnNames[i]) + "Offsets").c_str(), columns.offsets[i]);
+    }
+    if (includeMeasures) {
+        output += ',';
+        AppendArray(output, "measureTimes", columns.measureTimes);
+        output += ',';
+        AppendArray(output, "measureIds", columns.measureIds);
+    }
+    output += ',';
+    AppendArray(output, "tempoTimes", columns.tempoTimes);
+    output += ',';
+    AppendArray(output, "tempo", columns.tempos);
+    output += '}';
+}
+
+void Timemap::ToBinary(std::vector<uint8_t> &output, bool includeRests, bool includeMeasures)
+{
+    Columns columns;
+    this->GetColumns(columns, includeRests, includeMeasures);
+
+    output.clear();
+    output.insert(output.end(), { 'V', 'T', 'M', '1' });
+    AppendUint32(output, (includeRests ? 1 : 0) | (includeMeasures ? 2 : 0));
+    AppendUint32(output, (uint32_t)columns.tstamps.size());
+    for (double tstamp : columns.tstamps) AppendDouble(output, tstamp);
+    for (double qstamp : columns.qstamps) AppendDouble(output, qstamp);
+    AppendUint32(output, (uint32_t)columns.ids.size());
+    for (const Object *object : columns.ids) {
+        const std::string &id = object->GetID();
+        AppendUint32(output, (uint32_t)id.size());
+        output.insert(output.end(), id.begin(), id.end());
+    }
+    const int listCount = (includeRests) ? 4 : 2;
+    for (int i = 0; i < listCount; ++i) {
+        for (uint32_t offset : columns.offsets[i]) AppendUint32(output, offset);
+        for (uint32_t index : columns.indexes[i]) AppendUint32(output, index);
+    }
+    if (includeMeasures) {
+        AppendUint32(output, (uint32_t)columns.measureTimes.size());
+        for (uint32_t time : columns.measureTimes) AppendUint32(output, time);
+        for (uint32_t id : columns.measureIds) AppendUint32(output, id);
+    }
+    AppendUint32(output, (uint32_t)columns.tempoTimes.size());
+    for (uint32_t time : columns.tempoTimes) AppendUint32(output, time);
+    for (double tempo : columns.tempos) AppendDouble(output, tempo);
+}
+
 } // namespace vrv
@@ -9,21 +9,27 @@
 
 //----------------------------------------------------------------------------
 
+#include <atomic>
 #include <cassert>
 #include <codecvt>
-#include <locale>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 //----------------------------------------------------------------------------
 
 #include "comparison.h"
 #include "custos.h"
+#include "displaylistdevicecontext.h"
 #include "editortoolkit_cmn.h"
 #include "editortoolkit_mensural.h"
 #include "editortoolkit_neume.h"
+#include "facsimile.h"
+#include "featureextractor.h"
+#include "featureindex.h"
 #include "filereader.h"
 #include "findfunctor.h"
 #include "ioabc.h"
@@ -39,6 +45,8 @@
 #include "note.h"
 #include "options.h"
 #include "page.h"
+#include "profiler.h"
+#include "rasterdevicecontext.h"
 #include "rawresourceio.h"
 #include "resourceio.h"
 #include "runtimeclock.h"
@@ -60,12 +68,36 @@ const char *UTF_16_BE_BOM = "\xFE\xFF";
 const char *UTF_16_LE_BOM = "\xFF\xFE";
 const char *ZIP_SIGNATURE = "\x50\x4B\x03\x04";
 
+namespace {
+
+    // A stream buffer appending what is written to a byte vector
+    class ByteStreamBuf : public std::streambuf {
+    public:
+        explicit ByteStreamBuf(std::vector<uint8_t> &bytes) : m_bytes(bytes) {}
+
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if (!traits_type::eq_int_type(c, traits_type::eof())) m_bytes.push_back((uint8_t)c);
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char *s, std::streamsize n) override
+        {
+            m_bytes.insert(m_bytes.end(), s, s + n);
+            return n;
+        }
+
+    private:
+        std::vector<uint8_t> &m_bytes;
+    };
+
+} // namespace
+
 //----------------------------------------------------------------------------
 // Toolkit
 //----------------------------------------------------------------------------
 
-char *Toolkit::m_humdrumBuffer = NULL;
-
 Toolkit::Toolkit(bool initFont)
 {
     m_inputFrom = AUTO;
@@ -81,7 +113,11 @@ Toolkit::Toolkit(bool initFont)
 
     m_options = m_doc.GetOptions();
 
+    m_layoutScale = 0;
+    m_layoutStages = LAYOUT_STAGE_ALL;
+
     m_editorToolkit = NULL;
+    m_featureIndex = NULL;
 
 #ifndef NO_RUNTIME
     m_runtimeClock = NULL;
@@ -90,8 +126,6 @@ Toolkit::Toolkit(bool initFont)
 
 Toolkit::~Toolkit()
 {
-    this->ResetLocale();
-
     if (m_humdrumBuffer) {
         free(m_humdrumBuffer);
         m_humdrumBuffer = NULL;
@@ -104,6 +138,11 @@ Toolkit::~Toolkit()
         delete m_editorToolkit;
         m_editorToolkit = NULL;
     }
+    if (m_featureIndex) {
+        delete m_featureIndex;
+        m_featureIndex = NULL;
+    }
+    for (Toolkit *toolkit : m_incipitToolkits) delete toolkit;
 #ifndef NO_RUNTIME
     if (m_runtimeClock) {
         delete m_runtimeClock;
@@ -150,6 +189,8 @@ bool Toolkit::SetFont(const std::string &fontName)
     Resources &resources = m_doc.GetResourcesForModification();
     const bool ok = resources.SetCurrentFont(fontName, true);
     if (!ok) LogWarning("Font '%s' could not be loaded", fontName.c_str());
+    m_layoutStages = LAYOUT_STAGE_ALL;
+    m_doc.ResetVerticalLayoutCache();
     return ok;
 }
 
@@ -195,6 +236,9 @@ bool Toolkit::SetOutputTo(std::string const &outputTo)
     else if (outputTo == "pae") {
         m_outputTo = PAE;
     }
+    else if (outputTo == "png") {
+        m_outputTo = PNG;
+    }
     else if (outputTo != "svg") {
         LogError("Output format '%s' is not supported", outputTo.c_str());
         return false;
@@ -491,13 +535,22 @@ bool Toolkit::LoadZipDataBuffer(const unsigned char *data, int length)
 
 bool Toolkit::LoadData(const std::string &data)
 {
+    Profiler::Reset();
+    ProfilerStage profilerStage("loadData");
+
     std::string newData;
     Input *input = NULL;
 
     m_doc.m_expansionMap.Reset();
 
+    // Pending edit updates refer to the previous data
+    if (m_editorToolkit) m_editorToolkit->AbortTransaction();
+    m_editUndoLog.clear();
+
     if (m_options->m_xmlIdChecksum.GetValue()) {
-        crcInit();
+        // The crc table is shared by all the threads
+        static std::once_flag crcInitFlag;
+        std::call_once(crcInitFlag, crcInit);
         unsigned int cr = crcFast((unsigned char *)data.c_str(), (int)data.size());
         Object::SeedID(cr);
     }
@@ -544,6 +597,7 @@ bool Toolkit::LoadData(const std::string &data)
             input->SetOutputFormat("humdrum");
         }
 
+        ProfilerStage importStage("import");
         if (!input->Import(data)) {
             LogError("Error importing Humdrum data (1)");
             delete input;
@@ -722,6 +776,7 @@ bool Toolkit::LoadData(const std::string &data)
 
     // load the file
     if (inputFormat != HUMDRUM) {
+        ProfilerStage importStage("import");
         if (!input->Import(newData.size() ? newData : data)) {
             LogError("Error importing data");
             delete input;
@@ -819,6 +874,8 @@ bool Toolkit::LoadData(const std::string &data)
         m_doc.SyncFromFacsimileDoc();
     }
 
+    this->ResetLayoutStages();
+
     delete input;
     m_view.SetDoc(&m_doc);
 
@@ -878,6 +935,9 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
         }
     }
 
+    // The output needs all the pages
+    m_doc.CastOffPendingPages();
+
     if (this->GetPageCount() == 0) {
         LogWarning("No data loaded");
         return "";
@@ -895,6 +955,8 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
         m_doc.DeactiveateSelection();
     }
 
+    ProfilerStage profilerStage("getMEI");
+
     MEIOutput meioutput(&m_doc);
     meioutput.SetScoreBasedMEI(scoreBased);
     meioutput.SetBasic(basic);
@@ -928,6 +990,28 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
     return output;
 }
 
+std::vector<uint8_t> Toolkit::GetMEIZipBinary(const std::string &jsonOptions)
+{
+    const std::string output = this->GetMEI(jsonOptions);
+    if (output.empty()) {
+        return {};
+    }
+
+    const std::string filename = "score.mei";
+    const std::string containerXml = StringFormat("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                                  "<container>\n"
+                                                  "  <rootfiles>\n"
+                                                  "    <rootfile full-path=\"%s\" media-type=\"application/mei+xml\"/>\n"
+                                                  "  </rootfiles>\n"
+                                                  "</container>\n",
+        filename.c_str());
+
+    ZipFileWriter zipFileWriter;
+    zipFileWriter.WriteTextFile("META-INF/container.xml", containerXml);
+    zipFileWriter.WriteTextFile(filename, output);
+    return zipFileWriter.GetBytes();
+}
+
 std::string Toolkit::ValidatePAEFile(const std::string &filename)
 {
     std::ifstream inFile;
@@ -1151,8 +1235,6 @@ bool Toolkit::SetOptions(const std::string &jsonOptions)
 
     m_options->Sync();
 
-    this->SetLocale();
-
     // Forcing font resource to be reset if the font is given in the options
     if (json.has<jsonxx::Array>("fontAddCustom")) {
         Resources &resources = m_doc.GetResourcesForModification();
@@ -1425,7 +1507,19 @@ bool Toolkit::Edit(const std::string &editorAction)
 {
     this->ResetLogBuffer();
 
-    return m_editorToolkit->ParseEditorAction(editorAction);
+    m_doc.CastOffPendingPages();
+
+    m_layoutStages = LAYOUT_STAGE_ALL;
+    m_doc.ResetVerticalLayoutCache();
+
+    const bool success = m_editorToolkit->ParseEditorAction(editorAction);
+
+    m_doc.ResetZoneIndex();
+
+    // Zones can be edited without being added or removed
+    if (m_doc.HasFacsimile()) m_doc.GetFacsimile()->Modify();
+
+    return success;
 }
 
 std::string Toolkit::EditInfo()
@@ -1433,15 +1527,120 @@ std::string Toolkit::EditInfo()
     return m_editorToolkit->EditInfo();
 }
 
+bool Toolkit::BeginEditTransaction()
+{
+    this->ResetLogBuffer();
+
+    if (!m_editorToolkit) {
+        LogError("No editor available for the loaded data");
+        return false;
+    }
+    if (m_editorToolkit->IsInTransaction()) {
+        LogError("An edit transaction is already started");
+        return false;
+    }
+
+    // Keep the IDs for the edit actions after a roll back
+    m_editUndoLog = this->GetMEI("{\"removeIds\": false}");
+    if (m_editUndoLog.empty()) {
+        LogError("The undo log of the edit transaction could not be created");
+        return false;
+    }
+
+    m_editorToolkit->BeginTransaction();
+
+    return true;
+}
+
+bool Toolkit::CommitEditTransaction()
+{
+    this->ResetLogBuffer();
+
+    if (!m_editorToolkit || !m_editorToolkit->IsInTransaction()) {
+        LogError("No edit transaction to commit");
+        return false;
+    }
+
+    m_editUndoLog.clear();
+    m_layoutStages = LAYOUT_STAGE_ALL;
+
+    return m_editorToolkit->CommitTransaction();
+}
+
+bool Toolkit::RollbackEditTransaction()
+{
+    this->ResetLogBuffer();
+
+    if (!m_editorToolkit || !m_editorToolkit->IsInTransaction()) {
+        LogError("No edit transaction to roll back");
+        return false;
+    }
+
+    m_editorToolkit->AbortTransaction();
+
+    std::string undoLog;
+    std::swap(undoLog, m_editUndoLog);
+
+    // The undo log is always MEI
+    const FileFormat inputFrom = m_inputFrom;
+    m_inputFrom = MEI;
+    const bool success = this->LoadData(undoLog);
+    m_inputFrom = inputFrom;
+
+    return success;
+}
+
 std::string Toolkit::GetLog()
 {
     std::string str;
-    for (const std::string &logStr : logBuffer) {
-        str += logStr;
+    for (const LogBuffer::Entry &entry : logBuffer.GetEntries()) {
+        str += entry.m_message;
+    }
+    if (logBuffer.GetDroppedCount() > 0) {
+        str += StringFormat(
+            "[Warning] %d more messages were not logged because the log buffer is full\n", logBuffer.GetDroppedCount());
     }
     return str;
 }
 
+std::string Toolkit::GetLogEntries()
+{
+    jsonxx::Array entries;
+    for (const LogBuffer::Entry &entry : logBuffer.GetEntries()) {
+        // Remove the level prefix and the newline added by LogError, LogWarning, etc.
+        std::string message = entry.m_message;
+        if (message.starts_with("[")) {
+            const size_t prefixEnd = message.find("] ");
+            if (prefixEnd != std::string::npos) message.erase(0, prefixEnd + 2);
+        }
+        if (message.ends_with("\n")) message.pop_back();
+
+        jsonxx::Object jsonEntry;
+        switch (entry.m_level) {
+            case LOG_ERROR: jsonEntry << "level" << "error"; break;
+            case LOG_WARNING: jsonEntry << "level" << "warning"; break;
+            case LOG_INFO: jsonEntry << "level" << "info"; break;
+            default: jsonEntry << "level" << "debug"; break;
+        }
+        jsonEntry << "count" << entry.m_count;
+        jsonEntry << "message" << message;
+        entries << jsonEntry;
+    }
+    if (logBuffer.GetDroppedCount() > 0) {
+        jsonxx::Object jsonEntry;
+        jsonEntry << "level" << "warning";
+        jsonEntry << "count" << logBuffer.GetDroppedCount();
+        jsonEntry << "message" << "Messages not logged because the log buffer is full";
+        entries << jsonEntry;
+    }
+    return entries.json();
+}
+
+std::string Toolkit::GetProfile()
+{
+    return Profiler::GetJson();
+}
+
 std::string Toolkit::GetVersion() const
 {
     return vrv::GetVersion();
@@ -1455,12 +1654,13 @@ void Toolkit::ResetXmlIdSeed(int seed)
 
 void Toolkit::ResetLogBuffer()
 {
-    logBuffer.clear();
+    logBuffer.Clear();
 }
 
 void Toolkit::RedoLayout(const std::string &jsonOptions)
 {
     bool resetCache = true;
+    int layoutStages = this->GetInvalidatedLayoutStages();
 
     jsonxx::Object json;
 
@@ -1469,10 +1669,14 @@ void Toolkit::RedoLayout(const std::string &jsonOptions)
         if (!json.parse(jsonOptions)) {
             LogWarning("Cannot parse JSON std::string. Using default options.");
         }
-        else {
-            if (json.has<jsonxx::Boolean>("resetCache")) resetCache = json.get<jsonxx::Boolean>("resetCache");
+        else if (json.has<jsonxx::Boolean>("resetCache")) {
+            resetCache = json.get<jsonxx::Boolean>("resetCache");
+            // The entire layout is redone when the cache behavior is given
+            layoutStages = LAYOUT_STAGE_ALL;
         }
     }
+    // A new selection changes the content of the systems
+    if (m_docSelection.m_isPending) layoutStages = LAYOUT_STAGE_ALL;
 
     this->ResetLogBuffer();
 
@@ -1481,6 +1685,19 @@ void Toolkit::RedoLayout(const std::string &jsonOptions)
         return;
     }
 
+    this->ResetLayoutStages();
+
+    // Nothing affecting the layout has changed
+    if (layoutStages == LAYOUT_STAGE_NONE) return;
+
+    // Only the pages need to be cast off again
+    if ((layoutStages == LAYOUT_STAGE_PAGES) && m_doc.CanCastOffPagesDoc()) {
+        m_doc.CastOffPagesDoc();
+        return;
+    }
+
+    // Otherwise the entire layout is redone. The vertical layout cannot be redone alone because it depends on the
+    // horizontal layout of the single page, which is not kept once the pages have been laid out.
     if (m_docSelection.m_isPending) {
         m_doc.InitSelectionDoc(m_docSelection, resetCache);
     }
@@ -1502,6 +1719,38 @@ void Toolkit::RedoLayout(const std::string &jsonOptions)
     }
 }
 
+void Toolkit::ResetLayoutStages()
+{
+    m_layoutOptionValues.clear();
+    for (const auto &[key, option] : *m_options->GetItems()) {
+        m_layoutOptionValues[key] = option->GetStrValue();
+    }
+    m_layoutScale = m_options->m_scale.GetValue();
+    m_layoutStages = LAYOUT_STAGE_NONE;
+}
+
+int Toolkit::GetInvalidatedLayoutStages() const
+{
+    int layoutStages = m_layoutStages;
+    for (const auto &[key, option] : *m_options->GetItems()) {
+        if (layoutStages == LAYOUT_STAGE_ALL) break;
+        auto value = m_layoutOptionValues.find(key);
+        if ((value == m_layoutOptionValues.end()) || (value->second != option->GetStrValue())) {
+            layoutStages |= option->GetLayoutStages();
+        }
+    }
+    // The scale changes the page size only when scaling to it
+    if (m_options->m_scaleToPageSize.GetValue() && (m_layoutScale != m_options->m_scale.GetValue())) {
+        layoutStages |= LAYOUT_STAGE_SYSTEMS;
+    }
+    return layoutStages;
+}
+
+void Toolkit::ContinueLayout(int pageNo)
+{
+    m_doc.CastOffPendingPages((pageNo > 0) ? pageNo - 1 : VRV_UNSET);
+}
+
 void Toolkit::RedoPagePitchPosLayout()
 {
     this->ResetLogBuffer();
@@ -1518,6 +1767,9 @@ void Toolkit::RedoPagePitchPosLayout()
 
 bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
 {
+    // With a progressive layout, make sure the page is final
+    m_doc.CastOffPendingPages(pageNo - 1);
+
     if (pageNo > this->GetPageCount()) {
         LogWarning("Page %d does not exist", pageNo);
         return false;
@@ -1581,10 +1833,133 @@ std::string Toolkit::RenderData(const std::string &data, const std::string &json
     return "";
 }
 
+std::string Toolkit::RenderIncipitsToSVG(const std::string &jsonIncipits, const std::string &jsonOptions)
+{
+    this->ResetLogBuffer();
+
+    ProfilerStage profilerStage("renderIncipitsToSVG");
+
+    jsonxx::Object json;
+    if (!jsonOptions.empty() && !json.parse(jsonOptions)) {
+        LogError("Cannot parse JSON std::string. The incipits are not rendered.");
+        return "";
+    }
+    const bool spriteSheet = json.has<jsonxx::Boolean>("spriteSheet") && json.get<jsonxx::Boolean>("spriteSheet");
+    const bool xmlDeclaration
+        = json.has<jsonxx::Boolean>("xmlDeclaration") && json.get<jsonxx::Boolean>("xmlDeclaration");
+
+    jsonxx::Array incipits;
+    if (!incipits.parse(jsonIncipits)) {
+        LogError("Cannot parse the incipits. They must be given as a JSON array.");
+        return (spriteSheet) ? "" : "[]";
+    }
+    // The incipits are given as strings or as JSON objects (e.g., Plaine & Easie with keys)
+    std::vector<std::string> data;
+    for (size_t i = 0; i < incipits.size(); ++i) {
+        if (incipits.has<jsonxx::String>((int)i)) {
+            data.push_back(incipits.get<jsonxx::String>((int)i));
+        }
+        else if (incipits.has<jsonxx::Object>((int)i)) {
+            data.push_back(incipits.get<jsonxx::Object>((int)i).json());
+        }
+        else {
+            // Logged as not loaded when rendering
+            data.push_back("");
+        }
+    }
+
+    // The incipits fit on one system of an adjusted page, so the cast-off and the header and footer are skipped
+    jsonxx::Object incipitOptions;
+    incipitOptions << "breaks"
+                   << "none";
+    incipitOptions << "adjustPageHeight" << true;
+    incipitOptions << "header"
+                   << "none";
+    incipitOptions << "footer"
+                   << "none";
+    const std::string defaultOptions = incipitOptions.json();
+    const std::string userOptions = (json.has<jsonxx::Object>("options")) ? json.get<jsonxx::Object>("options").json() : "";
+
+    int threadCount = 1;
+#ifndef __EMSCRIPTEN__
+    threadCount = (json.has<jsonxx::Number>("threads")) ? (int)json.get<jsonxx::Number>("threads") : 0;
+    if (threadCount <= 0) threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+#endif
+    threadCount = std::max(1, std::min(threadCount, (int)data.size()));
+
+    // The toolkits are kept for the next calls, so the fonts are loaded only once
+    while ((int)m_incipitToolkits.size() < threadCount) {
+        m_incipitToolkits.push_back(new Toolkit(false));
+    }
+
+    // The log of each incipit is replayed in the order of the incipits
+    std::vector<std::string> svgs(data.size());
+    std::vector<LogCapture> setupLogs(threadCount);
+    std::vector<LogCapture> incipitLogs(data.size());
+    const std::string resourcePath = this->GetResourcePath();
+    const std::string font = m_doc.GetResources().GetCurrentFont();
+    const uint32_t seed = m_options->m_xmlIdSeed.GetValue();
+    std::atomic<size_t> next = 0;
+
+    auto render = [&](int worker) {
+        Toolkit *toolkit = m_incipitToolkits.at(worker);
+        setupLogs.at(worker).Start();
+        *toolkit->m_options = *m_options;
+        toolkit->m_inputFrom = m_inputFrom;
+        if ((toolkit->GetResourcePath() != resourcePath) || toolkit->m_doc.GetResources().GetCurrentFont().empty()) {
+            toolkit->SetResourcePath(resourcePath);
+        }
+        else if (toolkit->m_doc.GetResources().GetCurrentFont() != font) {
+            toolkit->SetFont(font);
+        }
+        toolkit->SetOptions(defaultOptions);
+        if (!userOptions.empty()) toolkit->SetOptions(userOptions);
+        setupLogs.at(worker).Stop();
+
+        for (size_t i = next++; i < data.size(); i = next++) {
+            incipitLogs.at(i).Start();
+            // The IDs do not depend on the thread rendering the incipit, and differ from one incipit to the other
+            // in the sprite sheet
+            if (seed != 0) Object::SeedID((spriteSheet) ? seed + (uint32_t)i : seed);
+            if (!data.at(i).empty() && toolkit->LoadData(data.at(i))) {
+                svgs.at(i) = toolkit->RenderToSVG(1, xmlDeclaration && !spriteSheet);
+            }
+            else {
+                LogError("Incipit %d could not be loaded", (int)i);
+            }
+            incipitLogs.at(i).Stop();
+        }
+    };
+
+    if (threadCount == 1) {
+        render(0);
+    }
+    else {
+        std::vector<std::thread> threads;
+        for (int worker = 0; worker < threadCount; ++worker) threads.emplace_back(render, worker);
+        for (std::thread &thread : threads) thread.join();
+    }
+
+    for (const LogCapture &log : setupLogs) log.Replay();
+    for (const LogCapture &log : incipitLogs) log.Replay();
+
+    if (spriteSheet) {
+        const int indent = (m_options->m_outputIndentTab.GetValue()) ? -1 : m_options->m_outputIndent.GetValue();
+        return SvgDeviceContext::CreateSpriteSheet(svgs, "incipit-", xmlDeclaration, indent,
+            m_options->m_svgFormatRaw.GetValue() || m_options->m_svgCompact.GetValue());
+    }
+
+    jsonxx::Array output;
+    for (const std::string &svg : svgs) output << svg;
+    return output.json();
+}
+
 std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
 {
     this->ResetLogBuffer();
 
+    ProfilerStage profilerStage("renderToSVG");
+
     int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
     // Create the SVG object, h & w come from the system
     // We will need to set the size of the page after having drawn it depending on the options
@@ -1619,6 +1994,7 @@ std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
     svg.SetHtml5(m_options->m_svgHtml5.GetValue());
     svg.SetFormatRaw(m_options->m_svgFormatRaw.GetValue());
     svg.SetRemoveXlink(m_options->m_svgRemoveXlink.GetValue());
+    svg.SetCompact(m_options->m_svgCompact.GetValue());
     svg.SetAdditionalAttributes(m_options->m_svgAdditionalAttribute.GetValue());
     svg.SetSmuflTextFont((option_SMUFLTEXTFONT)m_options->m_smuflTextFont.GetValue());
 
@@ -1649,6 +2025,57 @@ bool Toolkit::RenderToSVGFile(const std::string &filename, int pageNo)
     return true;
 }
 
+std::vector<uint8_t> Toolkit::RenderToDisplayList(int pageNo)
+{
+    this->ResetLogBuffer();
+
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+
+    DisplayListDeviceContext displayList;
+    displayList.SetResources(&m_doc.GetResources());
+
+    // render the page
+    this->RenderToDeviceContext(pageNo, &displayList);
+
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+    return displayList.GetDisplayList();
+}
+
+std::vector<uint8_t> Toolkit::RenderToPNG(int pageNo)
+{
+    this->ResetLogBuffer();
+
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+
+    RasterDeviceContext raster;
+    raster.SetResources(&m_doc.GetResources());
+
+    if (m_doc.IsFacs()) {
+        raster.SetFacsimile(true);
+    }
+
+    // render the page
+    const bool rendered = this->RenderToDeviceContext(pageNo, &raster);
+
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+    return (rendered) ? raster.GetPNG() : std::vector<uint8_t>();
+}
+
+bool Toolkit::RenderToPNGFile(const std::string &filename, int pageNo)
+{
+    std::vector<uint8_t> output = this->RenderToPNG(pageNo);
+    if (output.empty()) return false;
+
+    std::ofstream outfile(filename.c_str(), std::ios::binary);
+    if (!outfile.is_open()) {
+        return false;
+    }
+
+    outfile.write((const char *)output.data(), output.size());
+    outfile.close();
+    return true;
+}
+
 std::string Toolkit::GetHumdrum()
 {
     return this->GetHumdrumBuffer();
@@ -1674,41 +2101,31 @@ void Toolkit::GetHumdrum(std::ostream &output)
     output << this->GetHumdrumBuffer();
 }
 
-#ifdef RUST_LIBRARY
-
 std::vector<uint8_t> Toolkit::RenderToMIDIBinary()
 {
     this->ResetLogBuffer();
 
+    ProfilerStage profilerStage("renderToMIDI");
+
     smf::MidiFile outputfile;
     outputfile.absoluteTicks();
     m_doc.ExportMIDI(&outputfile);
     outputfile.sortTracks();
 
-    std::stringstream stream;
+    // The file is written directly to the output bytes
+    std::vector<uint8_t> output;
+    ByteStreamBuf buffer(output);
+    std::ostream stream(&buffer);
     outputfile.write(stream);
 
-    std::string str = stream.str();
-    return std::vector<uint8_t>(str.begin(), str.end());
+    return output;
 }
 
-#endif
-
 std::string Toolkit::RenderToMIDI()
 {
-    this->ResetLogBuffer();
-
-    smf::MidiFile outputfile;
-    outputfile.absoluteTicks();
-    m_doc.ExportMIDI(&outputfile);
-    outputfile.sortTracks();
-
-    std::stringstream stream;
-    outputfile.write(stream);
-    std::string outputstr = Base64Encode(
-        reinterpret_cast<const unsigned char *>(stream.str().c_str()), (unsigned int)stream.str().length());
+    const std::vector<uint8_t> bytes = this->RenderToMIDIBinary();
 
-    return outputstr;
+    return Base64Encode(bytes.data(), (unsigned int)bytes.size());
 }
 
 std::string Toolkit::RenderToPAE()
@@ -1747,6 +2164,7 @@ std::string Toolkit::RenderToTimemap(const std::string &jsonOptions)
 {
     bool includeMeasures = false;
     bool includeRests = false;
+    bool columnar = false;
 
     jsonxx::Object json;
 
@@ -1759,13 +2177,42 @@ std::string Toolkit::RenderToTimemap(const std::string &jsonOptions)
             if (json.has<jsonxx::Boolean>("includeMeasures"))
                 includeMeasures = json.get<jsonxx::Boolean>("includeMeasures");
             if (json.has<jsonxx::Boolean>("includeRests")) includeRests = json.get<jsonxx::Boolean>("includeRests");
+            if (json.has<jsonxx::Boolean>("columnar")) columnar = json.get<jsonxx::Boolean>("columnar");
         }
     }
 
     this->ResetLogBuffer();
 
+    ProfilerStage profilerStage("renderToTimemap");
+
     std::string output;
-    m_doc.ExportTimemap(output, includeRests, includeMeasures);
+    m_doc.ExportTimemap(output, includeRests, includeMeasures, columnar);
+    return output;
+}
+
+std::vector<uint8_t> Toolkit::RenderToTimemapBinary(const std::string &jsonOptions)
+{
+    bool includeMeasures = false;
+    bool includeRests = false;
+
+    jsonxx::Object json;
+
+    // Read JSON options if not empty
+    if (!jsonOptions.empty()) {
+        if (!json.parse(jsonOptions)) {
+            LogWarning("Cannot parse JSON std::string. Using default options.");
+        }
+        else {
+            if (json.has<jsonxx::Boolean>("includeMeasures"))
+                includeMeasures = json.get<jsonxx::Boolean>("includeMeasures");
+            if (json.has<jsonxx::Boolean>("includeRests")) includeRests = json.get<jsonxx::Boolean>("includeRests");
+        }
+    }
+
+    this->ResetLogBuffer();
+
+    std::vector<uint8_t> output;
+    m_doc.ExportTimemapBinary(output, includeRests, includeMeasures);
     return output;
 }
 
@@ -1793,6 +2240,9 @@ std::string Toolkit::GetElementsAtTime(int millisec)
         m_doc.CalculateTimemap();
     }
 
+    // The page number of the measure is returned
+    m_doc.CastOffPendingPages();
+
     MeasureOnsetOffsetComparison matchMeasureTime(millisec);
     Measure *measure = dynamic_cast<Measure *>(m_doc.FindDescendantByComparison(&matchMeasureTime));
 
@@ -1827,7 +2277,7 @@ std::string Toolkit::GetElementsAtTime(int millisec)
             restArray << object->GetID();
         }
     }
-    chords.unique();
+    chords.erase(std::unique(chords.begin(), chords.end()), chords.end());
     for (Object *object : chords) {
         chordArray << object->GetID();
     }
@@ -1841,6 +2291,63 @@ std::string Toolkit::GetElementsAtTime(int millisec)
     return o.json();
 }
 
+std::string Toolkit::GetElementsAtPosition(const std::string &jsonOptions)
+{
+    this->ResetLogBuffer();
+
+    jsonxx::Object o;
+
+    if (!m_doc.IsFacs()) {
+        LogWarning("Elements can be looked for by position only with a document rendered from its facsimile");
+        return o.json();
+    }
+
+    jsonxx::Object json;
+    if (!json.parse(jsonOptions)) {
+        LogError("Cannot parse JSON std::string.");
+        return o.json();
+    }
+
+    std::vector<ClassId> classIds;
+    if (json.has<jsonxx::Array>("types")) {
+        std::vector<std::string> types;
+        jsonxx::Array array = json.get<jsonxx::Array>("types");
+        for (int i = 0; i < (int)array.size(); ++i) {
+            if (array.has<jsonxx::String>(i)) types.push_back(array.get<jsonxx::String>(i));
+        }
+        ObjectFactory::GetInstance()->GetClassIds(types, classIds);
+        if (classIds.empty()) return o.json();
+    }
+
+    ListOfObjects objects;
+    const ZoneIndex &zoneIndex = m_doc.GetZoneIndex();
+    if (json.has<jsonxx::Number>("x") && json.has<jsonxx::Number>("y")) {
+        objects = zoneIndex.FindAtPoint(json.get<jsonxx::Number>("x"), json.get<jsonxx::Number>("y"), classIds);
+    }
+    else if (json.has<jsonxx::Number>("ulx") && json.has<jsonxx::Number>("uly") && json.has<jsonxx::Number>("lrx")
+        && json.has<jsonxx::Number>("lry")) {
+        objects = zoneIndex.FindInRect(json.get<jsonxx::Number>("ulx"), json.get<jsonxx::Number>("uly"),
+            json.get<jsonxx::Number>("lrx"), json.get<jsonxx::Number>("lry"), classIds);
+    }
+    else {
+        LogError("A point (x, y) or a rectangle (ulx, uly, lrx, lry) is required");
+        return o.json();
+    }
+
+    // Group the IDs by element name, in the document order
+    std::map<std::string, jsonxx::Array> arrays;
+    for (Object *object : objects) {
+        std::string name = object->GetClassName();
+        name.front() = std::tolower(name.front());
+        arrays[name] << object->GetID();
+    }
+    for (const auto &[name, array] : arrays) {
+        o << name << array;
+    }
+
+    return o.json();
+}
+
 bool Toolkit::RenderToMIDIFile(const std::string &filename)
 {
     this->ResetLogBuffer();
@@ -1885,6 +2392,11 @@ int Toolkit::GetPageCount() const
     return m_doc.GetPageCount();
 }
 
+bool Toolkit::IsPageCountFinal() const
+{
+    return !m_doc.HasPendingCastOff();
+}
+
 std::string Toolkit::GetDescriptiveFeatures(const std::string &options)
 {
     // For now do not handle any option
@@ -1893,8 +2405,77 @@ std::string Toolkit::GetDescriptiveFeatures(const std::string &options)
     return output;
 }
 
+bool Toolkit::AddToFeatureIndex(const std::string &documentId)
+{
+    this->ResetLogBuffer();
+
+    if (this->GetPageCount() == 0) {
+        LogWarning("No data loaded");
+        return false;
+    }
+
+    FeatureExtractor extractor("");
+    if (!m_doc.ExtractFeatures(extractor)) return false;
+    if (!m_featureIndex) m_featureIndex = new FeatureIndex();
+    m_featureIndex->AddDocument(documentId, extractor);
+    return true;
+}
+
+void Toolkit::ResetFeatureIndex(const std::string &jsonOptions)
+{
+    int ngramSize = 4;
+
+    jsonxx::Object json;
+    if (!jsonOptions.empty()) {
+        if (!json.parse(jsonOptions)) {
+            LogWarning("Cannot parse JSON std::string. Using default options.");
+        }
+        else if (json.has<jsonxx::Number>("ngramSize")) {
+            ngramSize = json.get<jsonxx::Number>("ngramSize");
+        }
+    }
+
+    if (!m_featureIndex) m_featureIndex = new FeatureIndex(ngramSize);
+    m_featureIndex->Reset(ngramSize);
+}
+
+bool Toolkit::LoadFeatureIndexFile(const std::string &filename)
+{
+    this->ResetLogBuffer();
+
+    std::ifstream input(filename, std::ios::binary);
+    if (!input.is_open()) {
+        LogError("Unable to open the feature index file %s", filename.c_str());
+        return false;
+    }
+    if (!m_featureIndex) m_featureIndex = new FeatureIndex();
+    return m_featureIndex->Read(input);
+}
+
+bool Toolkit::SaveFeatureIndexFile(const std::string &filename)
+{
+    this->ResetLogBuffer();
+
+    std::ofstream output(filename, std::ios::binary);
+    if (!output.is_open()) {
+        return false;
+    }
+    if (!m_featureIndex) m_featureIndex = new FeatureIndex();
+    return m_featureIndex->Write(output);
+}
+
+std::string Toolkit::SearchFeatureIndex(const std::string &jsonQuery)
+{
+    this->ResetLogBuffer();
+
+    if (!m_featureIndex) m_featureIndex = new FeatureIndex();
+    return m_featureIndex->Search(jsonQuery);
+}
+
 int Toolkit::GetPageWithElement(const std::string &xmlId)
 {
+    m_doc.CastOffPendingPages();
+
     Object *element = m_doc.FindDescendantByID(xmlId);
     if (!element) {
         LogWarning("Element '%s' not found", xmlId.c_str());
@@ -1929,7 +2510,7 @@ int Toolkit::GetTimeForElement(const std::string &xmlId)
     if (element->Is(NOTE)) {
         Note *note = vrv_cast<Note *>(element);
         assert(note);
-        Measure *measure = vrv_cast<Measure *>(note->GetFirstAncestor(MEASURE));
+        Measure *measure = note->GetAncestorMeasure();
         assert(measure);
         // For now ignore repeats and access always the first
         timeofElement = measure->GetRealTimeOffsetMilliseconds(1);
@@ -1946,7 +2527,7 @@ int Toolkit::GetTimeForElement(const std::string &xmlId)
         assert(chord);
         Note *note = vrv_cast<Note *>(chord->FindDescendantByType(NOTE));
         assert(note);
-        Measure *measure = vrv_cast<Measure *>(note->GetFirstAncestor(MEASURE));
+        Measure *measure = note->GetAncestorMeasure();
         assert(measure);
         // For now ignore repeats and access always the first
         timeofElement = measure->GetRealTimeOffsetMilliseconds(1);
@@ -1986,7 +2567,7 @@ std::string Toolkit::GetTimesForElement(const std::string &xmlId)
 
         Note *note = vrv_cast<Note *>(element);
         assert(note);
-        Measure *measure = vrv_cast<Measure *>(note->GetFirstAncestor(MEASURE));
+        Measure *measure = note->GetAncestorMeasure();
         assert(measure);
 
         // For now ignore repeats and access always the first
@@ -2107,6 +2688,16 @@ const char *Toolkit::GetCString()
     }
 }
 
+void Toolkit::SetCBuffer(std::vector<uint8_t> &&data)
+{
+    m_cBuffer = std::move(data);
+}
+
+const uint8_t *Toolkit::GetCBuffer() const
+{
+    return (m_cBuffer.empty()) ? NULL : m_cBuffer.data();
+}
+
 void Toolkit::ClearHumdrumBuffer()
 {
 #ifndef NO_HUMDRUM_SUPPORT
@@ -2199,21 +2790,6 @@ std::string Toolkit::ConvertHumdrumToMIDI(const std::string &humdrumData)
 #endif
 }
 
-void Toolkit::SetLocale()
-{
-    if (m_options->m_setLocale.GetValue() && !m_previousLocale) {
-        // Required for proper formatting, e.g., in StringFormat (see vrv.cpp)
-        m_previousLocale = std::locale::global(std::locale::classic());
-    }
-}
-
-void Toolkit::ResetLocale()
-{
-    if (m_previousLocale) {
-        std::locale::global(*m_previousLocale);
-    }
-}
-
 void Toolkit::InitClock()
 {
 #ifndef NO_RUNTIME
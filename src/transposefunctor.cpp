@@ -121,7 +121,7 @@ FunctorCode TransposeFunctor::VisitRest(Rest *rest)
 
     // Find whether current layer is top, middle (either one if multiple) or bottom
     Staff *parentStaff = rest->GetAncestorStaff();
-    Layer *parentLayer = vrv_cast<Layer *>(rest->GetFirstAncestor(LAYER));
+    Layer *parentLayer = rest->GetAncestorLayer();
     assert(parentLayer);
 
     ListOfObjects objects = parentStaff->FindAllDescendantsByType(LAYER, false);
@@ -137,7 +137,7 @@ void Tuplet::AddChild(Object *child)
         children.push_back(child);
     }
 
-    Modify();
+    this->ModifyFor(child);
 }
 
 void Tuplet::FilterList(ListOfConstObjects &childList) const
@@ -209,8 +209,8 @@ void View::DrawTimeSpanningElement(DeviceContext *dc, Object *element, System *s
     }
 
     // Get the parent system of the first and last note
-    System *parentSystem1 = vrv_cast<System *>(start->GetFirstAncestor(SYSTEM));
-    System *parentSystem2 = vrv_cast<System *>(end->GetFirstAncestor(SYSTEM));
+    System *parentSystem1 = start->GetAncestorSystem();
+    System *parentSystem2 = end->GetAncestorSystem();
 
     int x1, x2;
     Object *objectX = NULL;
@@ -1272,7 +1272,7 @@ void View::DrawSylConnector(
         // If we do not want to show hyphens at the start of a system and the end is at time 0.0
         if (m_options->m_lyricNoStartHyphen.GetValue() && (syl->GetEnd()->GetAlignment()->GetTime() == 0.0)) {
             // Return but only if the end is in the first measure of the system...
-            Measure *measure = vrv_cast<Measure *>(syl->GetEnd()->GetFirstAncestor(MEASURE));
+            Measure *measure = syl->GetEnd()->GetAncestorMeasure();
             assert(measure);
             System *system = vrv_cast<System *>(measure->GetFirstAncestor(SYSTEM));
             assert(system);
@@ -2697,8 +2697,8 @@ void View::DrawTurn(DeviceContext *dc, Turn *turn, Measure *measure, System *sys
     if (turn->m_drawingEndElement) {
         // Get the parent system of the start and end element
         LayerElement *end = turn->m_drawingEndElement;
-        Object *parentSystem1 = turn->GetStart()->GetFirstAncestor(SYSTEM);
-        Object *parentSystem2 = end->GetFirstAncestor(SYSTEM);
+        Object *parentSystem1 = turn->GetStart()->GetAncestorSystem();
+        Object *parentSystem2 = end->GetAncestorSystem();
         // We have a system break, use the measure right bar line instead
         if (parentSystem1 != parentSystem2) end = measure->GetRightBarLine();
         x += ((end->GetDrawingX() - x) / 2);
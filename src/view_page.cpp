@@ -892,7 +892,7 @@ void View::DrawBarLine(DeviceContext *dc, int yTop, int yBottom, BarLine *barLin
     SegmentedLine line(yTop, yBottom);
     // We do not need to do this during layout calculation
     if (eraseIntersections && !dc->Is(BBOX_DEVICE_CONTEXT)) {
-        System *system = vrv_cast<System *>(barLine->GetFirstAncestor(SYSTEM));
+        System *system = barLine->GetAncestorSystem();
         if (system) {
             int minX = x - barLineWidth / 2;
             int maxX = x + barLineWidth / 2;
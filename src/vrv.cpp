@@ -9,6 +9,7 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cmath>
@@ -23,6 +24,10 @@
 
 #ifndef _WIN32
 #include <dirent.h>
+#include <locale.h>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
 #else
 #include "win_dirent.h"
 #include "win_time.h"
@@ -82,15 +87,18 @@ namespace vrv {
 //----------------------------------------------------------------------------
 
 /** Global for LogElapsedTimeXXX functions (debugging purposes) */
-struct timeval start;
+thread_local struct timeval start;
 
 /** For controlling the log level - warning level enabled by default */
-LogLevel logLevel = LOG_WARNING;
+std::atomic<LogLevel> logLevel = LOG_WARNING;
 
 /** By default log to stderr or JS console */
-bool loggingToBuffer = false;
+std::atomic<bool> loggingToBuffer = false;
+
+thread_local LogBuffer logBuffer;
 
-std::vector<std::string> logBuffer;
+/** The maximum number of distinct messages in the log buffer */
+std::atomic<int> logBufferMaxSize = 10000;
 
 #ifdef RUST_LIBRARY
 
@@ -181,11 +189,13 @@ void LogWarning(const char *fmt, ...)
 
 void LogString(std::string message, LogLevel level)
 {
+    // Captured messages are logged later (see LogCapture::Replay)
+    if (LogCapture::Capture(message, level)) return;
+
     HANDLE_INTERCEPTOR(level, message);
 
     if (loggingToBuffer) {
-        if (LogBufferContains(message)) return;
-        logBuffer.push_back(message);
+        logBuffer.Add(message, level);
     }
     else {
 #ifdef __EMSCRIPTEN__
@@ -224,10 +234,64 @@ LogLevel StrToLogLevel(const std::string &level)
 
 bool LogBufferContains(const std::string &s)
 {
-    for (const std::string &logStr : logBuffer) {
-        if (logStr == s) return true;
+    return logBuffer.Contains(s);
+}
+
+//----------------------------------------------------------------------------
+// LogBuffer
+//----------------------------------------------------------------------------
+
+void LogBuffer::Add(const std::string &message, LogLevel level)
+{
+    auto iter = m_index.find(message);
+    if (iter != m_index.end()) {
+        ++m_entries.at(iter->second).m_count;
+        return;
+    }
+    if ((int)m_entries.size() >= logBufferMaxSize) {
+        ++m_droppedCount;
+        return;
     }
-    return false;
+    m_index.emplace(message, (int)m_entries.size());
+    m_entries.push_back({ message, level, 1 });
+}
+
+void LogBuffer::Clear()
+{
+    m_entries.clear();
+    m_index.clear();
+    m_droppedCount = 0;
+}
+
+//----------------------------------------------------------------------------
+// LogCapture
+//----------------------------------------------------------------------------
+
+thread_local LogCapture *LogCapture::s_current = NULL;
+
+void LogCapture::Start()
+{
+    m_previous = s_current;
+    s_current = this;
+}
+
+void LogCapture::Stop()
+{
+    assert(s_current == this);
+    s_current = m_previous;
+    m_previous = NULL;
+}
+
+void LogCapture::Replay() const
+{
+    for (const auto &[message, level] : m_messages) LogString(message, level);
+}
+
+bool LogCapture::Capture(const std::string &message, LogLevel level)
+{
+    if (!s_current) return false;
+    s_current->m_messages.push_back({ message, level });
+    return true;
 }
 
 bool Check(Object *object)
@@ -250,29 +314,73 @@ void EnableLogToBuffer(bool value)
     loggingToBuffer = value;
 }
 
+void SetLogBufferMaxSize(int size)
+{
+    logBufferMaxSize = std::max(size, 0);
+}
+
 //----------------------------------------------------------------------------
 // Various helpers
 //----------------------------------------------------------------------------
 
+/**
+ * The C locale used for formatting and parsing numbers.
+ * It is never changed for the process but only for the current thread (or passed to the functions on Windows).
+ */
+#ifdef _WIN32
+static _locale_t GetCLocale()
+{
+    static _locale_t cLocale = _create_locale(LC_NUMERIC, "C");
+    return cLocale;
+}
+#else
+static locale_t GetCLocale()
+{
+    static locale_t cLocale = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+    return cLocale;
+}
+#endif
+
 std::string StringFormat(const char *fmt, ...)
 {
-    std::string str(STRING_FORMAT_MAX_LEN, 0);
     va_list args;
     va_start(args, fmt);
-    vsnprintf(&str[0], STRING_FORMAT_MAX_LEN, fmt, args);
+    std::string str = StringFormatVariable(fmt, args);
     va_end(args);
-    str.resize(strlen(str.data()));
     return str;
 }
 
 std::string StringFormatVariable(const char *format, va_list arg)
 {
     std::string str(STRING_FORMAT_MAX_LEN, 0);
+#ifdef _WIN32
+    _vsnprintf_s_l(&str[0], STRING_FORMAT_MAX_LEN, _TRUNCATE, format, GetCLocale(), arg);
+#else
+    locale_t previousLocale = uselocale(GetCLocale());
     vsnprintf(&str[0], STRING_FORMAT_MAX_LEN, format, arg);
+    uselocale(previousLocale);
+#endif
     str.resize(strlen(str.data()));
     return str;
 }
 
+double StringToDouble(const std::string &value)
+{
+    return StringToDouble(value.c_str(), NULL);
+}
+
+double StringToDouble(const char *value, char **end)
+{
+#ifdef _WIN32
+    return _strtod_l(value, end, GetCLocale());
+#else
+    locale_t previousLocale = uselocale(GetCLocale());
+    const double result = strtod(value, end);
+    uselocale(previousLocale);
+    return result;
+#endif
+}
+
 bool AreEqual(double dFirstVal, double dSecondVal)
 {
     return std::fabs(dFirstVal - dSecondVal) < 1E-3;
@@ -365,6 +473,24 @@ std::string BaseEncodeInt(uint32_t value, uint8_t base)
     return base62;
 }
 
+bool BaseDecodeInt(const std::string &encoded, uint8_t base, uint32_t &value)
+{
+    assert(base > 10);
+    assert(base < 63);
+
+    if (encoded.empty() || ((encoded.size() > 1) && (encoded.at(0) == '0'))) return false;
+
+    uint64_t decoded = 0;
+    for (char c : encoded) {
+        const size_t digit = base62Chars.find(c);
+        if (digit >= base) return false;
+        decoded = decoded * base + digit;
+        if (decoded > UINT32_MAX) return false;
+    }
+    value = (uint32_t)decoded;
+    return true;
+}
+
 std::string FromCamelCase(const std::string &s)
 {
     std::regex regExp1("(.)([A-Z][a-z]+)");
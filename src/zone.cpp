@@ -47,6 +47,9 @@ void Zone::ShiftByXY(int xDiff, int yDiff)
     this->SetLrx(this->GetLrx() + xDiff);
     this->SetUly(this->GetUly() + yDiff);
     this->SetLry(this->GetLry() + yDiff);
+
+    // Invalidate the extents of the facsimile
+    this->Modify();
 }
 
 int Zone::GetLogicalUly() const
@@ -0,0 +1,255 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        zoneindex.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "zoneindex.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <queue>
+
+//----------------------------------------------------------------------------
+
+#include "comparison.h"
+#include "facsimileinterface.h"
+#include "object.h"
+#include "zone.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// ZoneIndex
+//----------------------------------------------------------------------------
+
+ZoneIndex::ZoneIndex()
+{
+    m_isBuilt = false;
+}
+
+ZoneIndex::~ZoneIndex() {}
+
+void ZoneIndex::Reset()
+{
+    m_trees.clear();
+    m_isBuilt = false;
+}
+
+void ZoneIndex::Build(Object *root)
+{
+    assert(root);
+
+    this->Reset();
+
+    ListOfObjects objects;
+    InterfaceComparison comparison(INTERFACE_FACSIMILE);
+    root->FindAllDescendantsByComparison(&objects, &comparison);
+
+    int order = 0;
+    for (Object *object : objects) {
+        const FacsimileInterface *interface = object->GetFacsimileInterface();
+        assert(interface);
+        const Zone *zone = interface->GetZone();
+        if (!zone) continue;
+
+        ZoneIndexEntry entry;
+        entry.m_ulx = std::min(zone->GetUlx(), zone->GetLrx());
+        entry.m_lrx = std::max(zone->GetUlx(), zone->GetLrx());
+        entry.m_uly = std::min(zone->GetUly(), zone->GetLry());
+        entry.m_lry = std::max(zone->GetUly(), zone->GetLry());
+        // Extend the box with the vertical offset at the right of a rotated zone
+        if (zone->GetRotate() != 0.0) {
+            const int offset = (entry.m_lrx - entry.m_ulx) * tan(zone->GetRotate() * M_PI / 180.0);
+            entry.m_uly = std::min(entry.m_uly, entry.m_uly + offset);
+            entry.m_lry = std::max(entry.m_lry, entry.m_lry + offset);
+        }
+        entry.m_object = object;
+        entry.m_zone = zone;
+        entry.m_order = order++;
+        m_trees[object->GetClassId()].m_entries.push_back(entry);
+    }
+
+    for (auto &[classId, tree] : m_trees) {
+        this->BuildTree(tree);
+    }
+
+    m_isBuilt = true;
+}
+
+void ZoneIndex::BuildTree(Tree &tree)
+{
+    std::vector<ZoneIndexEntry> &entries = tree.m_entries;
+    const int entryCount = (int)entries.size();
+    if (entryCount == 0) return;
+
+    // Sort-tile-recursive packing: sort the entries by x in vertical slices and each slice by y
+    const int leafCount = (entryCount + ZONEINDEX_NODE_SIZE - 1) / ZONEINDEX_NODE_SIZE;
+    const int sliceSize = ceil(sqrt(leafCount)) * ZONEINDEX_NODE_SIZE;
+    std::sort(entries.begin(), entries.end(), [](const ZoneIndexEntry &a, const ZoneIndexEntry &b) {
+        return (a.m_ulx + a.m_lrx < b.m_ulx + b.m_lrx);
+    });
+    for (int i = 0; i < entryCount; i += sliceSize) {
+        std::sort(entries.begin() + i, entries.begin() + std::min(i + sliceSize, entryCount),
+            [](const ZoneIndexEntry &a, const ZoneIndexEntry &b) { return (a.m_uly + a.m_lry < b.m_uly + b.m_lry); });
+    }
+
+    // The leaves
+    for (int i = 0; i < entryCount; i += ZONEINDEX_NODE_SIZE) {
+        ZoneIndexNode node = { entries.at(i).m_ulx, entries.at(i).m_uly, entries.at(i).m_lrx, entries.at(i).m_lry, i,
+            std::min(ZONEINDEX_NODE_SIZE, entryCount - i), true };
+        for (int j = i + 1; j < i + node.m_count; ++j) {
+            node.m_ulx = std::min(node.m_ulx, entries.at(j).m_ulx);
+            node.m_uly = std::min(node.m_uly, entries.at(j).m_uly);
+            node.m_lrx = std::max(node.m_lrx, entries.at(j).m_lrx);
+            node.m_lry = std::max(node.m_lry, entries.at(j).m_lry);
+        }
+        tree.m_nodes.push_back(node);
+    }
+
+    // The levels above until there is a single root node. Nodes are already grouped spatially
+    int levelStart = 0;
+    int levelEnd = (int)tree.m_nodes.size();
+    while (levelEnd - levelStart > 1) {
+        for (int i = levelStart; i < levelEnd; i += ZONEINDEX_NODE_SIZE) {
+            const ZoneIndexNode &firstChild = tree.m_nodes.at(i);
+            ZoneIndexNode node = { firstChild.m_ulx, firstChild.m_uly, firstChild.m_lrx, firstChild.m_lry, i,
+                std::min(ZONEINDEX_NODE_SIZE, levelEnd - i), false };
+            for (int j = i + 1; j < i + node.m_count; ++j) {
+                const ZoneIndexNode &child = tree.m_nodes.at(j);
+                node.m_ulx = std::min(node.m_ulx, child.m_ulx);
+                node.m_uly = std::min(node.m_uly, child.m_uly);
+                node.m_lrx = std::max(node.m_lrx, child.m_lrx);
+                node.m_lry = std::max(node.m_lry, child.m_lry);
+            }
+            tree.m_nodes.push_back(node);
+        }
+        levelStart = levelEnd;
+        levelEnd = (int)tree.m_nodes.size();
+    }
+}
+
+ListOfObjects ZoneIndex::FindAtPoint(int x, int y, const std::vector<ClassId> &classIds) const
+{
+    std::vector<const ZoneIndexEntry *> entries;
+    for (const auto &[classId, tree] : m_trees) {
+        if (!classIds.empty() && (std::find(classIds.begin(), classIds.end(), classId) == classIds.end())) continue;
+        this->FindInTree(tree, x, y, x, y, entries, true);
+    }
+    std::sort(entries.begin(), entries.end(),
+        [](const ZoneIndexEntry *a, const ZoneIndexEntry *b) { return (a->m_order < b->m_order); });
+
+    ListOfObjects objects;
+    for (const ZoneIndexEntry *entry : entries) objects.push_back(entry->m_object);
+    return objects;
+}
+
+ListOfObjects ZoneIndex::FindInRect(int ulx, int uly, int lrx, int lry, const std::vector<ClassId> &classIds) const
+{
+    std::vector<const ZoneIndexEntry *> entries;
+    for (const auto &[classId, tree] : m_trees) {
+        if (!classIds.empty() && (std::find(classIds.begin(), classIds.end(), classId) == classIds.end())) continue;
+        this->FindInTree(tree, std::min(ulx, lrx), std::min(uly, lry), std::max(ulx, lrx), std::max(uly, lry),
+            entries, false);
+    }
+    std::sort(entries.begin(), entries.end(),
+        [](const ZoneIndexEntry *a, const ZoneIndexEntry *b) { return (a->m_order < b->m_order); });
+
+    ListOfObjects objects;
+    for (const ZoneIndexEntry *entry : entries) objects.push_back(entry->m_object);
+    return objects;
+}
+
+void ZoneIndex::FindInTree(const Tree &tree, int ulx, int uly, int lrx, int lry,
+    std::vector<const ZoneIndexEntry *> &entries, bool exactHit) const
+{
+    if (tree.m_nodes.empty()) return;
+
+    std::vector<int> stack = { (int)tree.m_nodes.size() - 1 };
+    while (!stack.empty()) {
+        const ZoneIndexNode &node = tree.m_nodes.at(stack.back());
+        stack.pop_back();
+        if ((node.m_ulx > lrx) || (node.m_lrx < ulx) || (node.m_uly > lry) || (node.m_lry < uly)) continue;
+        for (int i = node.m_first; i < node.m_first + node.m_count; ++i) {
+            if (!node.m_isLeaf) {
+                stack.push_back(i);
+                continue;
+            }
+            const ZoneIndexEntry &entry = tree.m_entries.at(i);
+            if ((entry.m_ulx > lrx) || (entry.m_lrx < ulx) || (entry.m_uly > lry) || (entry.m_lry < uly)) continue;
+            // The box of a rotated zone is larger than the zone
+            if (exactHit && (GetDistance(entry.m_zone, ulx, uly) > 0.0)) continue;
+            entries.push_back(&entry);
+        }
+    }
+}
+
+Object *ZoneIndex::FindClosest(int x, int y, ClassId classId) const
+{
+    auto iter = m_trees.find(classId);
+    if ((iter == m_trees.end()) || iter->second.m_nodes.empty()) return NULL;
+    const Tree &tree = iter->second;
+
+    // Best-first search with the distance to the box of the nodes as lower bound
+    using QueueItem = std::pair<double, int>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+    queue.push({ 0.0, (int)tree.m_nodes.size() - 1 });
+
+    const ZoneIndexEntry *closest = NULL;
+    double closestDistance = 0.0;
+    while (!queue.empty()) {
+        const auto [distance, nodeIdx] = queue.top();
+        queue.pop();
+        // Nodes at the same distance can still contain an element before in the document order
+        if (closest && (distance > closestDistance)) break;
+
+        const ZoneIndexNode &node = tree.m_nodes.at(nodeIdx);
+        for (int i = node.m_first; i < node.m_first + node.m_count; ++i) {
+            if (!node.m_isLeaf) {
+                const ZoneIndexNode &child = tree.m_nodes.at(i);
+                queue.push({ GetBoxDistance(child.m_ulx, child.m_uly, child.m_lrx, child.m_lry, x, y), i });
+                continue;
+            }
+            const ZoneIndexEntry &entry = tree.m_entries.at(i);
+            const double entryDistance = GetDistance(entry.m_zone, x, y);
+            if (!closest || (entryDistance < closestDistance)
+                || ((entryDistance == closestDistance) && (entry.m_order < closest->m_order))) {
+                closest = &entry;
+                closestDistance = entryDistance;
+            }
+        }
+    }
+
+    return (closest) ? closest->m_object : NULL;
+}
+
+double ZoneIndex::GetDistance(const Zone *zone, int x, int y)
+{
+    assert(zone);
+
+    const int ulx = std::min(zone->GetUlx(), zone->GetLrx());
+    const int lrx = std::max(zone->GetUlx(), zone->GetLrx());
+    int uly = std::min(zone->GetUly(), zone->GetLry());
+    int lry = std::max(zone->GetUly(), zone->GetLry());
+    if (zone->GetRotate() != 0.0) {
+        // The vertical offset of the rotated zone at the point, within the horizontal extent of the zone
+        const int offset = (std::clamp(x, ulx, lrx) - ulx) * tan(zone->GetRotate() * M_PI / 180.0);
+        uly += offset;
+        lry += offset;
+    }
+    return GetBoxDistance(ulx, uly, lrx, lry, x, y);
+}
+
+double ZoneIndex::GetBoxDistance(int ulx, int uly, int lrx, int lry, int x, int y)
+{
+    const int xDiff = std::max((ulx > x) ? ulx - x : 0, (x > lrx) ? x - lrx : 0);
+    const int yDiff = std::max((uly > y) ? uly - y : 0, (y > lry) ? y - lry : 0);
+
+    return sqrt(double(xDiff) * xDiff + double(yDiff) * yDiff);
+}
+
+} // namespace vrv
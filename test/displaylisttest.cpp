@@ -0,0 +1,268 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        displaylisttest.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test.h"
+
+//----------------------------------------------------------------------------
+
+#include <set>
+
+//----------------------------------------------------------------------------
+
+#include "displaylistdevicecontext.h"
+#include "pugixml.hpp"
+#include "toolkit.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace {
+
+    // A decoder of the display list checking the operands of each operation
+    class DisplayListReader {
+    public:
+        explicit DisplayListReader(const std::vector<uint8_t> &buffer) : m_buffer(buffer) {}
+
+        bool AtEnd() const { return m_position >= m_buffer.size(); }
+
+        uint8_t ReadByte()
+        {
+            VRV_CHECK(!this->AtEnd());
+            return m_buffer.at(m_position++);
+        }
+
+        uint32_t ReadUInt()
+        {
+            uint32_t value = 0;
+            for (int shift = 0;; shift += 7) {
+                VRV_CHECK(shift < 35);
+                const uint8_t byte = this->ReadByte();
+                value |= (uint32_t)(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+        }
+
+        int ReadInt()
+        {
+            const uint32_t value = this->ReadUInt();
+            return (int)(value >> 1) ^ -(int)(value & 1);
+        }
+
+        std::string ReadString()
+        {
+            const uint32_t length = this->ReadUInt();
+            VRV_CHECK(m_position + length <= m_buffer.size());
+            const std::string value(m_buffer.begin() + m_position, m_buffer.begin() + m_position + length);
+            m_position += length;
+            return value;
+        }
+
+        // Read a string reference and return the string (empty for none)
+        std::string ReadStringRef()
+        {
+            const uint32_t ref = this->ReadUInt();
+            if (ref == 0) return "";
+            VRV_CHECK(ref <= m_strings.size());
+            return m_strings.at(ref - 1);
+        }
+
+        // Read the points of a path segment or of a point list
+        void ReadPoints(int count)
+        {
+            for (int i = 0; i < count; ++i) {
+                this->ReadInt();
+                this->ReadInt();
+            }
+        }
+
+        std::vector<std::string> m_strings;
+        int m_glyphCount = 0;
+
+    private:
+        const std::vector<uint8_t> &m_buffer;
+        size_t m_position = 0;
+    };
+
+    const char *mei = "<mei xmlns=\"http://www.music-encoding.org/ns/mei\" meiversion=\"5.0\"><music><body><mdiv>"
+                      "<score><scoreDef><staffGrp><staffDef n=\"1\" lines=\"5\" clef.shape=\"G\" clef.line=\"2\" "
+                      "meter.count=\"3\" meter.unit=\"4\"><label>Violin</label></staffDef></staffGrp></scoreDef>"
+                      "<section><measure xml:id=\"m1\" n=\"1\"><staff n=\"1\"><layer n=\"1\">"
+                      "<beam><note xml:id=\"n1\" dur=\"8\" pname=\"c\" oct=\"5\" accid=\"s\"/>"
+                      "<note xml:id=\"n2\" dur=\"8\" pname=\"d\" oct=\"5\"/></beam>"
+                      "<note xml:id=\"n3\" dur=\"4\" pname=\"e\" oct=\"5\"><verse n=\"1\"><syl>la</syl></verse>"
+                      "</note><rest xml:id=\"r1\" dur=\"4\"/></layer></staff>"
+                      "<slur xml:id=\"s1\" startid=\"#n1\" endid=\"#n3\"/>"
+                      "<dynam xml:id=\"d1\" staff=\"1\" tstamp=\"1\">p</dynam></measure></section></score>"
+                      "</mdiv></body></music></mei>";
+
+} // namespace
+
+//----------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------
+
+VRV_TEST(displaylist, RoundTrip)
+{
+    Toolkit toolkit(false);
+    test::InitToolkit(toolkit);
+    toolkit.SetOptions("{\"xmlIdSeed\": 1}");
+    VRV_CHECK(toolkit.LoadData(mei));
+    const std::vector<uint8_t> displayList = toolkit.RenderToDisplayList(1);
+
+    DisplayListReader reader(displayList);
+    for (char c : { 'V', 'R', 'D', 'L' }) VRV_CHECK_EQUAL(reader.ReadByte(), (uint8_t)c);
+    VRV_CHECK_EQUAL((int)reader.ReadByte(), DISPLAYLIST_VERSION);
+
+    // Decode all the operations, keeping the IDs and the classes of the groups
+    std::set<std::string> ids;
+    std::set<std::string> classes;
+    std::vector<std::string> groups;
+    int pages = 0;
+    int glyphs = 0;
+    int texts = 0;
+    while (!reader.AtEnd()) {
+        const uint8_t op = reader.ReadByte();
+        switch (op) {
+            case DL_DEFINE_STRING: reader.m_strings.push_back(reader.ReadString()); break;
+            case DL_DEFINE_GLYPH: {
+                reader.ReadUInt();
+                VRV_CHECK(!reader.ReadStringRef().empty());
+                VRV_CHECK(reader.ReadUInt() > 0);
+                VRV_CHECK(!reader.ReadStringRef().empty());
+                ++reader.m_glyphCount;
+                break;
+            }
+            case DL_START_PAGE: {
+                VRV_CHECK(groups.empty());
+                VRV_CHECK(reader.ReadUInt() > 0);
+                VRV_CHECK(reader.ReadUInt() > 0);
+                for (int i = 0; i < 2; ++i) reader.ReadUInt();
+                for (int i = 0; i < 2; ++i) reader.ReadInt();
+                ++pages;
+                break;
+            }
+            case DL_END_PAGE: VRV_CHECK(groups.empty()); break;
+            case DL_START_GROUP: {
+                const std::string gClass = reader.ReadStringRef();
+                const std::string id = reader.ReadStringRef();
+                reader.ReadStringRef();
+                if (!id.empty()) ids.insert(id);
+                classes.insert(gClass.substr(0, gClass.find(' ')));
+                groups.push_back(id);
+                break;
+            }
+            case DL_RESUME_GROUP: {
+                const std::string id = reader.ReadStringRef();
+                VRV_CHECK(ids.count(id) == 1);
+                groups.push_back(id);
+                break;
+            }
+            case DL_END_GROUP: {
+                VRV_CHECK(!groups.empty());
+                groups.pop_back();
+                break;
+            }
+            case DL_GROUP_COLOR: reader.ReadStringRef(); break;
+            case DL_ROTATE:
+                for (int i = 0; i < 3; ++i) reader.ReadInt();
+                break;
+            case DL_SET_PEN: {
+                reader.ReadUInt();
+                reader.ReadUInt();
+                reader.ReadByte();
+                for (int i = 0; i < 4; ++i) reader.ReadUInt();
+                break;
+            }
+            case DL_SET_BRUSH: {
+                reader.ReadUInt();
+                reader.ReadByte();
+                break;
+            }
+            case DL_PATH: {
+                VRV_CHECK(reader.ReadByte() <= (DL_PATH_FILL | DL_PATH_STROKE | DL_PATH_CLOSE));
+                const uint32_t segments = reader.ReadUInt();
+                reader.ReadPoints(1);
+                for (uint32_t i = 0; i < segments; ++i) {
+                    switch (reader.ReadByte()) {
+                        case DL_PATH_LINE_TO: reader.ReadPoints(1); break;
+                        case DL_PATH_QUAD_TO: reader.ReadPoints(2); break;
+                        case DL_PATH_CUBIC_TO: reader.ReadPoints(3); break;
+                        default: VRV_CHECK(false);
+                    }
+                }
+                break;
+            }
+            case DL_ELLIPSE:
+                for (int i = 0; i < 4; ++i) reader.ReadInt();
+                break;
+            case DL_RECTANGLE:
+                for (int i = 0; i < 5; ++i) reader.ReadInt();
+                break;
+            case DL_POLYLINE:
+            case DL_POLYGON: reader.ReadPoints(reader.ReadUInt()); break;
+            case DL_GLYPH: {
+                const uint32_t ref = reader.ReadUInt();
+                VRV_CHECK((ref > 0) && ((int)ref <= reader.m_glyphCount));
+                for (int i = 0; i < 2; ++i) reader.ReadInt();
+                for (int i = 0; i < 2; ++i) reader.ReadUInt();
+                ++glyphs;
+                break;
+            }
+            case DL_START_TEXT:
+            case DL_MOVE_TEXT: {
+                for (int i = 0; i < 2; ++i) reader.ReadInt();
+                reader.ReadUInt();
+                break;
+            }
+            case DL_TEXT: {
+                VRV_CHECK(!reader.ReadStringRef().empty());
+                reader.ReadStringRef();
+                for (int i = 0; i < 3; ++i) reader.ReadUInt();
+                for (int i = 0; i < 3; ++i) reader.ReadInt();
+                ++texts;
+                break;
+            }
+            case DL_END_TEXT: break;
+            case DL_IMAGE: {
+                for (int i = 0; i < 4; ++i) reader.ReadInt();
+                reader.ReadStringRef();
+                break;
+            }
+            case DL_SVG_SHAPE: {
+                for (int i = 0; i < 4; ++i) reader.ReadInt();
+                reader.ReadUInt();
+                reader.ReadStringRef();
+                break;
+            }
+            default: VRV_CHECK(false);
+        }
+    }
+    VRV_CHECK_EQUAL(pages, 1);
+    VRV_CHECK(groups.empty());
+    VRV_CHECK(glyphs > 0);
+    VRV_CHECK(texts > 0);
+
+    // The groups are the ones of the SVG, with the text spans and without the page margin and the SVG graphics content
+    toolkit.SetOptions("{\"xmlIdSeed\": 1}");
+    VRV_CHECK(toolkit.LoadData(mei));
+    pugi::xml_document svg;
+    VRV_CHECK(svg.load_string(toolkit.RenderToSVG(1).c_str()));
+    std::set<std::string> svgIds;
+    std::set<std::string> svgClasses;
+    for (const pugi::xpath_node &g :
+        svg.select_nodes("//g[not(@class='page-margin')][not(ancestor::g[@class='svg'])] | //tspan[@class]")) {
+        if (g.node().attribute("id")) svgIds.insert(g.node().attribute("id").value());
+        const std::string gClass = g.node().attribute("class").value();
+        svgClasses.insert(gClass.substr(0, gClass.find(' ')));
+    }
+    VRV_CHECK(ids == svgIds);
+    VRV_CHECK(classes == svgClasses);
+    for (const char *id : { "m1", "n1", "n2", "n3", "r1", "s1", "d1" }) VRV_CHECK_EQUAL((int)ids.count(id), 1);
+}
+
+} // namespace vrv
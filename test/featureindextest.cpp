@@ -0,0 +1,153 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        featureindextest.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test.h"
+
+//----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+#include "toolkit.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace {
+
+    const char *incipits[] = {
+        "@clef:G-2\n@data:'4CDEFG\n", // intervals 2 2 1 2
+        "@clef:G-2\n@data:'4GFEDC\n", // intervals -2 -1 -2 -2
+        "@clef:G-2\n@data:'4CDECDEF\n", // intervals 2 2 -4 2 2 1
+    };
+
+    // Index the incipits and return the note IDs of each one
+    std::vector<std::vector<std::string>> IndexIncipits(Toolkit &toolkit, int ngramSize)
+    {
+        std::vector<std::vector<std::string>> noteIds;
+        toolkit.SetOptions("{\"inputFrom\": \"pae\"}");
+        toolkit.ResetFeatureIndex(StringFormat("{\"ngramSize\": %d}", ngramSize));
+        for (int i = 0; i < 3; ++i) {
+            VRV_CHECK(toolkit.LoadData(incipits[i]));
+            VRV_CHECK(toolkit.AddToFeatureIndex(StringFormat("incipit-%d", i)));
+            jsonxx::Object features;
+            VRV_CHECK(features.parse(toolkit.GetDescriptiveFeatures("{}")));
+            const jsonxx::Array &pitchesIds = features.get<jsonxx::Array>("pitchesIds");
+            noteIds.push_back({});
+            for (size_t j = 0; j < pitchesIds.size(); ++j) {
+                noteIds.back().push_back(pitchesIds.get<jsonxx::Array>((unsigned)j).get<jsonxx::String>(0));
+            }
+        }
+        return noteIds;
+    }
+
+    jsonxx::Object Search(Toolkit &toolkit, const std::string &query)
+    {
+        jsonxx::Object results;
+        VRV_CHECK(results.parse(toolkit.SearchFeatureIndex(query)));
+        return results;
+    }
+
+    // Return the note IDs of a match of a document in the results
+    const jsonxx::Array &GetMatch(const jsonxx::Object &results, int document, int match)
+    {
+        return results.get<jsonxx::Array>("documents")
+            .get<jsonxx::Object>(document)
+            .get<jsonxx::Array>("matches")
+            .get<jsonxx::Array>(match);
+    }
+
+} // namespace
+
+//----------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------
+
+VRV_TEST(featureindex, Search)
+{
+    // With n-grams longer and shorter than the queries
+    for (int ngramSize : { 2, 4 }) {
+        Toolkit toolkit(false);
+        test::InitToolkit(toolkit);
+        const std::vector<std::vector<std::string>> noteIds = IndexIncipits(toolkit, ngramSize);
+
+        jsonxx::Object results = Search(toolkit, "{\"feature\": \"intervalsChromatic\", \"query\": \"2 2 1\"}");
+        VRV_CHECK_EQUAL(results.get<jsonxx::Number>("matchCount"), 2);
+        VRV_CHECK_EQUAL(results.get<jsonxx::Array>("documents").size(), 2);
+        const jsonxx::Object &first = results.get<jsonxx::Array>("documents").get<jsonxx::Object>(0);
+        VRV_CHECK_EQUAL(first.get<jsonxx::String>("id"), std::string("incipit-0"));
+        // An interval match spans one note more than the query
+        const jsonxx::Array &match = GetMatch(results, 0, 0);
+        VRV_CHECK_EQUAL(match.size(), 4);
+        for (int i = 0; i < 4; ++i) VRV_CHECK_EQUAL(match.get<jsonxx::String>(i), noteIds.at(0).at(i));
+        VRV_CHECK_EQUAL(GetMatch(results, 1, 0).get<jsonxx::String>(0), noteIds.at(2).at(3));
+
+        results = Search(toolkit, "{\"feature\": \"intervalsChromatic\", \"query\": [2, 2, -4, 2]}");
+        VRV_CHECK_EQUAL(results.get<jsonxx::Number>("matchCount"), 1);
+        VRV_CHECK_EQUAL(GetMatch(results, 0, 0).size(), 5);
+
+        results = Search(toolkit, "{\"feature\": \"pitchesDiatonic\", \"query\": [\"C\", \"D\", \"E\"]}");
+        VRV_CHECK_EQUAL(results.get<jsonxx::Number>("matchCount"), 3);
+        VRV_CHECK_EQUAL(GetMatch(results, 1, 1).size(), 3);
+        VRV_CHECK_EQUAL(GetMatch(results, 1, 1).get<jsonxx::String>(0), noteIds.at(2).at(3));
+
+        results = Search(toolkit, "{\"feature\": \"pitchesDiatonic\", \"query\": \"C D E\", \"maxResults\": 1}");
+        VRV_CHECK_EQUAL(results.get<jsonxx::Number>("matchCount"), 1);
+
+        // Overlapping matches are all returned
+        results = Search(toolkit, "{\"feature\": \"intervalGrossContour\", \"query\": \"D D D\"}");
+        VRV_CHECK_EQUAL(results.get<jsonxx::Number>("matchCount"), 2);
+        VRV_CHECK_EQUAL(GetMatch(results, 0, 1).get<jsonxx::String>(0), noteIds.at(1).at(1));
+
+        // Values missing from the index
+        results = Search(toolkit, "{\"feature\": \"intervalsChromatic\", \"query\": \"2 7\"}");
+        VRV_CHECK_EQUAL(results.get<jsonxx::Number>("matchCount"), 0);
+    }
+}
+
+VRV_TEST(featureindex, SaveAndLoad)
+{
+    Toolkit toolkit(false);
+    test::InitToolkit(toolkit);
+    IndexIncipits(toolkit, 3);
+
+    const std::string filename = "featureindextest.idx";
+    VRV_CHECK(toolkit.SaveFeatureIndexFile(filename));
+
+    const std::vector<std::string> queries = { "{\"feature\": \"intervalsChromatic\", \"query\": \"2 2 1\"}",
+        "{\"feature\": \"intervalsDiatonic\", \"query\": \"1 1 -2 1\"}",
+        "{\"feature\": \"pitchesChromaticWithDuration\", \"query\": \"4'C 4'D\"}" };
+    std::vector<std::string> expected;
+    for (const std::string &query : queries) expected.push_back(toolkit.SearchFeatureIndex(query));
+
+    Toolkit other(false);
+    VRV_CHECK(other.LoadFeatureIndexFile(filename));
+    for (int i = 0; i < (int)queries.size(); ++i) {
+        VRV_CHECK_EQUAL(other.SearchFeatureIndex(queries.at(i)), expected.at(i));
+    }
+
+    // A truncated file is rejected
+    std::string content;
+    {
+        std::ifstream input(filename, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream output(filename, std::ios::binary);
+        output << content.substr(0, content.size() / 2);
+    }
+    VRV_CHECK(!other.LoadFeatureIndexFile(filename));
+    std::remove(filename.c_str());
+}
+
+} // namespace vrv
@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        incipitstest.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+#include "pugixml.hpp"
+#include "toolkit.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace {
+
+    // The incipits as a JSON array, with an object with keys and an invalid entry
+    const char *incipits = "["
+                           "\"@clef:G-2\\n@data:'4CDEFG\\n\","
+                           "\"@clef:F-4\\n@keysig:bB\\n@data:,8GAB'C4D\\n\","
+                           "{\"clef\": \"C-1\", \"timesig\": \"3/4\", \"data\": \"'2C4D/2.E\"},"
+                           "12,"
+                           "\"@clef:G-2\\n@data:''4C8DE{6FGAB}\\n\""
+                           "]";
+
+    const int incipitCount = 5;
+
+    // Render the incipits one by one, seeding the IDs before each one
+    std::vector<std::string> RenderOneByOne(uint32_t seed, bool spriteSheet, const std::string &options)
+    {
+        Toolkit toolkit(false);
+        test::InitToolkit(toolkit);
+        toolkit.SetOptions("{\"breaks\": \"none\", \"adjustPageHeight\": true, \"header\": \"none\", \"footer\": "
+                           "\"none\"}");
+        toolkit.SetOptions(options);
+        jsonxx::Array array;
+        VRV_CHECK(array.parse(incipits));
+        std::vector<std::string> svgs;
+        for (int i = 0; i < incipitCount; ++i) {
+            Object::SeedID((spriteSheet) ? seed + i : seed);
+            if (array.has<jsonxx::String>(i)) {
+                VRV_CHECK(toolkit.LoadData(array.get<jsonxx::String>(i)));
+                svgs.push_back(toolkit.RenderToSVG(1));
+            }
+            else if (array.has<jsonxx::Object>(i)) {
+                VRV_CHECK(toolkit.LoadData(array.get<jsonxx::Object>(i).json()));
+                svgs.push_back(toolkit.RenderToSVG(1));
+            }
+            else {
+                svgs.push_back("");
+            }
+        }
+        return svgs;
+    }
+
+} // namespace
+
+//----------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------
+
+VRV_TEST(incipits, Array)
+{
+    const std::vector<std::string> expected = RenderOneByOne(7, false, "{\"svgViewBox\": true}");
+
+    Toolkit toolkit(false);
+    test::InitToolkit(toolkit);
+    toolkit.SetOptions("{\"xmlIdSeed\": 7}");
+    EnableLogToBuffer(true);
+    EnableLog(LOG_WARNING);
+    for (int threads : { 1, 3 }) {
+        jsonxx::Array svgs;
+        VRV_CHECK(svgs.parse(toolkit.RenderIncipitsToSVG(
+            incipits, StringFormat("{\"threads\": %d, \"options\": {\"svgViewBox\": true}}", threads))));
+        VRV_CHECK_EQUAL((int)svgs.size(), incipitCount);
+        for (int i = 0; i < incipitCount; ++i) {
+            VRV_CHECK_EQUAL(svgs.get<jsonxx::String>(i), expected.at(i));
+        }
+    }
+    VRV_CHECK(toolkit.GetLog().find("Incipit 3 could not be loaded") != std::string::npos);
+    EnableLog(LOG_OFF);
+    EnableLogToBuffer(false);
+
+    // The options of the toolkit are not changed
+    jsonxx::Object options;
+    VRV_CHECK(options.parse(toolkit.GetOptions()));
+    VRV_CHECK_EQUAL(options.get<jsonxx::String>("breaks"), std::string("auto"));
+    VRV_CHECK(!options.get<jsonxx::Boolean>("svgViewBox"));
+
+    VRV_CHECK_EQUAL(toolkit.RenderIncipitsToSVG("{}"), std::string("[]"));
+}
+
+VRV_TEST(incipits, SpriteSheet)
+{
+    const std::vector<std::string> expected = RenderOneByOne(7, true, "{}");
+
+    Toolkit toolkit(false);
+    test::InitToolkit(toolkit);
+    toolkit.SetOptions("{\"xmlIdSeed\": 7}");
+    const std::string sheet = toolkit.RenderIncipitsToSVG(incipits, "{\"threads\": 2, \"spriteSheet\": true}");
+
+    pugi::xml_document doc;
+    VRV_CHECK(doc.load_string(sheet.c_str()));
+    pugi::xml_node root = doc.child("svg");
+    VRV_CHECK(root);
+
+    // The symbols and the styles are shared
+    std::set<std::string> symbolIds;
+    std::set<std::string> symbolContents;
+    for (pugi::xml_node symbol : root.child("defs").children("symbol")) {
+        VRV_CHECK(symbolIds.insert(symbol.attribute("id").value()).second);
+        VRV_CHECK(symbolContents.insert(symbol.first_child().attribute("d").value()).second);
+    }
+    VRV_CHECK(!symbolIds.empty());
+    VRV_CHECK_EQUAL((int)std::distance(root.children("style").begin(), root.children("style").end()), 1);
+
+    // The incipits are stacked, with the content they have when rendered alone
+    int i = 0;
+    double width = 0.0;
+    double height = 0.0;
+    for (pugi::xml_node svg : root.children("svg")) {
+        VRV_CHECK_EQUAL(std::string(svg.attribute("id").value()), StringFormat("incipit-%d", i));
+        if (expected.at(i).empty()) {
+            VRV_CHECK(!svg.first_child());
+        }
+        else {
+            pugi::xml_document single;
+            VRV_CHECK(single.load_string(expected.at(i).c_str()));
+            VRV_CHECK_EQUAL(std::string(svg.attribute("width").value()),
+                std::string(single.child("svg").attribute("width").value()));
+            VRV_CHECK_EQUAL(std::string(svg.attribute("y").value()), StringFormat("%gpx", height));
+            width = std::max(width, svg.attribute("width").as_double());
+            height += svg.attribute("height").as_double();
+            const std::string content = single.child("svg").child("svg").attribute("viewBox").value();
+            VRV_CHECK_EQUAL(std::string(svg.child("svg").attribute("viewBox").value()), content);
+            for (const pugi::xpath_node &use : svg.select_nodes(".//use")) {
+                VRV_CHECK_EQUAL((int)symbolIds.count(use.node().attribute("xlink:href").value() + 1), 1);
+            }
+        }
+        ++i;
+    }
+    VRV_CHECK_EQUAL(i, incipitCount);
+    VRV_CHECK_EQUAL(std::string(root.attribute("width").value()), StringFormat("%gpx", width));
+    VRV_CHECK_EQUAL(std::string(root.attribute("height").value()), StringFormat("%gpx", height));
+}
+
+} // namespace vrv
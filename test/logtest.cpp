@@ -0,0 +1,88 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        logtest.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test.h"
+
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+#include "toolkit.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace {
+
+    // Log to the buffer for the lifetime of the object
+    class LogToBuffer {
+    public:
+        LogToBuffer()
+        {
+            EnableLogToBuffer(true);
+            EnableLog(LOG_WARNING);
+            logBuffer.Clear();
+        }
+        ~LogToBuffer()
+        {
+            logBuffer.Clear();
+            SetLogBufferMaxSize(10000);
+            EnableLog(LOG_OFF);
+            EnableLogToBuffer(false);
+        }
+    };
+
+} // namespace
+
+//----------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------
+
+VRV_TEST(log, DuplicatesAreCounted)
+{
+    LogToBuffer logToBuffer;
+    for (int i = 0; i < 3; ++i) LogWarning("Repeated message");
+    LogError("Other message");
+
+    VRV_CHECK_EQUAL((int)logBuffer.GetEntries().size(), 2);
+    VRV_CHECK_EQUAL(logBuffer.GetEntries().at(0).m_count, 3);
+    VRV_CHECK_EQUAL(logBuffer.GetEntries().at(1).m_count, 1);
+    VRV_CHECK(LogBufferContains("[Warning] Repeated message\n"));
+
+    Toolkit toolkit(false);
+    VRV_CHECK_EQUAL(toolkit.GetLog(), std::string("[Warning] Repeated message\n[Error] Other message\n"));
+    jsonxx::Array entries;
+    VRV_CHECK(entries.parse(toolkit.GetLogEntries()));
+    VRV_CHECK_EQUAL((int)entries.size(), 2);
+    VRV_CHECK_EQUAL(entries.get<jsonxx::Object>(0).get<jsonxx::String>("level"), std::string("warning"));
+    VRV_CHECK_EQUAL(entries.get<jsonxx::Object>(0).get<jsonxx::Number>("count"), 3);
+    VRV_CHECK_EQUAL(entries.get<jsonxx::Object>(0).get<jsonxx::String>("message"), std::string("Repeated message"));
+    VRV_CHECK_EQUAL(entries.get<jsonxx::Object>(1).get<jsonxx::String>("level"), std::string("error"));
+
+    logBuffer.Clear();
+    VRV_CHECK(toolkit.GetLog().empty());
+}
+
+VRV_TEST(log, BufferIsBounded)
+{
+    LogToBuffer logToBuffer;
+    SetLogBufferMaxSize(100);
+    // Many distinct messages, each logged twice - this is quadratic with a linear lookup
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 100000; ++i) LogWarning("Message %d", i);
+    }
+
+    VRV_CHECK_EQUAL((int)logBuffer.GetEntries().size(), 100);
+    VRV_CHECK_EQUAL(logBuffer.GetDroppedCount(), 2 * (100000 - 100));
+    VRV_CHECK_EQUAL(logBuffer.GetEntries().back().m_count, 2);
+
+    Toolkit toolkit(false);
+    VRV_CHECK(toolkit.GetLog().ends_with("[Warning] 199800 more messages were not logged because the log buffer is full\n"));
+}
+
+} // namespace vrv
@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        profiletest.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test.h"
+
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+#include "toolkit.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace {
+
+    // Return the record with the given name, or an empty object
+    jsonxx::Object FindRecord(const jsonxx::Array &records, const std::string &name)
+    {
+        for (size_t i = 0; i < records.size(); ++i) {
+            const jsonxx::Object &record = records.get<jsonxx::Object>((unsigned int)i);
+            if (record.get<jsonxx::String>("name") == name) return record;
+        }
+        return jsonxx::Object();
+    }
+
+} // namespace
+
+//----------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------
+
+VRV_TEST(profile, StagesAndFunctors)
+{
+    Toolkit toolkit(false);
+    test::InitToolkit(toolkit);
+    VRV_CHECK(toolkit.LoadData(test::ReadSourceFile("doc/importer.mei")));
+    toolkit.RenderToSVG(1);
+    toolkit.RenderToSVG(1);
+
+    jsonxx::Object profile;
+    VRV_CHECK(profile.parse(toolkit.GetProfile()));
+    VRV_CHECK(profile.has<jsonxx::Array>("stages"));
+    VRV_CHECK(profile.has<jsonxx::Array>("functors"));
+    const jsonxx::Array &stages = profile.get<jsonxx::Array>("stages");
+    const jsonxx::Array &functors = profile.get<jsonxx::Array>("functors");
+
+    for (const std::string name : { "loadData", "import", "prepareData", "castOff", "layOutHorizontally" }) {
+        VRV_CHECK(FindRecord(stages, name).has<jsonxx::Number>("time"));
+    }
+    VRV_CHECK_EQUAL(FindRecord(stages, "renderToSVG").get<jsonxx::Number>("calls"), 2);
+    VRV_CHECK(FindRecord(stages, "loadData").get<jsonxx::Number>("visits") > 0);
+
+    // Functors are sorted by time and their names have no namespace
+    VRV_CHECK(functors.size() > 10);
+    VRV_CHECK(FindRecord(functors, "CalcStemFunctor").get<jsonxx::Number>("visits") > 0);
+    for (size_t i = 1; i < functors.size(); ++i) {
+        VRV_CHECK(functors.get<jsonxx::Object>((unsigned int)i - 1).get<jsonxx::Number>("time")
+            >= functors.get<jsonxx::Object>((unsigned int)i).get<jsonxx::Number>("time"));
+    }
+
+    // Loading new data resets the profile
+    VRV_CHECK(toolkit.LoadData(test::ReadSourceFile("doc/importer.mei")));
+    VRV_CHECK(profile.parse(toolkit.GetProfile()));
+    VRV_CHECK_EQUAL(FindRecord(profile.get<jsonxx::Array>("stages"), "loadData").get<jsonxx::Number>("calls"), 1);
+    VRV_CHECK(!FindRecord(profile.get<jsonxx::Array>("stages"), "renderToSVG").has<jsonxx::Number>("calls"));
+}
+
+} // namespace vrv
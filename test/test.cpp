@@ -0,0 +1,131 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        test.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "toolkit.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace test {
+
+namespace {
+
+    struct TestCase {
+        std::string m_suite;
+        std::string m_name;
+        std::function<void()> m_function;
+    };
+
+    struct TestFailure {
+        std::string m_message;
+    };
+
+    std::vector<TestCase> &GetTestCases()
+    {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+} // namespace
+
+bool RegisterTest(const std::string &suite, const std::string &name, std::function<void()> function)
+{
+    GetTestCases().push_back({ suite, name, function });
+    return true;
+}
+
+void Fail(const char *file, int line, const std::string &message)
+{
+    throw TestFailure{ std::string(file) + ":" + std::to_string(line) + ": check failed: " + message };
+}
+
+std::string GetResourcePath()
+{
+    return std::string(VRV_TEST_SOURCE_DIR) + "/data";
+}
+
+std::string GetSourceFilePath(const std::string &path)
+{
+    return std::string(VRV_TEST_SOURCE_DIR) + "/" + path;
+}
+
+std::string ReadSourceFile(const std::string &path)
+{
+    std::ifstream file(GetSourceFilePath(path), std::ios::binary);
+    if (!file.is_open()) Fail(__FILE__, __LINE__, "cannot open " + path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+void InitToolkit(Toolkit &toolkit)
+{
+    if (!toolkit.SetResourcePath(GetResourcePath())) Fail(__FILE__, __LINE__, "cannot load the resources");
+}
+
+} // namespace test
+
+} // namespace vrv
+
+//----------------------------------------------------------------------------
+// main
+//----------------------------------------------------------------------------
+
+/**
+ * Run all the tests, or only the ones of the suites given as arguments.
+ * Return the number of failed tests.
+ */
+int main(int argc, char **argv)
+{
+    using namespace vrv::test;
+
+    std::vector<std::string> suites(argv + 1, argv + argc);
+
+    vrv::EnableLog(vrv::LOG_OFF);
+
+    int run = 0;
+    int failed = 0;
+    for (const TestCase &testCase : GetTestCases()) {
+        if (!suites.empty() && (std::find(suites.begin(), suites.end(), testCase.m_suite) == suites.end())) continue;
+        ++run;
+        const std::string testName = testCase.m_suite + "." + testCase.m_name;
+        try {
+            testCase.m_function();
+            std::cout << "[ OK ] " << testName << std::endl;
+        }
+        catch (const TestFailure &failure) {
+            ++failed;
+            std::cout << "[FAIL] " << testName << std::endl << "       " << failure.m_message << std::endl;
+        }
+        catch (const std::exception &exception) {
+            ++failed;
+            std::cout << "[FAIL] " << testName << std::endl
+                      << "       unexpected exception: " << exception.what() << std::endl;
+        }
+    }
+
+    std::cout << run - failed << "/" << run << " tests passed" << std::endl;
+    if (run == 0) {
+        std::cerr << "No test found" << std::endl;
+        return 1;
+    }
+    return failed;
+}
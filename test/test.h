@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        test.h
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_TEST_H__
+#define __VRV_TEST_H__
+
+#include <functional>
+#include <sstream>
+#include <string>
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+class Toolkit;
+
+namespace test {
+
+//----------------------------------------------------------------------------
+// Test registration and checks
+//----------------------------------------------------------------------------
+
+/**
+ * Register a test function for a suite. Called by the VRV_TEST macro.
+ */
+bool RegisterTest(const std::string &suite, const std::string &name, std::function<void()> function);
+
+/**
+ * Make the current test fail. Called by the VRV_CHECK macros.
+ */
+[[noreturn]] void Fail(const char *file, int line, const std::string &message);
+
+/**
+ * Return the path of the resource directory (the data directory of the repository)
+ */
+std::string GetResourcePath();
+
+/**
+ * Return the path of a file of the repository, relative to its root
+ */
+std::string GetSourceFilePath(const std::string &path);
+
+/**
+ * Read the content of a file of the repository, relative to its root
+ */
+std::string ReadSourceFile(const std::string &path);
+
+/**
+ * Initialize a toolkit with the resource path of the repository
+ */
+void InitToolkit(Toolkit &toolkit);
+
+} // namespace test
+
+} // namespace vrv
+
+//----------------------------------------------------------------------------
+// Macros
+//----------------------------------------------------------------------------
+
+#define VRV_TEST(suite, name)                                                                                          \
+    static void suite##_##name();                                                                                      \
+    static const bool suite##_##name##_registered = vrv::test::RegisterTest(#suite, #name, suite##_##name);            \
+    static void suite##_##name()
+
+#define VRV_CHECK(condition)                                                                                           \
+    do {                                                                                                               \
+        if (!(condition)) vrv::test::Fail(__FILE__, __LINE__, #condition);                                             \
+    } while (0)
+
+#define VRV_CHECK_EQUAL(actual, expected)                                                                              \
+    do {                                                                                                               \
+        const auto &actualValue = (actual);                                                                            \
+        const auto &expectedValue = (expected);                                                                        \
+        if (!(actualValue == expectedValue)) {                                                                         \
+            std::ostringstream message;                                                                                \
+            message << #actual << " == " << #expected << " (" << actualValue << " != " << expectedValue << ")";        \
+            vrv::test::Fail(__FILE__, __LINE__, message.str());                                                        \
+        }                                                                                                              \
+    } while (0)
+
+#endif // __VRV_TEST_H__
@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        threadtest.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test.h"
+
+//----------------------------------------------------------------------------
+
+#include <clocale>
+#include <regex>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "toolkit.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace {
+
+    struct ThreadTestInput {
+        std::string m_data;
+        std::string m_options;
+    };
+
+    std::vector<ThreadTestInput> GetThreadTestInputs()
+    {
+        std::vector<ThreadTestInput> inputs;
+        inputs.push_back({ test::ReadSourceFile("doc/importer.mei"), "{}" });
+        inputs.push_back({ test::ReadSourceFile("doc/importer.mei"), "{\"pageWidth\": 1200, \"scale\": 60}" });
+        inputs.push_back({ "@clef:G-2\n@keysig:xFC\n@timesig:3/8\n@data:'6B8B{AGA}/4B8C''D'4.C6B8B{AGA}/4B''C'2CD\n",
+            "{\"inputFrom\": \"pae\"}" });
+        inputs.push_back({ "X:1\nT:Test\nM:6/8\nL:1/8\nK:D\nA|d2d fed|ABA F2A|d2d fed|efe e2A|\n", "{}" });
+        inputs.push_back({ "**kern\t**kern\n*M4/4\t*M4/4\n=1\t=1\n4c\t4e\n4d\t4f\n2e\t2g\n==\t==\n*-\t*-\n",
+            "{\"inputFrom\": \"humdrum\"}" });
+        return inputs;
+    }
+
+    // Render all the outputs of an input with its own toolkit
+    std::vector<std::string> RenderThreadTestInput(const ThreadTestInput &input)
+    {
+        Toolkit toolkit(false);
+        test::InitToolkit(toolkit);
+        toolkit.SetOptions(input.m_options);
+        // Seed the ids of the calling thread
+        toolkit.SetOptions("{\"xmlIdSeed\": 1}");
+        std::vector<std::string> outputs;
+        if (!toolkit.LoadData(input.m_data)) return outputs;
+        for (int i = 1; i <= toolkit.GetPageCount(); ++i) {
+            outputs.push_back(toolkit.RenderToSVG(i));
+        }
+        outputs.push_back(toolkit.RenderToMIDI());
+        outputs.push_back(toolkit.RenderToTimemap());
+        // The encoding date changes when rendering crosses a second boundary
+        static const std::regex isodate("isodate=\"[^\"]*\"");
+        outputs.push_back(std::regex_replace(toolkit.GetMEI(), isodate, "isodate=\"\""));
+        return outputs;
+    }
+
+} // namespace
+
+//----------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------
+
+VRV_TEST(threads, ConcurrentRendering)
+{
+    const std::vector<ThreadTestInput> inputs = GetThreadTestInputs();
+
+    std::vector<std::vector<std::string>> expected;
+    for (const ThreadTestInput &input : inputs) {
+        expected.push_back(RenderThreadTestInput(input));
+        VRV_CHECK(!expected.back().empty());
+    }
+
+    // Each input is rendered by several threads at the same time
+    const int threadsPerInput = 3;
+    std::vector<std::vector<std::string>> results(inputs.size() * threadsPerInput);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < (int)results.size(); ++i) {
+        threads.emplace_back([&inputs, &results, i]() { results.at(i) = RenderThreadTestInput(inputs.at(i % inputs.size())); });
+    }
+    for (std::thread &thread : threads) thread.join();
+
+    for (int i = 0; i < (int)results.size(); ++i) {
+        VRV_CHECK(results.at(i) == expected.at(i % inputs.size()));
+    }
+}
+
+VRV_TEST(threads, ThreadLocalLog)
+{
+    EnableLogToBuffer(true);
+    EnableLog(LOG_WARNING);
+
+    std::vector<std::string> logs(4);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < (int)logs.size(); ++i) {
+        threads.emplace_back([&logs, i]() {
+            Toolkit toolkit(false);
+            test::InitToolkit(toolkit);
+            LogWarning("Message from thread %d", i);
+            logs.at(i) = toolkit.GetLog();
+        });
+    }
+    for (std::thread &thread : threads) thread.join();
+
+    EnableLog(LOG_OFF);
+    EnableLogToBuffer(false);
+
+    for (int i = 0; i < (int)logs.size(); ++i) {
+        VRV_CHECK(logs.at(i).find(StringFormat("Message from thread %d", i)) != std::string::npos);
+        for (int j = 0; j < (int)logs.size(); ++j) {
+            if (j != i) VRV_CHECK(logs.at(i).find(StringFormat("Message from thread %d", j)) == std::string::npos);
+        }
+    }
+}
+
+VRV_TEST(threads, LocaleIndependentFormatting)
+{
+    // Use a locale with a decimal comma if one is installed
+    const std::string previousLocale = setlocale(LC_NUMERIC, NULL);
+    if (!setlocale(LC_NUMERIC, "de_DE.UTF-8")) setlocale(LC_NUMERIC, "fr_FR.UTF-8");
+
+    const std::string formatted = StringFormat("%.2f", 1.5);
+    const double parsed = StringToDouble("2.25");
+    setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    VRV_CHECK_EQUAL(formatted, std::string("1.50"));
+    VRV_CHECK_EQUAL(parsed, 2.25);
+}
+
+} // namespace vrv
@@ -0,0 +1,165 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        timemaptest.cpp
+// Author:      agent
+// Created:     19/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test.h"
+
+//----------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+#include "toolkit.h"
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+namespace {
+
+    uint32_t ReadUint32(const std::vector<uint8_t> &buffer, size_t &position)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) value |= (uint32_t)buffer.at(position++) << (8 * i);
+        return value;
+    }
+
+    double ReadDouble(const std::vector<uint8_t> &buffer, size_t &position)
+    {
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) bits |= (uint64_t)buffer.at(position++) << (8 * i);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // Return the IDs of an index array of the columnar timemap at a time index
+    std::vector<std::string> GetColumnarIds(const jsonxx::Object &timemap, const std::string &name, int time)
+    {
+        const jsonxx::Array &ids = timemap.get<jsonxx::Array>("ids");
+        const jsonxx::Array &indexes = timemap.get<jsonxx::Array>(name);
+        const jsonxx::Array &offsets = timemap.get<jsonxx::Array>(name + "Offsets");
+        std::vector<std::string> values;
+        for (int i = offsets.get<jsonxx::Number>(time); i < offsets.get<jsonxx::Number>(time + 1); ++i) {
+            values.push_back(ids.get<jsonxx::String>(indexes.get<jsonxx::Number>(i)));
+        }
+        return values;
+    }
+
+    std::vector<std::string> GetIds(const jsonxx::Object &entry, const std::string &name)
+    {
+        std::vector<std::string> values;
+        if (!entry.has<jsonxx::Array>(name)) return values;
+        const jsonxx::Array &ids = entry.get<jsonxx::Array>(name);
+        for (size_t i = 0; i < ids.size(); ++i) values.push_back(ids.get<jsonxx::String>((unsigned)i));
+        return values;
+    }
+
+} // namespace
+
+//----------------------------------------------------------------------------
+// Tests
+//----------------------------------------------------------------------------
+
+VRV_TEST(timemap, Columnar)
+{
+    Toolkit toolkit(false);
+    test::InitToolkit(toolkit);
+    VRV_CHECK(toolkit.LoadData(test::ReadSourceFile("doc/importer.mei")));
+
+    jsonxx::Array timemap;
+    VRV_CHECK(timemap.parse(toolkit.RenderToTimemap("{\"includeRests\": true, \"includeMeasures\": true}")));
+    jsonxx::Object columnar;
+    VRV_CHECK(columnar.parse(
+        toolkit.RenderToTimemap("{\"includeRests\": true, \"includeMeasures\": true, \"columnar\": true}")));
+
+    VRV_CHECK(timemap.size() > 0);
+    VRV_CHECK_EQUAL(columnar.get<jsonxx::Array>("tstamp").size(), timemap.size());
+    VRV_CHECK_EQUAL(columnar.get<jsonxx::Array>("onOffsets").size(), timemap.size() + 1);
+
+    // Every entry of the classic timemap is found in the columns
+    const jsonxx::Array &measureTimes = columnar.get<jsonxx::Array>("measureTimes");
+    size_t measure = 0;
+    for (int i = 0; i < (int)timemap.size(); ++i) {
+        const jsonxx::Object &entry = timemap.get<jsonxx::Object>(i);
+        // The classic timemap is written with a different number of digits
+        VRV_CHECK(std::abs(columnar.get<jsonxx::Array>("tstamp").get<jsonxx::Number>(i)
+                      - entry.get<jsonxx::Number>("tstamp"))
+            < 1e-9);
+        VRV_CHECK(std::abs(columnar.get<jsonxx::Array>("qstamp").get<jsonxx::Number>(i)
+                      - entry.get<jsonxx::Number>("qstamp"))
+            < 1e-9);
+        for (const std::string name : { "on", "off", "restsOn", "restsOff" }) {
+            VRV_CHECK(GetColumnarIds(columnar, name, i) == GetIds(entry, name));
+        }
+        if (entry.has<jsonxx::String>("measureOn")) {
+            VRV_CHECK_EQUAL(measureTimes.get<jsonxx::Number>(measure), i);
+            const int id = columnar.get<jsonxx::Array>("measureIds").get<jsonxx::Number>(measure);
+            VRV_CHECK_EQUAL(columnar.get<jsonxx::Array>("ids").get<jsonxx::String>(id),
+                entry.get<jsonxx::String>("measureOn"));
+            ++measure;
+        }
+    }
+    VRV_CHECK_EQUAL(measure, measureTimes.size());
+
+    // The rests are not included by default
+    VRV_CHECK(columnar.parse(toolkit.RenderToTimemap("{\"columnar\": true}")));
+    VRV_CHECK(!columnar.has<jsonxx::Array>("restsOn"));
+    VRV_CHECK(!columnar.has<jsonxx::Array>("measureTimes"));
+}
+
+VRV_TEST(timemap, Binary)
+{
+    Toolkit toolkit(false);
+    test::InitToolkit(toolkit);
+    VRV_CHECK(toolkit.LoadData(test::ReadSourceFile("doc/importer.mei")));
+
+    jsonxx::Object columnar;
+    VRV_CHECK(columnar.parse(toolkit.RenderToTimemap("{\"includeMeasures\": true, \"columnar\": true}")));
+    const std::vector<uint8_t> buffer = toolkit.RenderToTimemapBinary("{\"includeMeasures\": true}");
+
+    VRV_CHECK(buffer.size() > 12);
+    VRV_CHECK_EQUAL(std::string(buffer.begin(), buffer.begin() + 4), std::string("VTM1"));
+    size_t position = 4;
+    VRV_CHECK_EQUAL(ReadUint32(buffer, position), 2);
+    const jsonxx::Array &tstamps = columnar.get<jsonxx::Array>("tstamp");
+    const uint32_t timeCount = ReadUint32(buffer, position);
+    VRV_CHECK_EQUAL(timeCount, tstamps.size());
+    for (uint32_t i = 0; i < timeCount; ++i) {
+        VRV_CHECK_EQUAL(ReadDouble(buffer, position), tstamps.get<jsonxx::Number>(i));
+    }
+    position += timeCount * 8;
+    const jsonxx::Array &ids = columnar.get<jsonxx::Array>("ids");
+    const uint32_t idCount = ReadUint32(buffer, position);
+    VRV_CHECK_EQUAL(idCount, ids.size());
+    for (uint32_t i = 0; i < idCount; ++i) {
+        const uint32_t length = ReadUint32(buffer, position);
+        VRV_CHECK_EQUAL(std::string(buffer.begin() + position, buffer.begin() + position + length),
+            ids.get<jsonxx::String>(i));
+        position += length;
+    }
+    for (const std::string name : { "on", "off" }) {
+        const jsonxx::Array &offsets = columnar.get<jsonxx::Array>(name + "Offsets");
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            VRV_CHECK_EQUAL(ReadUint32(buffer, position), offsets.get<jsonxx::Number>((unsigned)i));
+        }
+        const jsonxx::Array &indexes = columnar.get<jsonxx::Array>(name);
+        for (size_t i = 0; i < indexes.size(); ++i) {
+            VRV_CHECK_EQUAL(ReadUint32(buffer, position), indexes.get<jsonxx::Number>((unsigned)i));
+        }
+    }
+    const uint32_t measureCount = ReadUint32(buffer, position);
+    VRV_CHECK_EQUAL(measureCount, columnar.get<jsonxx::Array>("measureTimes").size());
+    position += measureCount * 8;
+    const uint32_t tempoCount = ReadUint32(buffer, position);
+    VRV_CHECK_EQUAL(tempoCount, columnar.get<jsonxx::Array>("tempo").size());
+    VRV_CHECK_EQUAL(position + tempoCount * 12, buffer.size());
+}
+
+} // namespace vrv
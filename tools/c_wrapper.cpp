@@ -49,6 +49,30 @@ void vrvToolkit_destructor(void *tkPtr)
     delete tk;
 }
 
+bool vrvToolkit_addToFeatureIndex(void *tkPtr, const char *documentId)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->AddToFeatureIndex(documentId);
+}
+
+bool vrvToolkit_beginEditTransaction(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->BeginEditTransaction();
+}
+
+bool vrvToolkit_commitEditTransaction(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->CommitEditTransaction();
+}
+
+void vrvToolkit_continueLayout(void *tkPtr, int pageNo)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ContinueLayout(pageNo);
+}
+
 bool vrvToolkit_edit(void *tkPtr, const char *editorAction)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -101,6 +125,13 @@ const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getElementsAtPosition(void *tkPtr, const char *options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetElementsAtPosition(options));
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getExpansionIdsForElement(void *tkPtr, const char *xmlId)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -158,6 +189,20 @@ const char *vrvToolkit_getLog(void *tkPtr)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getLogEntries(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetLogEntries());
+    return tk->GetCString();
+}
+
+const char *vrvToolkit_getProfile(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetProfile());
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getMEI(void *tkPtr, const char *options)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -165,6 +210,14 @@ const char *vrvToolkit_getMEI(void *tkPtr, const char *options)
     return tk->GetCString();
 }
 
+const unsigned char *vrvToolkit_getMEIZipBinary(void *tkPtr, const char *options, int *length)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCBuffer(tk->GetMEIZipBinary(options));
+    if (length) *length = tk->GetCBufferSize();
+    return tk->GetCBuffer();
+}
+
 const char *vrvToolkit_getMIDIValuesForElement(void *tkPtr, const char *xmlId)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -238,12 +291,24 @@ const char *vrvToolkit_getVersion(void *tkPtr)
     return tk->GetCString();
 }
 
+bool vrvToolkit_isPageCountFinal(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->IsPageCountFinal();
+}
+
 bool vrvToolkit_loadData(void *tkPtr, const char *data)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
     return tk->LoadData(data);
 }
 
+bool vrvToolkit_loadFeatureIndexFile(void *tkPtr, const char *filename)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->LoadFeatureIndexFile(filename);
+}
+
 bool vrvToolkit_loadFile(void *tkPtr, const char *filename)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -281,6 +346,21 @@ const char *vrvToolkit_renderData(void *tkPtr, const char *data, const char *opt
     return tk->GetCString();
 }
 
+const char *vrvToolkit_renderIncipitsToSVG(void *tkPtr, const char *incipits, const char *options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->RenderIncipitsToSVG(incipits, options));
+    return tk->GetCString();
+}
+
+const unsigned char *vrvToolkit_renderToDisplayList(void *tkPtr, int pageNo, int *length)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCBuffer(tk->RenderToDisplayList(pageNo));
+    if (length) *length = tk->GetCBufferSize();
+    return tk->GetCBuffer();
+}
+
 const char *vrvToolkit_renderToExpansionMap(void *tkPtr)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -301,6 +381,14 @@ const char *vrvToolkit_renderToMIDI(void *tkPtr)
     return tk->GetCString();
 }
 
+const unsigned char *vrvToolkit_renderToMIDIBinary(void *tkPtr, int *length)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCBuffer(tk->RenderToMIDIBinary());
+    if (length) *length = tk->GetCBufferSize();
+    return tk->GetCBuffer();
+}
+
 bool vrvToolkit_renderToMIDIFile(void *tkPtr, const char *filename)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -320,6 +408,20 @@ bool vrvToolkit_renderToPAEFile(void *tkPtr, const char *filename)
     return tk->RenderToPAEFile(filename);
 }
 
+const unsigned char *vrvToolkit_renderToPNG(void *tkPtr, int pageNo, int *length)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCBuffer(tk->RenderToPNG(pageNo));
+    if (length) *length = tk->GetCBufferSize();
+    return tk->GetCBuffer();
+}
+
+bool vrvToolkit_renderToPNGFile(void *tkPtr, const char *filename, int pageNo)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->RenderToPNGFile(filename, pageNo);
+}
+
 const char *vrvToolkit_renderToSVG(void *tkPtr, int page_no, bool xmlDeclaration)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -340,12 +442,26 @@ const char *vrvToolkit_renderToTimemap(void *tkPtr, const char *c_options)
     return tk->GetCString();
 }
 
+const unsigned char *vrvToolkit_renderToTimemapBinary(void *tkPtr, const char *c_options, int *length)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCBuffer(tk->RenderToTimemapBinary(c_options));
+    if (length) *length = tk->GetCBufferSize();
+    return tk->GetCBuffer();
+}
+
 bool vrvToolkit_renderToTimemapFile(void *tkPtr, const char *filename, const char *c_options)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
     return tk->RenderToTimemapFile(filename, c_options);
 }
 
+void vrvToolkit_resetFeatureIndex(void *tkPtr, const char *options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->ResetFeatureIndex(options);
+}
+
 void vrvToolkit_resetOptions(void *tkPtr)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -358,12 +474,31 @@ void vrvToolkit_resetXmlIdSeed(void *tkPtr, int seed)
     tk->ResetXmlIdSeed(seed);
 }
 
+bool vrvToolkit_rollbackEditTransaction(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->RollbackEditTransaction();
+}
+
+bool vrvToolkit_saveFeatureIndexFile(void *tkPtr, const char *filename)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->SaveFeatureIndexFile(filename);
+}
+
 bool vrvToolkit_saveFile(void *tkPtr, const char *filename, const char *c_options)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
     return tk->SaveFile(filename, c_options);
 }
 
+const char *vrvToolkit_searchFeatureIndex(void *tkPtr, const char *query)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->SearchFeatureIndex(query));
+    return tk->GetCString();
+}
+
 bool vrvToolkit_select(void *tkPtr, const char *selection)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
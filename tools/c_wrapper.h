@@ -20,6 +20,10 @@ void *vrvToolkit_constructor();
 void *vrvToolkit_constructorResourcePath(const char *resourcePath);
 
 void vrvToolkit_destructor(void *tkPtr);
+bool vrvToolkit_addToFeatureIndex(void *tkPtr, const char *documentId);
+bool vrvToolkit_beginEditTransaction(void *tkPtr);
+bool vrvToolkit_commitEditTransaction(void *tkPtr);
+void vrvToolkit_continueLayout(void *tkPtr, int pageNo);
 bool vrvToolkit_edit(void *tkPtr, const char *editorAction);
 const char *vrvToolkit_editInfo(void *tkPtr);
 const char *vrvToolkit_getAvailableOptions(void *tkPtr);
@@ -27,6 +31,7 @@ const char *vrvToolkit_getDefaultOptions(void *tkPtr);
 const char *vrvToolkit_getDescriptiveFeatures(void *tkPtr, const char *options);
 const char *vrvToolkit_getElementAttr(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec);
+const char *vrvToolkit_getElementsAtPosition(void *tkPtr, const char *options);
 const char *vrvToolkit_getExpansionIdsForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getHumdrum(void *tkPtr);
 bool vrvToolkit_getHumdrumFile(void *tkPtr, const char *filename);
@@ -35,7 +40,10 @@ const char *vrvToolkit_convertHumdrumToHumdrum(void *tkPtr, const char *humdrumD
 const char *vrvToolkit_convertHumdrumToMIDI(void *tkPtr, const char *humdrumData);
 const char *vrvToolkit_convertMEIToHumdrum(void *tkPtr, const char *meiData);
 const char *vrvToolkit_getLog(void *tkPtr);
+const char *vrvToolkit_getLogEntries(void *tkPtr);
+const char *vrvToolkit_getProfile(void *tkPtr);
 const char *vrvToolkit_getMEI(void *tkPtr, const char *options);
+const unsigned char *vrvToolkit_getMEIZipBinary(void *tkPtr, const char *options, int *length);
 const char *vrvToolkit_getMIDIValuesForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getNotatedIdForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getOptions(void *tkPtr);
@@ -47,26 +55,38 @@ int vrvToolkit_getScale(void *tkPtr);
 double vrvToolkit_getTimeForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getTimesForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getVersion(void *tkPtr);
+bool vrvToolkit_isPageCountFinal(void *tkPtr);
 bool vrvToolkit_loadData(void *tkPtr, const char *data);
+bool vrvToolkit_loadFeatureIndexFile(void *tkPtr, const char *filename);
 bool vrvToolkit_loadFile(void *tkPtr, const char *filename);
 bool vrvToolkit_loadZipDataBase64(void *tkPtr, const char *data);
 bool vrvToolkit_loadZipDataBuffer(void *tkPtr, const unsigned char *data, int length);
 void vrvToolkit_redoLayout(void *tkPtr, const char *c_options);
 void vrvToolkit_redoPagePitchPosLayout(void *tkPtr);
 const char *vrvToolkit_renderData(void *tkPtr, const char *data, const char *options);
+const char *vrvToolkit_renderIncipitsToSVG(void *tkPtr, const char *incipits, const char *options);
+const unsigned char *vrvToolkit_renderToDisplayList(void *tkPtr, int pageNo, int *length);
 const char *vrvToolkit_renderToExpansionMap(void *tkPtr);
 bool vrvToolkit_renderToExpansionMapFile(void *tkPtr, const char *filename);
 const char *vrvToolkit_renderToMIDI(void *tkPtr);
+const unsigned char *vrvToolkit_renderToMIDIBinary(void *tkPtr, int *length);
 bool vrvToolkit_renderToMIDIFile(void *tkPtr, const char *filename);
 const char *vrvToolkit_renderToPAE(void *tkPtr);
 bool vrvToolkit_renderToPAEFile(void *tkPtr, const char *filename);
+const unsigned char *vrvToolkit_renderToPNG(void *tkPtr, int pageNo, int *length);
+bool vrvToolkit_renderToPNGFile(void *tkPtr, const char *filename, int pageNo);
 const char *vrvToolkit_renderToSVG(void *tkPtr, int page_no, bool xmlDeclaration);
 bool vrvToolkit_renderToSVGFile(void *tkPtr, const char *filename, int pageNo);
 const char *vrvToolkit_renderToTimemap(void *tkPtr, const char *c_options);
+const unsigned char *vrvToolkit_renderToTimemapBinary(void *tkPtr, const char *c_options, int *length);
 bool vrvToolkit_renderToTimemapFile(void *tkPtr, const char *filename, const char *c_options);
+void vrvToolkit_resetFeatureIndex(void *tkPtr, const char *options);
 void vrvToolkit_resetOptions(void *tkPtr);
 void vrvToolkit_resetXmlIdSeed(void *tkPtr, int seed);
+bool vrvToolkit_rollbackEditTransaction(void *tkPtr);
+bool vrvToolkit_saveFeatureIndexFile(void *tkPtr, const char *filename);
 bool vrvToolkit_saveFile(void *tkPtr, const char *filename, const char *c_options);
+const char *vrvToolkit_searchFeatureIndex(void *tkPtr, const char *query);
 bool vrvToolkit_select(void *tkPtr, const char *selection);
 bool vrvToolkit_setInputFrom(void *tkPtr, const char *inputFrom);
 bool vrvToolkit_setOptions(void *tkPtr, const char *options);
@@ -5,16 +5,23 @@
 // Copyright (c) Authors and others. All rights reserved.
 /////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <regex>
 #include <sstream>
 #include <string>
 #include <sys/stat.h>
+#include <thread>
 
 #ifndef _WIN32
 #include <getopt.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 #else
 #include "win_getopt.h"
 #endif
@@ -78,17 +85,499 @@ option optionStruct(vrv::Option *option, const std::map<vrv::Option *, std::stri
         option->GetShortOption() };
 }
 
+//----------------------------------------------------------------------------
+// Server mode
+//----------------------------------------------------------------------------
+
+// The options of the toolkit when the server starts, restored after each request
+struct ServerBaseOptions {
+    jsonxx::Object options;
+    std::string inputFrom;
+    int scale;
+};
+
+// Return the JSON object on a single line (strings are escaped so only the layout whitespace is removed)
+std::string jsonLine(const jsonxx::Object &object)
+{
+    std::string json = object.json();
+    json.erase(std::remove_if(json.begin(), json.end(), [](char c) { return (c == '\n') || (c == '\t'); }), json.end());
+    return json;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Process a request given as a JSON object on a single line and return the response on a single line
+std::string processServerRequest(vrv::Toolkit &toolkit, const ServerBaseOptions &base, const std::string &line)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    jsonxx::Object request;
+    jsonxx::Object response;
+    jsonxx::Object outputs;
+    jsonxx::Object timing;
+    std::string log;
+
+    if (!request.parse(line)) {
+        response << "success" << false;
+        response << "error"
+                 << "The request could not be parsed";
+        return jsonLine(response);
+    }
+
+    if (request.has<jsonxx::Value>("id")) response.import("id", request.get<jsonxx::Value>("id"));
+
+    // Requested outputs (SVG by default)
+    std::vector<std::string> formats;
+    if (request.has<jsonxx::Array>("outputs")) {
+        const jsonxx::Array &values = request.get<jsonxx::Array>("outputs");
+        for (int i = 0; i < (int)values.size(); ++i) {
+            if (values.has<jsonxx::String>(i)) formats.push_back(values.get<jsonxx::String>(i));
+        }
+    }
+    else {
+        formats.push_back("svg");
+    }
+
+    // Request options, with the layout skipped (as on the command-line) if only MIDI or maps are requested
+    jsonxx::Object requestOptions;
+    if (request.has<jsonxx::Object>("options")) requestOptions = request.get<jsonxx::Object>("options");
+    const bool layoutRequired = std::any_of(formats.begin(), formats.end(),
+        [](const std::string &format) { return (format != "midi") && (format != "timemap") && (format != "expansionmap"); });
+    if (!layoutRequired && !requestOptions.has<jsonxx::Value>("breaks")) requestOptions << "breaks" << "none";
+    if (!requestOptions.kv_map().empty()) {
+        toolkit.SetOptions(requestOptions.json());
+        log += toolkit.GetLog();
+    }
+
+    // Load the data or the file
+    bool success = false;
+    auto stepStart = std::chrono::steady_clock::now();
+    if (request.has<jsonxx::String>("data")) {
+        success = toolkit.LoadData(request.get<jsonxx::String>("data"));
+    }
+    else if (request.has<jsonxx::String>("path")) {
+        success = toolkit.LoadFile(request.get<jsonxx::String>("path"));
+    }
+    else {
+        response << "error"
+                 << "The request has no 'data' or 'path'";
+    }
+    timing << "load" << elapsedMs(stepStart);
+    log += toolkit.GetLog();
+
+    if (success) {
+        // Page to render (all pages with 0)
+        int page = 0;
+        if (request.has<jsonxx::Number>("page")) page = std::max((int)request.get<jsonxx::Number>("page"), 0);
+        // With a progressive layout, only lay out the pages needed
+        toolkit.ContinueLayout(page);
+        const int pageCount = toolkit.GetPageCount();
+        int from = 1;
+        int to = pageCount;
+        if (page > 0) {
+            from = to = std::min(page, pageCount);
+        }
+        response << "pageCount" << pageCount;
+        response << "pageCountFinal" << toolkit.IsPageCountFinal();
+
+        for (const std::string &format : formats) {
+            stepStart = std::chrono::steady_clock::now();
+            if (format == "svg" || format == "png") {
+                jsonxx::Array pages;
+                for (int p = from; p <= to; ++p) {
+                    if (format == "svg") {
+                        pages << toolkit.RenderToSVG(p);
+                    }
+                    else {
+                        const std::vector<uint8_t> png = toolkit.RenderToPNG(p);
+                        pages << vrv::Base64Encode(png.data(), (unsigned int)png.size());
+                    }
+                    log += toolkit.GetLog();
+                }
+                outputs << format << pages;
+            }
+            else if (format == "mei") {
+                outputs << format << toolkit.GetMEI();
+            }
+            else if (format == "midi") {
+                outputs << format << toolkit.RenderToMIDI();
+            }
+            else if (format == "timemap") {
+                outputs << format << toolkit.RenderToTimemap();
+            }
+            else if (format == "expansionmap") {
+                outputs << format << toolkit.RenderToExpansionMap();
+            }
+            else if (format == "pae") {
+                outputs << format << toolkit.RenderToPAE();
+            }
+            else if (format == "humdrum") {
+                outputs << format << toolkit.GetHumdrum();
+            }
+            else {
+                log += vrv::StringFormat("[Warning] Output format '%s' is not supported in server mode\n", format.c_str());
+                continue;
+            }
+            timing << format << elapsedMs(stepStart);
+            log += toolkit.GetLog();
+        }
+    }
+    else if (!response.has<jsonxx::String>("error")) {
+        response << "error"
+                 << "The input could not be loaded";
+    }
+
+    // Restore the options changed by the request
+    if (!requestOptions.kv_map().empty()) {
+        jsonxx::Object resetOptions;
+        for (const auto &[key, value] : requestOptions.kv_map()) {
+            if (base.options.has<jsonxx::Value>(key)) {
+                resetOptions.import(key, base.options.get<jsonxx::Value>(key));
+            }
+            else if (key == "inputFrom") {
+                resetOptions << key << base.inputFrom;
+            }
+            else if (key == "scale") {
+                resetOptions << key << base.scale;
+            }
+        }
+        toolkit.SetOptions(resetOptions.json());
+    }
+
+    timing << "total" << elapsedMs(start);
+
+    response << "success" << success;
+    response << "outputs" << outputs;
+    response << "timing" << timing;
+    if (!log.empty()) response << "log" << log;
+
+    return jsonLine(response);
+}
+
+// Process the requests line by line until the end of the input
+void runServer(vrv::Toolkit &toolkit, const ServerBaseOptions &base, std::istream &input, std::ostream &output)
+{
+    for (std::string line; getline(input, line);) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        output << processServerRequest(toolkit, base, line) << std::endl;
+    }
+}
+
+#ifndef _WIN32
+// Listen on a Unix socket and process the requests of the connections one after the other
+bool runSocketServer(vrv::Toolkit &toolkit, const ServerBaseOptions &base, const std::string &socketPath)
+{
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) return false;
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        close(server);
+        return false;
+    }
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    unlink(socketPath.c_str());
+
+    if ((bind(server, (struct sockaddr *)&address, sizeof(address)) < 0) || (listen(server, 16) < 0)) {
+        close(server);
+        return false;
+    }
+
+    while (true) {
+        int connection = accept(server, NULL, NULL);
+        if (connection < 0) continue;
+
+        std::string buffer;
+        char chunk[65536];
+        ssize_t length;
+        while ((length = read(connection, chunk, sizeof(chunk))) > 0) {
+            buffer.append(chunk, length);
+            std::size_t end;
+            while ((end = buffer.find('\n')) != std::string::npos) {
+                const std::string line = buffer.substr(0, end);
+                buffer.erase(0, end + 1);
+                if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+                const std::string response = processServerRequest(toolkit, base, line) + "\n";
+                for (std::size_t written = 0; written < response.size();) {
+                    ssize_t count = write(connection, response.data() + written, response.size() - written);
+                    if (count <= 0) break;
+                    written += count;
+                }
+            }
+        }
+        close(connection);
+    }
+
+    close(server);
+    return true;
+}
+#endif
+
+//----------------------------------------------------------------------------
+// Batch mode
+//----------------------------------------------------------------------------
+
+// A file of a batch with the path of its outputs without extension
+struct BatchFile {
+    std::string input;
+    std::string output;
+};
+
+// The settings shared by the workers of a batch
+struct BatchSettings {
+    std::string options;
+    std::string inputFrom;
+    std::string resourcePath;
+    int scale;
+    bool allPages;
+    std::vector<std::string> formats;
+};
+
+// Match a filename with a pattern with '*' and '?' wildcards
+bool wildcardMatch(const std::string &pattern, const std::string &name)
+{
+    std::size_t p = 0;
+    std::size_t n = 0;
+    std::size_t star = std::string::npos;
+    std::size_t starMatch = 0;
+    while (n < name.size()) {
+        if ((p < pattern.size()) && ((pattern.at(p) == '?') || (pattern.at(p) == name.at(n)))) {
+            ++p;
+            ++n;
+        }
+        else if ((p < pattern.size()) && (pattern.at(p) == '*')) {
+            star = p++;
+            starMatch = n;
+        }
+        else if (star != std::string::npos) {
+            p = star + 1;
+            n = ++starMatch;
+        }
+        else {
+            return false;
+        }
+    }
+    while ((p < pattern.size()) && (pattern.at(p) == '*')) ++p;
+    return (p == pattern.size());
+}
+
+// Collect the files of a directory (recursively), of a pattern (e.g., "scores/*.mei") or listed in a manifest file
+// (one path per line, relative to the manifest). The outputs are written in the output directory if given, keeping
+// the sub-directories of a directory input, or next to the input files otherwise.
+bool collectBatchFiles(const std::string &input, const std::string &outdir, std::vector<BatchFile> &files)
+{
+    namespace fs = std::filesystem;
+
+    // The extensions of the files of a directory, which can also contain other files
+    static const std::vector<std::string> extensions
+        = { ".mei", ".xml", ".musicxml", ".mxl", ".krn", ".abc", ".pae", ".json" };
+
+    std::vector<fs::path> paths;
+    fs::path root;
+    std::error_code error;
+    if (fs::is_directory(input, error)) {
+        root = input;
+        for (const auto &entry : fs::recursive_directory_iterator(input, error)) {
+            if (!entry.is_regular_file()) continue;
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+            if (std::find(extensions.begin(), extensions.end(), extension) == extensions.end()) continue;
+            paths.push_back(entry.path());
+        }
+    }
+    else if (input.find_first_of("*?") != std::string::npos) {
+        const fs::path pattern(input);
+        const fs::path directory = pattern.has_parent_path() ? pattern.parent_path() : fs::path(".");
+        for (const auto &entry : fs::directory_iterator(directory, error)) {
+            if (!entry.is_regular_file()) continue;
+            if (wildcardMatch(pattern.filename().string(), entry.path().filename().string())) {
+                paths.push_back(entry.path());
+            }
+        }
+    }
+    else {
+        std::ifstream manifest(input);
+        if (!manifest.is_open()) return false;
+        const fs::path directory = fs::path(input).parent_path();
+        for (std::string line; getline(manifest, line);) {
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (line.empty() || (line.at(0) == '#')) continue;
+            const fs::path path(line);
+            paths.push_back(path.is_absolute() ? path : directory / path);
+        }
+    }
+    if (error) return false;
+
+    // The directory order is not reproducible
+    if (!root.empty()) std::sort(paths.begin(), paths.end());
+
+    for (const fs::path &path : paths) {
+        fs::path output = path;
+        if (!outdir.empty()) {
+            output = fs::path(outdir) / (root.empty() ? path.filename() : path.lexically_relative(root));
+        }
+        files.push_back({ path.string(), output.replace_extension().string() });
+    }
+    return true;
+}
+
+// Convert a file to all the formats of the batch and return its status
+jsonxx::Object processBatchFile(vrv::Toolkit &toolkit, const BatchSettings &settings, const BatchFile &file)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    jsonxx::Object status;
+    jsonxx::Array outputs;
+    jsonxx::Object timing;
+    status << "input" << file.input;
+
+    // The log is cleared after each step, so each message is added once
+    std::string log;
+    vrv::logBuffer.Clear();
+    auto appendLog = [&toolkit, &log]() {
+        log += toolkit.GetLog();
+        vrv::logBuffer.Clear();
+    };
+
+    auto stepStart = std::chrono::steady_clock::now();
+    bool success = toolkit.LoadFile(file.input);
+    timing << "load" << elapsedMs(stepStart);
+    appendLog();
+
+    std::error_code error;
+    const std::filesystem::path directory = std::filesystem::path(file.output).parent_path();
+    if (success && !directory.empty()) std::filesystem::create_directories(directory, error);
+
+    if (!success) {
+        status << "error"
+               << "The input could not be loaded";
+    }
+    else if (error) {
+        success = false;
+        status << "error" << vrv::StringFormat("The directory %s could not be created", directory.string().c_str());
+    }
+    else {
+        toolkit.ContinueLayout(settings.allPages ? 0 : 1);
+        const int to = (settings.allPages) ? toolkit.GetPageCount() : std::min(toolkit.GetPageCount(), 1);
+
+        for (const std::string &format : settings.formats) {
+            stepStart = std::chrono::steady_clock::now();
+            std::vector<std::string> filenames;
+            bool written = true;
+            if ((format == "svg") || (format == "png")) {
+                for (int p = 1; p <= to; ++p) {
+                    std::string filename = file.output;
+                    if (settings.allPages) filename += vrv::StringFormat("_%03d", p);
+                    filename += "." + format;
+                    written = (format == "svg") ? toolkit.RenderToSVGFile(filename, p)
+                                                : toolkit.RenderToPNGFile(filename, p);
+                    appendLog();
+                    if (!written) break;
+                    filenames.push_back(filename);
+                }
+            }
+            else if (format == "mei") {
+                filenames.push_back(file.output + ".mei");
+                written = toolkit.SaveFile(filenames.back());
+            }
+            else if (format == "midi") {
+                filenames.push_back(file.output + ".mid");
+                written = toolkit.RenderToMIDIFile(filenames.back());
+            }
+            else if (format == "timemap") {
+                filenames.push_back(file.output + ".json");
+                written = toolkit.RenderToTimemapFile(filenames.back());
+            }
+            else if (format == "expansionmap") {
+                filenames.push_back(file.output + "-em.json");
+                written = toolkit.RenderToExpansionMapFile(filenames.back());
+            }
+            else if (format == "pae") {
+                filenames.push_back(file.output + ".pae");
+                written = toolkit.RenderToPAEFile(filenames.back());
+            }
+            timing << format << elapsedMs(stepStart);
+            appendLog();
+            if (!written) {
+                success = false;
+                status << "error" << vrv::StringFormat("Unable to write the %s output", format.c_str());
+                break;
+            }
+            for (const std::string &filename : filenames) outputs << filename;
+        }
+    }
+
+    timing << "total" << elapsedMs(start);
+
+    status << "success" << success;
+    status << "outputs" << outputs;
+    status << "timing" << timing;
+    if (!log.empty()) status << "log" << log;
+
+    return status;
+}
+
+// Convert the files with the given number of workers, each with its own toolkit, and return the summary
+jsonxx::Object runBatch(const BatchSettings &settings, const std::vector<BatchFile> &files, int jobs)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<jsonxx::Object> statuses(files.size());
+    std::atomic<std::size_t> next = 0;
+    std::atomic<int> failed = 0;
+    auto work = [&]() {
+        vrv::Toolkit toolkit(false);
+        toolkit.SetResourcePath(settings.resourcePath);
+        toolkit.SetOptions(settings.options);
+        toolkit.SetScale(settings.scale);
+        if (settings.inputFrom != "auto") toolkit.SetInputFrom(settings.inputFrom);
+        for (std::size_t i = next++; i < files.size(); i = next++) {
+            statuses.at(i) = processBatchFile(toolkit, settings, files.at(i));
+            if (!statuses.at(i).get<jsonxx::Boolean>("success")) ++failed;
+            std::cerr << vrv::StringFormat("[%d/%d] %s\n", (int)i + 1, (int)files.size(), files.at(i).input.c_str());
+        }
+    };
+
+    jobs = std::max(1, std::min(jobs, (int)files.size()));
+    std::vector<std::thread> workers;
+    for (int i = 1; i < jobs; ++i) workers.emplace_back(work);
+    work();
+    for (std::thread &worker : workers) worker.join();
+
+    jsonxx::Array results;
+    for (const jsonxx::Object &status : statuses) results << status;
+
+    jsonxx::Object summary;
+    summary << "files" << results;
+    summary << "succeeded" << (int)files.size() - failed;
+    summary << "failed" << failed.load();
+    summary << "jobs" << jobs;
+    summary << "time" << elapsedMs(start);
+    return summary;
+}
+
 int main(int argc, char **argv)
 {
     std::string infile;
     std::string svgdir;
     std::string outfile;
     std::string outformat = "svg";
+    std::string informat = "auto";
+    std::string server_socket;
+    std::string batch;
     bool std_output = false;
+    bool server = false;
+    bool profile = false;
 
     int all_pages = 0;
     int page = 1;
     int show_version = 0;
+    int jobs = std::max(1, (int)std::thread::hardware_concurrency());
 
     // Create the toolkit instance without loading the font because
     // the resource path might be specified in the parameters
@@ -125,6 +614,14 @@ int main(int argc, char **argv)
         optionStruct(&options->m_xmlIdSeed, optionNames), //
         // standard input - long options only or - as filename
         { "stdin", no_argument, 0, 'z' }, //
+        // server mode - long options only
+        { "server", no_argument, 0, 'S' }, //
+        { "server-socket", required_argument, 0, 'U' }, //
+        // profile output - long options only
+        { "profile", no_argument, 0, 'P' }, //
+        // batch mode - long options only
+        { "batch", required_argument, 0, 'B' }, //
+        { "jobs", required_argument, 0, 'J' }, //
         { 0, 0, 0, 0 }
     };
 
@@ -208,6 +705,7 @@ int main(int argc, char **argv)
                 if (!toolkit.SetInputFrom(std::string(optarg))) {
                     exit(1);
                 };
+                informat = std::string(optarg);
                 break;
 
             case 'l': vrv::EnableLog(vrv::StrToLogLevel(std::string(optarg))); break;
@@ -220,7 +718,8 @@ int main(int argc, char **argv)
 
             case 't':
                 outformat = std::string(optarg);
-                toolkit.SetOutputTo(std::string(optarg));
+                // A list of formats is only possible in batch mode
+                if (outformat.find(',') == std::string::npos) toolkit.SetOutputTo(outformat);
                 break;
 
             case 's':
@@ -244,6 +743,19 @@ int main(int argc, char **argv)
                 }
                 break;
 
+            case 'S': server = true; break;
+
+            case 'U':
+                server = true;
+                server_socket = std::string(optarg);
+                break;
+
+            case 'P': profile = true; break;
+
+            case 'B': batch = std::string(optarg); break;
+
+            case 'J': jobs = std::max(1, atoi(optarg)); break;
+
             case 'h':
                 toolkit.PrintOptionUsage(optarg, std::cout);
                 exit(0);
@@ -259,8 +771,6 @@ int main(int argc, char **argv)
     }
     options->Sync();
 
-    toolkit.SetLocale();
-
     if (show_version) {
         display_version();
         exit(0);
@@ -275,7 +785,7 @@ int main(int argc, char **argv)
     if (optind <= argc - 1) {
         infile = std::string(argv[optind]);
     }
-    else if (infile != "-") {
+    else if ((infile != "-") && !server && batch.empty()) {
         std::cerr << "Incorrect number of arguments: expected one input file but found none." << std::endl << std::endl;
         toolkit.PrintOptionUsage("base", std::cout);
         exit(1);
@@ -295,12 +805,79 @@ int main(int argc, char **argv)
         exit(1);
     }
 
+    // Process requests with the warm toolkit until the end of the input
+    if (server) {
+        ServerBaseOptions base;
+        base.options.parse(toolkit.GetOptions());
+        base.inputFrom = informat;
+        base.scale = toolkit.GetScale();
+        // Log messages are returned with the responses
+        vrv::EnableLogToBuffer(true);
+        if (server_socket.empty()) {
+            runServer(toolkit, base, std::cin, std::cout);
+        }
+        else {
+#ifndef _WIN32
+            if (!runSocketServer(toolkit, base, server_socket)) {
+                std::cerr << "Unable to listen on the socket " << server_socket << "." << std::endl;
+                exit(1);
+            }
+#else
+            std::cerr << "Unix sockets are not supported on this platform." << std::endl;
+            exit(1);
+#endif
+        }
+        free(long_options);
+        return 0;
+    }
+
+    // Convert the files of the batch with a pool of workers
+    if (!batch.empty()) {
+        BatchSettings settings;
+        const std::vector<std::string> batchFormats = { "mei", "svg", "midi", "timemap", "expansionmap", "pae", "png" };
+        std::stringstream formats(outformat);
+        for (std::string format; getline(formats, format, ',');) {
+            if (std::find(batchFormats.begin(), batchFormats.end(), format) == batchFormats.end()) {
+                std::cerr << "Output format (" << format
+                          << ") can only be 'mei', 'svg', 'midi', 'timemap', 'expansionmap', 'pae', or 'png' in batch "
+                             "mode."
+                          << std::endl;
+                exit(1);
+            }
+            settings.formats.push_back(format);
+        }
+        // Skip the layout if only MIDI or maps are requested
+        if (std::all_of(settings.formats.begin(), settings.formats.end(), [](const std::string &format) {
+                return (format == "midi") || (format == "timemap") || (format == "expansionmap");
+            })) {
+            toolkit.SetOptions("{'breaks': 'none'}");
+        }
+        settings.options = toolkit.GetOptions();
+        settings.inputFrom = informat;
+        settings.resourcePath = resourcePath;
+        settings.scale = toolkit.GetScale();
+        settings.allPages = all_pages;
+
+        std::vector<BatchFile> files;
+        if (!collectBatchFiles(batch, outfile, files) || files.empty()) {
+            std::cerr << "No input file could be found for the batch " << batch << "." << std::endl;
+            exit(1);
+        }
+
+        // Log messages are returned in the summary
+        vrv::EnableLogToBuffer(true);
+        const jsonxx::Object summary = runBatch(settings, files, jobs);
+        std::cout << summary.json() << std::endl;
+        free(long_options);
+        return (summary.get<jsonxx::Number>("failed") > 0) ? 1 : 0;
+    }
+
     const std::vector<std::string> outformats = { "mei", "mei-basic", "mei-pb", "mei-facs", "svg", "midi", "timemap",
-        "expansionmap", "humdrum", "hum", "pae" };
+        "expansionmap", "humdrum", "hum", "pae", "png" };
     if (std::find(outformats.begin(), outformats.end(), outformat) == outformats.end()) {
         std::cerr << "Output format (" << outformat
                   << ") can only be 'mei', 'mei-basic', 'mei-pb', mei-facs', 'svg', 'midi', 'timemap', 'expansionmap', "
-                     "'humdrum', 'hum', or 'pae'."
+                     "'humdrum', 'hum', 'pae', or 'png'."
                   << std::endl;
         exit(1);
     }
@@ -349,6 +926,8 @@ int main(int argc, char **argv)
     }
 
     if (toolkit.GetOutputTo() != vrv::HUMDRUM) {
+        // With a progressive layout, only lay out the pages needed
+        toolkit.ContinueLayout(all_pages ? 0 : page);
         // Check the page range
         if (page > toolkit.GetPageCount()) {
             std::cerr << "The page requested (" << page << ") is not in the page range (max is "
@@ -388,6 +967,28 @@ int main(int argc, char **argv)
         }
     }
 
+    else if (outformat == "png") {
+        int p;
+        for (p = from; p < to; ++p) {
+            std::string cur_outfile = outfile;
+            if (all_pages) {
+                cur_outfile += vrv::StringFormat("_%03d", p);
+            }
+            cur_outfile += ".png";
+            if (std_output) {
+                const std::vector<uint8_t> png = toolkit.RenderToPNG(p);
+                std::cout.write((const char *)png.data(), png.size());
+            }
+            else if (!toolkit.RenderToPNGFile(cur_outfile, p)) {
+                std::cerr << "Unable to write PNG to " << cur_outfile << "." << std::endl;
+                exit(1);
+            }
+            else {
+                std::cerr << "Output written to " << cur_outfile << "." << std::endl;
+            }
+        }
+    }
+
     else if (outformat == "hummidi") {
         std::string humdata;
         if (infile == "-") {
@@ -609,6 +1210,11 @@ int main(int argc, char **argv)
         toolkit.LogRuntime();
     }
 
+    // Display the profile if desired
+    if (profile) {
+        std::cerr << toolkit.GetProfile() << std::endl;
+    }
+
     free(long_options);
     return 0;
 }